@@ -0,0 +1,99 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef BENCHMARKCOMMON_H
+#define BENCHMARKCOMMON_H
+
+#pragma once
+
+#include "World/World.h"
+#include "World/TerrainGenerator.h"
+#include "World/BlockType.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+namespace MinecraftClone
+{
+    // Helpers shared by the headless benchmarks: command-line options, terrain setup and probes
+    namespace Benchmark
+    {
+        // One integer option, "--name VALUE", clamped to at least minimum
+        struct IntOption
+        {
+            const char* name;       // e.g. "--seed"
+            const char* valueName;  // Placeholder in the usage line, e.g. "S"
+            int* value;
+            int minimum = INT_MIN;
+        };
+
+        // Fills the options from argv; logs the usage line and returns false on anything else
+        inline bool ParseArguments(int argc, char** argv, std::initializer_list<IntOption> options)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                const IntOption* match = nullptr;
+                for (const IntOption& option : options)
+                {
+                    if (std::strcmp(argv[i], option.name) == 0 && i + 1 < argc)
+                    {
+                        match = &option;
+                        break;
+                    }
+                }
+
+                if (!match)
+                {
+                    std::string usage;
+                    for (const IntOption& option : options)
+                    {
+                        usage += std::string(" [") + option.name + " " + option.valueName + "]";
+                    }
+                    spdlog::error("Usage: {}{}", argv[0], usage);
+                    return false;
+                }
+                *match->value = std::max(match->minimum, std::atoi(argv[++i]));
+            }
+            return true;
+        }
+
+        // Block registry and a generator for the seed
+        inline void InitializeTerrain(TerrainGenerator& generator, int seed)
+        {
+            BlockRegistry::Initialize();
+            generator.Initialize(seed);
+        }
+
+        // Generates every chunk from minChunk to maxChunk (inclusive) on both axes
+        inline void GenerateTerrainSquare(World& world, TerrainGenerator& generator, int minChunk, int maxChunk)
+        {
+            for (int chunkZ = minChunk; chunkZ <= maxChunk; chunkZ++)
+            {
+                for (int chunkX = minChunk; chunkX <= maxChunk; chunkX++)
+                {
+                    generator.GenerateChunk(world.GetOrCreateChunk(chunkX, chunkZ), chunkX, chunkZ, &world);
+                }
+            }
+        }
+
+        // Highest non-air block of a column, 0 if there is none above bedrock level
+        inline int FindSurface(const World& world, int worldX, int worldZ)
+        {
+            for (int y = CHUNK_SIZE_Y - 1; y > 0; y--)
+            {
+                if (!world.GetBlock(worldX, y, worldZ).IsAir())
+                {
+                    return y;
+                }
+            }
+            return 0;
+        }
+    }
+}
+
+#endif
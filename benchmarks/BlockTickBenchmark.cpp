@@ -0,0 +1,239 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless block-tick benchmark.
+// Measures BlockTickScheduler tick time (a) against the number of loaded chunks with a fixed number
+// of active blocks, which should stay flat because nothing is scanned, and (b) against the number of
+// active blocks (falling sand, spreading water) on a fixed world. The world produced with one thread
+// must match the world produced with the maximum thread count.
+
+#include "BenchmarkCommon.h"
+#include "World/BlockTickScheduler.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int maxThreads = 0;   // 0 = std::thread::hardware_concurrency()
+        int ticks = 40;       // Measured ticks per scenario
+    };
+
+    struct TickResult
+    {
+        double averageMs = 0.0;
+        double maxMs = 0.0;
+        size_t activeBlocks = 0;   // Scheduled blocks before the first measured tick
+        size_t processed = 0;      // Block updates executed over all measured ticks
+        uint64_t worldHash = 0;
+    };
+
+    enum class Workload
+    {
+        FallingSand,
+        WaterSources
+    };
+
+    // Place `count` active blocks inside the central activeChunks x activeChunks area
+    void PlaceWorkload(World& world, BlockTickScheduler& scheduler, Workload workload, int count, int activeChunks)
+    {
+        std::mt19937 rng(4242);
+        const int halfExtent = activeChunks * CHUNK_SIZE_X / 2;
+        std::uniform_int_distribution<int> coordDist(-halfExtent, halfExtent - 1);
+
+        int placed = 0;
+        int attempts = 0;
+        while (placed < count && attempts < count * 20)
+        {
+            attempts++;
+            int worldX = coordDist(rng);
+            int worldZ = coordDist(rng);
+
+            int worldY = 0;
+            BlockType type = BlockType::Sand;
+            if (workload == Workload::FallingSand)
+            {
+                // Floating sand high above the terrain keeps falling for the whole measurement
+                worldY = 205 + static_cast<int>(rng() % 45);
+            }
+            else
+            {
+                worldY = Benchmark::FindSurface(world, worldX, worldZ) + 1;
+                type = BlockType::Water;
+            }
+
+            if (worldY >= CHUNK_SIZE_Y || !world.GetBlock(worldX, worldY, worldZ).IsAir())
+            {
+                continue;
+            }
+
+            world.SetBlock(worldX, worldY, worldZ, type);
+            scheduler.NotifyBlockChanged(worldX, worldY, worldZ);
+            placed++;
+        }
+    }
+
+    uint64_t HashWorld(World& world, int gridSize)
+    {
+        // FNV-1a over every block type
+        uint64_t hash = 14695981039346656037ull;
+        const int offset = gridSize / 2;
+        for (int chunkZ = -offset; chunkZ < gridSize - offset; chunkZ++)
+        {
+            for (int chunkX = -offset; chunkX < gridSize - offset; chunkX++)
+            {
+                const Block* blocks = world.GetChunk(chunkX, chunkZ)->GetBlockData();
+                for (int i = 0; i < CHUNK_VOLUME; i++)
+                {
+                    hash ^= static_cast<uint8_t>(blocks[i].GetType());
+                    hash *= 1099511628211ull;
+                }
+            }
+        }
+        return hash;
+    }
+
+    TickResult RunScenario(TerrainGenerator& generator, const BenchmarkOptions& options, int gridSize,
+                           Workload workload, int activeCount, int threadCount, bool hashWorld)
+    {
+        // Keep scheduler / generator setup logs out of the report
+        spdlog::set_level(spdlog::level::warn);
+
+        World world;
+        Benchmark::GenerateTerrainSquare(world, generator, -gridSize / 2, gridSize - gridSize / 2 - 1);
+
+        BlockTickScheduler scheduler;
+        scheduler.Initialize(&world, threadCount);
+        PlaceWorkload(world, scheduler, workload, activeCount, std::min(gridSize, 8));
+
+        TickResult result;
+        result.activeBlocks = scheduler.GetActiveBlockCount();
+
+        // Scheduled ticks start WATER_DELAY / FALL_DELAY ticks out, so warm up before measuring
+        for (int i = 0; i < BlockTickScheduler::WATER_DELAY; i++)
+        {
+            scheduler.Tick();
+        }
+
+        double totalMs = 0.0;
+        for (int i = 0; i < options.ticks; i++)
+        {
+            scheduler.Tick();
+            const BlockTickStats& stats = scheduler.GetStats();
+            totalMs += stats.lastTickMs;
+            result.maxMs = std::max(result.maxMs, stats.lastTickMs);
+            result.processed += stats.processedLastTick;
+        }
+        result.averageMs = totalMs / static_cast<double>(options.ticks);
+
+        scheduler.Shutdown();
+
+        if (hashWorld)
+        {
+            result.worldHash = HashWorld(world, gridSize);
+        }
+
+        spdlog::set_level(spdlog::level::info);
+        return result;
+    }
+
+    void ReportScenario(const char* label, int loadedChunks, int threadCount, int ticks, const TickResult& result)
+    {
+        spdlog::info("{:<6} chunks={:<5} active={:<7} threads={:<3} avg={:>8.3f} ms  max={:>8.3f} ms  updates/tick={:>9.1f}",
+                     label, loadedChunks, result.activeBlocks, threadCount, result.averageMs, result.maxMs,
+                     static_cast<double>(result.processed) / static_cast<double>(ticks));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--seed", "S", &options.seed },
+            { "--threads", "T", &options.maxThreads, 1 },
+            { "--ticks", "N", &options.ticks, 1 }
+        }))
+    {
+        return 2;
+    }
+
+    int maxThreads = options.maxThreads;
+    if (maxThreads <= 0)
+    {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    TerrainGenerator generator;
+    Benchmark::InitializeTerrain(generator, options.seed);
+
+    spdlog::info("Block tick benchmark: seed {}, {} measured ticks, up to {} threads", options.seed, options.ticks, maxThreads);
+
+    std::vector<int> threadCounts = {1};
+    if (maxThreads > 1)
+    {
+        threadCounts.push_back(maxThreads);
+    }
+
+    auto report = [&options](const char* label, int chunks, int threads, const TickResult& result) {
+        ReportScenario(label, chunks, threads, options.ticks, result);
+    };
+
+    // (a) Tick time against loaded chunks, fixed active set
+    spdlog::info("-- tick time vs loaded chunks (2000 falling blocks) --");
+    for (int gridSize : {8, 16, 24})
+    {
+        for (int threads : threadCounts)
+        {
+            TickResult result = RunScenario(generator, options, gridSize, Workload::FallingSand, 2000, threads, false);
+            report("sand", gridSize * gridSize, threads, result);
+        }
+    }
+
+    // (b) Tick time against active blocks, fixed world
+    spdlog::info("-- tick time vs active blocks (256 chunks) --");
+    for (int activeCount : {1000, 4000, 16000, 64000})
+    {
+        for (int threads : threadCounts)
+        {
+            TickResult result = RunScenario(generator, options, 16, Workload::FallingSand, activeCount, threads, false);
+            report("sand", 256, threads, result);
+        }
+    }
+    for (int activeCount : {100, 1000, 4000})
+    {
+        for (int threads : threadCounts)
+        {
+            TickResult result = RunScenario(generator, options, 16, Workload::WaterSources, activeCount, threads, false);
+            report("water", 256, threads, result);
+        }
+    }
+
+    // Determinism: one thread against many
+    int checkThreads = std::max(2, maxThreads);
+    TickResult single = RunScenario(generator, options, 16, Workload::WaterSources, 2000, 1, true);
+    TickResult multi = RunScenario(generator, options, 16, Workload::WaterSources, 2000, checkThreads, true);
+    if (single.worldHash != multi.worldHash)
+    {
+        spdlog::error("Determinism failure: world hash {:016x} with 1 thread != {:016x} with {} threads",
+                      single.worldHash, multi.worldHash, checkThreads);
+        return 1;
+    }
+
+    spdlog::info("World after ticking matches between 1 and {} threads", checkThreads);
+    return 0;
+}
@@ -0,0 +1,398 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless cave culling benchmark.
+// First checks SectionVisibility and SectionVisibilityGraph on hand-built sections (solid, open,
+// tunnels, walls, sealed pockets) and fails the run if any result is wrong. Then generates terrain,
+// carves a tunnel with a room under the centre chunk, meshes the sections as the renderer does and
+// counts the section draws and faces that pass the frustum, with and without the connectivity walk,
+// for a camera above the surface and one in the room, each turning on the spot.
+
+#include "BenchmarkCommon.h"
+#include "World/ChunkMeshGenerator.h"
+#include "World/SectionVisibility.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include "Rendering/BlockTextureRegistry.h"
+#include "Rendering/Frustum.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int renderDistance = 8;  // Chunks in every direction from the centre chunk
+        int views = 8;           // Camera headings per scene
+    };
+
+    // Faces in SectionVisibility order
+    constexpr int POS_Z = 0;
+    constexpr int NEG_Z = 1;
+    constexpr int NEG_X = 2;
+    constexpr int POS_X = 3;
+    constexpr int POS_Y = 4;
+    constexpr int NEG_Y = 5;
+
+    constexpr float ASPECT = 16.0f / 9.0f;
+
+    // Fill the centre chunk's section 0 with stone, then carve air boxes [min, max] into it
+    struct SectionBuilder
+    {
+        ChunkMeshInput input;
+
+        SectionBuilder()
+        {
+            input.Clear();
+            Fill(glm::ivec3(0), glm::ivec3(15), BlockType::Stone);
+        }
+
+        void Fill(const glm::ivec3& min, const glm::ivec3& max, BlockType type)
+        {
+            for (int y = min.y; y <= max.y; y++)
+            {
+                for (int z = min.z; z <= max.z; z++)
+                {
+                    for (int x = min.x; x <= max.x; x++)
+                    {
+                        input.Set(x, y, z, type);
+                    }
+                }
+            }
+        }
+
+        SectionVisibility Compute() const { return SectionVisibility::Compute(input, 0); }
+    };
+
+    // Every face pair of visibility must be connected exactly when both faces are in one of the groups
+    bool ExpectConnections(const char* label, const SectionVisibility& visibility, std::initializer_list<uint8_t> groups)
+    {
+        for (int from = 0; from < SectionVisibility::FACE_COUNT; from++)
+        {
+            for (int to = 0; to < SectionVisibility::FACE_COUNT; to++)
+            {
+                bool expected = false;
+                for (uint8_t group : groups)
+                {
+                    expected = expected || ((group >> from & 1u) != 0 && (group >> to & 1u) != 0);
+                }
+                if (visibility.IsConnected(from, to) != expected)
+                {
+                    spdlog::error("{}: faces {} and {} should {}be connected", label, from, to, expected ? "" : "not ");
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool CheckSectionVisibility()
+    {
+        const uint8_t all = 0x3F;
+        bool passed = true;
+
+        ChunkMeshInput empty;
+        empty.Clear();
+        passed = ExpectConnections("empty", SectionVisibility::Compute(empty, 0), { all }) && passed;
+
+        SectionBuilder solid;
+        passed = ExpectConnections("solid", solid.Compute(), {}) && passed;
+
+        // Glass does not block sight
+        SectionBuilder glass;
+        glass.Fill(glm::ivec3(0), glm::ivec3(15), BlockType::Glass);
+        passed = ExpectConnections("glass", glass.Compute(), { all }) && passed;
+
+        // A pocket touching no face connects nothing
+        SectionBuilder pocket;
+        pocket.Fill(glm::ivec3(4), glm::ivec3(11), BlockType::Air);
+        passed = ExpectConnections("sealed pocket", pocket.Compute(), {}) && passed;
+
+        // A straight tunnel along X
+        SectionBuilder tunnel;
+        tunnel.Fill(glm::ivec3(0, 7, 7), glm::ivec3(15, 8, 8), BlockType::Air);
+        passed = ExpectConnections("x tunnel", tunnel.Compute(), { (1u << NEG_X) | (1u << POS_X) }) && passed;
+
+        // A bend from -X up to +Y, and a separate shaft from -Z to -Y
+        SectionBuilder bend;
+        bend.Fill(glm::ivec3(0, 4, 4), glm::ivec3(6, 4, 4), BlockType::Air);
+        bend.Fill(glm::ivec3(6, 4, 4), glm::ivec3(6, 15, 4), BlockType::Air);
+        bend.Fill(glm::ivec3(12, 0, 0), glm::ivec3(12, 2, 12), BlockType::Air);
+        passed = ExpectConnections("bend", bend.Compute(),
+                                   { (1u << NEG_X) | (1u << POS_Y), (1u << NEG_Z) | (1u << NEG_Y) }) && passed;
+
+        // Air with a stone wall across x = 8: each half reaches every face but the far X face
+        SectionBuilder wall;
+        wall.Fill(glm::ivec3(0), glm::ivec3(15), BlockType::Air);
+        wall.Fill(glm::ivec3(8, 0, 0), glm::ivec3(8, 15, 15), BlockType::Stone);
+        passed = ExpectConnections("wall", wall.Compute(),
+                                   { all & ~(1u << POS_X), all & ~(1u << NEG_X) }) && passed;
+        return passed;
+    }
+
+    bool CheckGraph()
+    {
+        bool passed = true;
+        const auto accept = [](int, int, int) { return true; };
+        const glm::vec3 camera(8.0f, 8.0f * CHUNK_SECTION_SIZE + 8.0f, 8.0f);  // Section 8 of chunk (0, 0)
+
+        // Everything open: every section within the radius is reached
+        const SectionVisibility open;
+        SectionVisibilityGraph graph;
+        graph.Traverse(camera, 1, [&](int, int, int) { return &open; }, accept);
+        const size_t allSections = 3 * 3 * CHUNK_SECTION_COUNT;
+        if (graph.GetReachableCount() != allSections)
+        {
+            spdlog::error("open world: {} of {} sections reached", graph.GetReachableCount(), allSections);
+            passed = false;
+        }
+
+        // Everything solid: the camera's section and the six it touches (their near faces are in sight)
+        const SectionVisibility closed = SectionVisibility::Closed();
+        graph.Traverse(camera, 2, [&](int, int, int) { return &closed; }, accept);
+        if (graph.GetReachableCount() != 7 || !graph.IsReachable(1, 8, 0) || graph.IsReachable(2, 8, 0))
+        {
+            spdlog::error("solid world: {} sections reached, expected the camera's and its 6 neighbours", graph.GetReachableCount());
+            passed = false;
+        }
+
+        // Open sections along +X only, solid elsewhere: the walk follows the row and never turns back
+        graph.Traverse(camera, 3, [&](int chunkX, int section, int chunkZ) {
+            return (chunkZ == 0 && section == 8 && chunkX >= 0) ? &open : &closed;
+        }, accept);
+        if (!graph.IsReachable(3, 8, 0) || graph.IsReachable(-2, 8, 0) || graph.IsReachable(2, 8, 2))
+        {
+            spdlog::error("corridor: walk did not follow the open row");
+            passed = false;
+        }
+
+        // The filter stops the walk: only the camera's section and the half-space x >= 0 are accepted
+        graph.Traverse(camera, 2, [&](int, int, int) { return &open; }, [](int chunkX, int, int) { return chunkX >= 0; });
+        if (graph.IsReachable(-1, 8, 0) || !graph.IsReachable(2, 0, -2))
+        {
+            spdlog::error("filter: walk entered a rejected section or missed an accepted one");
+            passed = false;
+        }
+
+        // A camera above the world can see every section: the walk declines
+        if (graph.Traverse(glm::vec3(0.0f, CHUNK_SIZE_Y + 10.0f, 0.0f), 1, [&](int, int, int) { return &open; }, accept))
+        {
+            spdlog::error("camera above the world: walk should decline");
+            passed = false;
+        }
+        return passed;
+    }
+
+    struct DrawCounts
+    {
+        size_t sections = 0;
+        size_t faces = 0;
+    };
+
+    struct SceneResult
+    {
+        DrawCounts frustum;
+        DrawCounts caveCulled;
+        double walkUs = 0.0;
+        size_t reached = 0;
+    };
+
+    using SectionMap = std::map<std::pair<int, int>, ChunkSectionMeshes>;
+
+    // Average draws over views headings turning on the spot at eye, as ChunkRenderer selects them
+    SceneResult MeasureScene(const SectionMap& meshes, int radius, const glm::vec3& eye, float pitch, int views)
+    {
+        const glm::mat4 projection = glm::perspective(glm::radians(70.0f), ASPECT, 0.1f, 1000.0f);
+        SectionVisibilityGraph graph;
+        Frustum frustum;
+        SceneResult result;
+
+        const auto lookup = [&meshes](int chunkX, int section, int chunkZ) -> const SectionVisibility* {
+            auto it = meshes.find(std::make_pair(chunkX, chunkZ));
+            return it != meshes.end() ? &it->second.visibility[section] : nullptr;
+        };
+        const auto sectionInFrustum = [&frustum](int chunkX, int section, int chunkZ) {
+            const glm::vec3 sectionMin(static_cast<float>(chunkX * CHUNK_SIZE_X), static_cast<float>(section * CHUNK_SECTION_SIZE),
+                                       static_cast<float>(chunkZ * CHUNK_SIZE_Z));
+            return frustum.IsAABBVisible(sectionMin, sectionMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z));
+        };
+
+        for (int view = 0; view < views; view++)
+        {
+            const float yaw = glm::two_pi<float>() * static_cast<float>(view) / static_cast<float>(views);
+            const glm::vec3 forward(std::cos(yaw) * std::cos(pitch), std::sin(pitch), std::sin(yaw) * std::cos(pitch));
+            frustum.ExtractPlanes(projection * glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+            auto start = std::chrono::steady_clock::now();
+            graph.Traverse(eye, radius, lookup, sectionInFrustum);
+            auto end = std::chrono::steady_clock::now();
+            result.walkUs += std::chrono::duration<double, std::micro>(end - start).count();
+            result.reached += graph.GetReachableCount();
+
+            for (const auto& [coord, chunkMeshes] : meshes)
+            {
+                for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+                {
+                    const ChunkMesh* mesh = chunkMeshes.sections[section].get();
+                    if (!mesh || mesh->IsEmpty() || !sectionInFrustum(coord.first, section, coord.second))
+                    {
+                        continue;
+                    }
+                    const size_t faces = mesh->GetFaceCount();
+                    result.frustum.sections++;
+                    result.frustum.faces += faces;
+                    if (graph.IsReachable(coord.first, section, coord.second))
+                    {
+                        result.caveCulled.sections++;
+                        result.caveCulled.faces += faces;
+                    }
+                }
+            }
+        }
+
+        result.frustum.sections /= views;
+        result.frustum.faces /= views;
+        result.caveCulled.sections /= views;
+        result.caveCulled.faces /= views;
+        result.walkUs /= views;
+        result.reached /= views;
+        return result;
+    }
+
+    double Reduction(size_t before, size_t after)
+    {
+        return before == 0 ? 0.0 : 100.0 * (1.0 - static_cast<double>(after) / static_cast<double>(before));
+    }
+
+    void ReportScene(const char* label, const SceneResult& result)
+    {
+        spdlog::info("  {:<8} frustum only: {:>5} sections {:>8} faces   cave culled: {:>5} sections {:>8} faces"
+                     "   (-{:.1f}% draws, -{:.1f}% faces; walk {:.0f} us, {} sections reached)",
+                     label, result.frustum.sections, result.frustum.faces, result.caveCulled.sections, result.caveCulled.faces,
+                     Reduction(result.frustum.sections, result.caveCulled.sections),
+                     Reduction(result.frustum.faces, result.caveCulled.faces), result.walkUs, result.reached);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--seed", "S", &options.seed },
+            { "--distance", "R", &options.renderDistance, 1 },
+            { "--views", "N", &options.views, 1 }
+        }))
+    {
+        return 2;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    TerrainGenerator generator;
+    Benchmark::InitializeTerrain(generator, options.seed);
+    BlockTextureRegistry::Initialize();
+    spdlog::set_level(spdlog::level::info);
+
+    if (!CheckSectionVisibility() || !CheckGraph())
+    {
+        return 1;
+    }
+    spdlog::info("Section visibility and walk checks passed");
+
+    // One extra ring so every meshed chunk has its neighbours
+    const int distance = options.renderDistance;
+    World world;
+    Benchmark::GenerateTerrainSquare(world, generator, -distance - 1, distance + 1);
+
+    // A 3x3 tunnel along x through five chunks, opening into a 9x5x9 room around the centre column,
+    // well below the lowest surface it passes under
+    int lowestSurface = CHUNK_SIZE_Y;
+    for (int x = -2 * CHUNK_SIZE_X; x < 3 * CHUNK_SIZE_X; x++)
+    {
+        lowestSurface = std::min(lowestSurface, Benchmark::FindSurface(world, x, 8));
+    }
+    const int floorY = std::max(4, lowestSurface - 24);
+    for (int x = -2 * CHUNK_SIZE_X; x < 3 * CHUNK_SIZE_X; x++)
+    {
+        for (int y = floorY; y < floorY + 3; y++)
+        {
+            for (int z = 7; z <= 9; z++)
+            {
+                world.SetBlock(x, y, z, BlockType::Air);
+            }
+        }
+    }
+    for (int x = 4; x <= 12; x++)
+    {
+        for (int y = floorY; y < floorY + 5; y++)
+        {
+            for (int z = 4; z <= 12; z++)
+            {
+                world.SetBlock(x, y, z, BlockType::Air);
+            }
+        }
+    }
+
+    SectionMap meshes;
+    size_t openSections = 0;
+    size_t closedSections = 0;
+    auto meshStart = std::chrono::steady_clock::now();
+    for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+    {
+        for (int chunkX = -distance; chunkX <= distance; chunkX++)
+        {
+            ChunkSectionMeshes& chunkMeshes = meshes[std::make_pair(chunkX, chunkZ)];
+            chunkMeshes = ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ, &world,
+                                                                    ChunkMeshGenerator::ALL_SECTIONS, MeshingMode::Greedy);
+            for (const SectionVisibility& visibility : chunkMeshes.visibility)
+            {
+                openSections += visibility.IsOpen() ? 1 : 0;
+                closedSections += visibility.IsClosed() ? 1 : 0;
+            }
+        }
+    }
+    auto meshEnd = std::chrono::steady_clock::now();
+
+    // The flood fill alone, over every section of every chunk
+    ChunkMeshInput input;
+    double fillUs = 0.0;
+    for (const auto& [coord, chunkMeshes] : meshes)
+    {
+        input.Assemble(&world, coord.first, coord.second);
+        auto start = std::chrono::steady_clock::now();
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+        {
+            if (SectionVisibility::Compute(input, section) != chunkMeshes.visibility[section])
+            {
+                spdlog::error("Chunk ({}, {}) section {}: visibility differs from the mesher's", coord.first, coord.second, section);
+                return 1;
+            }
+        }
+        fillUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const size_t sectionCount = meshes.size() * CHUNK_SECTION_COUNT;
+    spdlog::info("Cave culling benchmark: render distance {} ({} chunks, meshed in {:.0f} ms), {} views per scene",
+                 distance, meshes.size(), std::chrono::duration<double, std::milli>(meshEnd - meshStart).count(), options.views);
+    spdlog::info("  visibility: {:.2f} us per section ({:.1f}% open, {:.1f}% closed, the rest flood filled)",
+                 fillUs / static_cast<double>(sectionCount), 100.0 * static_cast<double>(openSections) / static_cast<double>(sectionCount),
+                 100.0 * static_cast<double>(closedSections) / static_cast<double>(sectionCount));
+
+    const glm::vec3 surfaceEye(8.5f, static_cast<float>(Benchmark::FindSurface(world, 8, 8)) + 24.0f, 8.5f);
+    ReportScene("surface", MeasureScene(meshes, distance, surfaceEye, -0.3f, options.views));
+    const glm::vec3 caveEye(8.5f, static_cast<float>(floorY) + 1.6f, 8.5f);
+    ReportScene("cave", MeasureScene(meshes, distance, caveEye, 0.0f, options.views));
+    return 0;
+}
@@ -0,0 +1,320 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless chunk grid benchmark.
+// First moves a ChunkGrid around (steps, jumps, radius changes) next to a std::map holding what it
+// should contain, and fails the run if the contents, the evicted chunks or the nearest-first order
+// ever differ. Then, at render distance 32, times the per-frame work of the renderer (walking every
+// chunk's record, looking up a chunk and its four neighbours for each one) and the manager's update
+// as the player crosses a chunk, against the hash map and std::set they used before.
+
+#include "BenchmarkCommon.h"
+#include "World/ChunkGrid.h"
+#include "World/SectionVisibility.h"
+#include "World/World.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int renderDistance = 32;
+        int frames = 200;
+    };
+
+    // About the size and layout of ChunkRenderer's record for one chunk
+    struct RenderRecord
+    {
+        std::array<void*, CHUNK_SECTION_COUNT> sections{};
+        std::array<void*, 2> lods{};
+        bool hasLods = false;
+        std::array<SectionVisibility, CHUNK_SECTION_COUNT> visibility{};
+    };
+
+    using Coord = std::pair<int, int>;
+
+    int Chebyshev(int x1, int z1, int x2, int z2)
+    {
+        return std::max(std::abs(x1 - x2), std::abs(z1 - z2));
+    }
+
+    // The grid against a std::map of what it should hold
+    bool CheckGrid()
+    {
+        std::mt19937 random(7);
+        ChunkGrid<int> grid(4);
+        std::map<Coord, int> expected;
+        int centerX = 0;
+        int centerZ = 0;
+        int radius = 4;
+
+        for (int step = 0; step < 2000; step++)
+        {
+            // Mostly single-chunk moves, some jumps and radius changes
+            const int kind = static_cast<int>(random() % 20);
+            if (kind == 0)
+            {
+                radius = 1 + static_cast<int>(random() % 12);
+            }
+            else if (kind == 1)
+            {
+                centerX += static_cast<int>(random() % 41) - 20;
+                centerZ += static_cast<int>(random() % 41) - 20;
+            }
+            else
+            {
+                centerX += static_cast<int>(random() % 3) - 1;
+                centerZ += static_cast<int>(random() % 3) - 1;
+            }
+
+            std::map<Coord, int> evicted;
+            grid.SetWindow(centerX, centerZ, radius, [&evicted](int chunkX, int chunkZ, int& value) {
+                evicted[Coord(chunkX, chunkZ)] = value;
+            });
+            std::map<Coord, int> expectedEvicted;
+            for (auto it = expected.begin(); it != expected.end();)
+            {
+                if (Chebyshev(it->first.first, it->first.second, centerX, centerZ) > radius)
+                {
+                    expectedEvicted.insert(*it);
+                    it = expected.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            if (evicted != expectedEvicted)
+            {
+                spdlog::error("Step {}: evicted {} chunks, expected {}", step, evicted.size(), expectedEvicted.size());
+                return false;
+            }
+
+            // Fill part of the window, erase a little, and reject a chunk outside it
+            for (int i = 0; i < 8; i++)
+            {
+                const int chunkX = centerX + static_cast<int>(random() % (2 * radius + 1)) - radius;
+                const int chunkZ = centerZ + static_cast<int>(random() % (2 * radius + 1)) - radius;
+                if (random() % 4 == 0)
+                {
+                    if (grid.Erase(chunkX, chunkZ) != (expected.erase(Coord(chunkX, chunkZ)) == 1))
+                    {
+                        spdlog::error("Step {}: erase of ({}, {}) disagrees", step, chunkX, chunkZ);
+                        return false;
+                    }
+                    continue;
+                }
+                *grid.Insert(chunkX, chunkZ) = step;
+                expected[Coord(chunkX, chunkZ)] = step;
+            }
+            if (grid.Insert(centerX + radius + 1, centerZ) || grid.Find(centerX - radius - 1, centerZ))
+            {
+                spdlog::error("Step {}: a chunk outside the window was accepted", step);
+                return false;
+            }
+
+            std::map<Coord, int> contents;
+            grid.ForEach([&contents](int chunkX, int chunkZ, int value) { contents[Coord(chunkX, chunkZ)] = value; });
+            if (contents != expected || grid.Size() != expected.size())
+            {
+                spdlog::error("Step {}: grid holds {} chunks (Size {}), expected {}", step, contents.size(), grid.Size(), expected.size());
+                return false;
+            }
+            for (const auto& [coord, value] : expected)
+            {
+                const int* found = grid.Find(coord.first, coord.second);
+                if (!found || *found != value)
+                {
+                    spdlog::error("Step {}: Find({}, {}) failed", step, coord.first, coord.second);
+                    return false;
+                }
+            }
+
+            size_t visited = 0;
+            int lastDistance = 0;
+            bool ordered = true;
+            grid.ForEachNearestFirst([&](int chunkX, int chunkZ, int&) {
+                const int distance = Chebyshev(chunkX, chunkZ, centerX, centerZ);
+                ordered = ordered && distance >= lastDistance;
+                lastDistance = distance;
+                visited++;
+                return true;
+            });
+            if (!ordered || visited != expected.size())
+            {
+                spdlog::error("Step {}: nearest-first walk visited {} of {} chunks, {}", step, visited, expected.size(),
+                              ordered ? "in order" : "out of order");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Function>
+    double TimeUs(int frames, Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++)
+        {
+            function(frame);
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--distance", "R", &options.renderDistance, 1 },
+            { "--frames", "N", &options.frames, 1 }
+        }))
+    {
+        return 2;
+    }
+
+    if (!CheckGrid())
+    {
+        return 1;
+    }
+    spdlog::info("Chunk grid checks passed");
+
+    const int distance = options.renderDistance;
+    const int loadDistance = distance + 2;
+    std::unordered_map<Coord, RenderRecord, ChunkCoordHash> renderMap;
+    ChunkGrid<RenderRecord> renderGrid(loadDistance);
+    for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+    {
+        for (int chunkX = -distance; chunkX <= distance; chunkX++)
+        {
+            renderMap[Coord(chunkX, chunkZ)].hasLods = ((chunkX ^ chunkZ) & 1) != 0;
+            renderGrid.Insert(chunkX, chunkZ)->hasLods = ((chunkX ^ chunkZ) & 1) != 0;
+        }
+    }
+    size_t sink = 0;  // Keeps the loops from being optimized out
+
+    // Renderer, per frame: every chunk's record once (occluders, cull lists), then a chunk and its
+    // four neighbours looked up per chunk (the cave walk's visibility queries)
+    const double mapWalkUs = TimeUs(options.frames, [&](int) {
+        for (const auto& [coord, record] : renderMap)
+        {
+            sink += record.hasLods ? 1 : 0;
+        }
+    });
+    const double gridWalkUs = TimeUs(options.frames, [&](int) {
+        renderGrid.ForEach([&sink](int, int, const RenderRecord& record) { sink += record.hasLods ? 1 : 0; });
+    });
+    const int offsets[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    const double mapLookupUs = TimeUs(options.frames, [&](int) {
+        for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+        {
+            for (int chunkX = -distance; chunkX <= distance; chunkX++)
+            {
+                for (const auto& offset : offsets)
+                {
+                    auto it = renderMap.find(Coord(chunkX + offset[0], chunkZ + offset[1]));
+                    sink += (it != renderMap.end() && it->second.hasLods) ? 1 : 0;
+                }
+            }
+        }
+    });
+    const double gridLookupUs = TimeUs(options.frames, [&](int) {
+        for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+        {
+            for (int chunkX = -distance; chunkX <= distance; chunkX++)
+            {
+                for (const auto& offset : offsets)
+                {
+                    const RenderRecord* record = renderGrid.Find(chunkX + offset[0], chunkZ + offset[1]);
+                    sink += (record && record->hasLods) ? 1 : 0;
+                }
+            }
+        }
+    });
+
+    // Manager, per chunk crossed (walking +X): the std::set update (build the wanted set, look each
+    // chunk up in the loaded set, sort the new ones by distance, scan the loaded set for unloads)
+    // against moving the window and walking its rings
+    std::set<Coord> loadedSet;
+    ChunkGrid<uint8_t> loadedGrid(loadDistance);
+    const double setUpdateUs = TimeUs(options.frames, [&](int frame) {
+        const int centerX = frame;
+        std::set<Coord> wanted;
+        for (int chunkX = centerX - distance; chunkX <= centerX + distance; chunkX++)
+        {
+            for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+            {
+                wanted.insert(Coord(chunkX, chunkZ));
+            }
+        }
+        std::vector<Coord> toLoad;
+        for (const Coord& coord : wanted)
+        {
+            if (loadedSet.find(coord) == loadedSet.end())
+            {
+                toLoad.push_back(coord);
+            }
+        }
+        std::sort(toLoad.begin(), toLoad.end(), [centerX](const Coord& a, const Coord& b) {
+            return Chebyshev(a.first, a.second, centerX, 0) < Chebyshev(b.first, b.second, centerX, 0);
+        });
+        loadedSet.insert(toLoad.begin(), toLoad.end());
+        std::vector<Coord> toUnload;
+        for (const Coord& coord : loadedSet)
+        {
+            if (Chebyshev(coord.first, coord.second, centerX, 0) > loadDistance)
+            {
+                toUnload.push_back(coord);
+            }
+        }
+        for (const Coord& coord : toUnload)
+        {
+            loadedSet.erase(coord);
+        }
+        sink += toLoad.size() + toUnload.size();
+    });
+    const double gridUpdateUs = TimeUs(options.frames, [&](int frame) {
+        const int centerX = frame;
+        size_t changed = 0;
+        loadedGrid.SetWindow(centerX, 0, loadDistance, [&changed](int, int, uint8_t&) { changed++; });
+        ChunkGrid<uint8_t>::ForEachInRings(centerX, 0, distance, [&](int chunkX, int chunkZ) {
+            if (!loadedGrid.Find(chunkX, chunkZ))
+            {
+                *loadedGrid.Insert(chunkX, chunkZ) = 1;
+                changed++;
+            }
+            return true;
+        });
+        sink += changed;
+    });
+    if (loadedGrid.Size() != loadedSet.size())
+    {
+        spdlog::error("Manager update: the grid holds {} chunks, the set {}", loadedGrid.Size(), loadedSet.size());
+        return 1;
+    }
+
+    spdlog::debug("{}", sink);
+    spdlog::info("Chunk grid benchmark: render distance {} ({} chunks, load distance {}), {} frames",
+                 distance, renderGrid.Size(), loadDistance, options.frames);
+    spdlog::info("  renderer, every chunk:        hash map {:8.1f} us   grid {:8.1f} us   ({:.1f}x)", mapWalkUs, gridWalkUs,
+                 mapWalkUs / gridWalkUs);
+    spdlog::info("  renderer, 5 lookups a chunk:  hash map {:8.1f} us   grid {:8.1f} us   ({:.1f}x)", mapLookupUs, gridLookupUs,
+                 mapLookupUs / gridLookupUs);
+    spdlog::info("  manager, per chunk crossed:   std::set {:8.1f} us   grid {:8.1f} us   ({:.1f}x)", setUpdateUs, gridUpdateUs,
+                 setUpdateUs / gridUpdateUs);
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless frustum culling benchmark.
+// Lays out 10k, 50k and 100k section boxes (16 per chunk column, each with a random tight vertical
+// extent as ChunkMesh bounds have) around a camera and times three ways of frustum culling them:
+// the per-chunk map walk testing full-height section boxes one at a time (as the renderer used to),
+// the packed boxes tested one at a time, and Frustum::CullAABBs. Fails the run if CullAABBs does not
+// return exactly the boxes the one-at-a-time test keeps, in the same order.
+
+#include "BenchmarkCommon.h"
+#include "Rendering/Frustum.h"
+#include "World/Chunk.h"
+#include "World/World.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int views = 16;       // Camera headings per box count
+        int repetitions = 20;  // Timed passes per heading
+    };
+
+    constexpr float ASPECT = 16.0f / 9.0f;
+
+    struct SectionBox
+    {
+        bool present;
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+    using SectionBoxArray = std::array<SectionBox, CHUNK_SECTION_COUNT>;
+
+    struct Scene
+    {
+        std::unordered_map<std::pair<int, int>, SectionBoxArray, ChunkCoordHash> chunks;  // Old layout
+        AABBArray boxes;  // Tight boxes, the same sections
+        size_t sectionCount = 0;
+    };
+
+    // A square of chunk columns centred on chunk (0, 0) holding about boxCount sections; every
+    // section gets a tight box, a random vertical slice of its 16 blocks
+    Scene BuildScene(size_t boxCount, std::mt19937& random)
+    {
+        Scene scene;
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(boxCount) / CHUNK_SECTION_COUNT)));
+        std::uniform_int_distribution<int> layer(0, CHUNK_SECTION_SIZE - 1);
+        scene.boxes.Reserve(boxCount);
+        for (int chunkZ = -side / 2; chunkZ < side - side / 2 && scene.sectionCount < boxCount; chunkZ++)
+        {
+            for (int chunkX = -side / 2; chunkX < side - side / 2 && scene.sectionCount < boxCount; chunkX++)
+            {
+                SectionBoxArray& sections = scene.chunks[std::make_pair(chunkX, chunkZ)];
+                for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+                {
+                    SectionBox& box = sections[section];
+                    box.present = scene.sectionCount < boxCount;
+                    if (!box.present)
+                    {
+                        continue;
+                    }
+                    int bottom = layer(random);
+                    int top = layer(random);
+                    if (top < bottom)
+                    {
+                        std::swap(top, bottom);
+                    }
+                    box.min = glm::vec3(static_cast<float>(chunkX * CHUNK_SIZE_X), static_cast<float>(section * CHUNK_SECTION_SIZE + bottom),
+                                        static_cast<float>(chunkZ * CHUNK_SIZE_Z));
+                    box.max = glm::vec3(box.min.x + CHUNK_SIZE_X, static_cast<float>(section * CHUNK_SECTION_SIZE + top + 1),
+                                        box.min.z + CHUNK_SIZE_Z);
+                    scene.boxes.Add(box.min, box.max);
+                    scene.sectionCount++;
+                }
+            }
+        }
+        return scene;
+    }
+
+    Frustum MakeFrustum(float heading, float farPlane)
+    {
+        const glm::vec3 eye(8.0f, 90.0f, 8.0f);
+        const glm::vec3 forward(std::cos(heading), -0.2f, std::sin(heading));
+        const glm::mat4 view = glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(70.0f), ASPECT, 0.1f, farPlane);
+        Frustum frustum;
+        frustum.ExtractPlanes(projection * view);
+        return frustum;
+    }
+
+    template <typename Function>
+    double TimeNs(int repetitions, Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++)
+        {
+            function();
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--seed", "S", &options.seed },
+            { "--views", "N", &options.views, 1 },
+            { "--repetitions", "N", &options.repetitions, 1 }
+        }))
+    {
+        return 2;
+    }
+
+    spdlog::info("Frustum culling benchmark: {} headings, {} passes each", options.views, options.repetitions);
+    std::mt19937 random(static_cast<unsigned>(options.seed));
+    std::vector<uint32_t> scalarVisible;
+    std::vector<uint32_t> batchVisible;
+    size_t mapVisible = 0;  // Kept so the map walk is not optimized out
+
+    for (size_t boxCount : { size_t(10000), size_t(50000), size_t(100000) })
+    {
+        const Scene scene = BuildScene(boxCount, random);
+        // Far plane at the edge of the square, so some of the boxes are past it
+        const float farPlane = 0.5f * std::sqrt(static_cast<float>(scene.chunks.size())) * CHUNK_SIZE_X;
+        double mapNs = 0.0;
+        double scalarNs = 0.0;
+        double batchNs = 0.0;
+        size_t visibleTotal = 0;
+
+        for (int view = 0; view < options.views; view++)
+        {
+            const Frustum frustum = MakeFrustum(6.2831853f * static_cast<float>(view) / static_cast<float>(options.views), farPlane);
+
+            mapNs += TimeNs(options.repetitions, [&]() {
+                for (const auto& [coord, sections] : scene.chunks)
+                {
+                    for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+                    {
+                        if (!sections[section].present)
+                        {
+                            continue;
+                        }
+                        const glm::vec3 sectionMin(static_cast<float>(coord.first * CHUNK_SIZE_X), static_cast<float>(section * CHUNK_SECTION_SIZE),
+                                                   static_cast<float>(coord.second * CHUNK_SIZE_Z));
+                        mapVisible += frustum.IsAABBVisible(sectionMin, sectionMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z)) ? 1 : 0;
+                    }
+                }
+            });
+            scalarNs += TimeNs(options.repetitions, [&]() {
+                scalarVisible.clear();
+                for (size_t index = 0; index < scene.boxes.Size(); index++)
+                {
+                    if (frustum.IsAABBVisible(scene.boxes.GetMin(index), scene.boxes.GetMax(index)))
+                    {
+                        scalarVisible.push_back(static_cast<uint32_t>(index));
+                    }
+                }
+            });
+            batchNs += TimeNs(options.repetitions, [&]() {
+                batchVisible.clear();
+                frustum.CullAABBs(scene.boxes, batchVisible);
+            });
+
+            if (batchVisible != scalarVisible)
+            {
+                spdlog::error("{} boxes, heading {}: CullAABBs kept {} boxes, IsAABBVisible {}", scene.sectionCount, view,
+                              batchVisible.size(), scalarVisible.size());
+                return 1;
+            }
+            visibleTotal += batchVisible.size();
+        }
+
+        const double tests = static_cast<double>(scene.sectionCount) * options.views * options.repetitions;
+        spdlog::info("  {:>6} boxes ({:.1f}% visible): map walk {:.2f} ns/box, packed {:.2f} ns/box, "
+                     "CullAABBs {:.2f} ns/box ({:.1f}x the map walk, {:.1f}x packed)",
+                     scene.sectionCount, 100.0 * static_cast<double>(visibleTotal) / (static_cast<double>(scene.sectionCount) * options.views),
+                     mapNs / tests, scalarNs / tests, batchNs / tests, mapNs / batchNs, scalarNs / batchNs);
+    }
+
+    spdlog::debug("{} full-height boxes visible", mapVisible);
+    spdlog::info("CullAABBs matched IsAABBVisible on every heading");
+    return 0;
+}
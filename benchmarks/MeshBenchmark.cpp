@@ -0,0 +1,1077 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless chunk meshing benchmark.
+// Meshes the same chunks with every meshing mode and face culling method and reports, per chunk,
+// the face count, the bytes that would be uploaded to the GPU (8-byte packed faces, against the
+// 36-byte indexed vertices they replaced) and the CPU mesh time.
+// Bitmask culling must produce exactly the faces of the per-face reference culling. Baked
+// ambient occlusion is on except in the AO comparison, which reports its meshing overhead. World
+// scenarios include assembling the padded ChunkMeshInput; the synthetic scenario meshes prebuilt
+// inputs directly, without a World. Meshes are never built, so no OpenGL context is needed.
+// The edit scenario measures the CPU remesh cost of single block edits (the main-thread latency
+// before an edit is visible, minus the upload) for whole-chunk and per-section remeshing, and the
+// bytes each would re-upload. Per-section naive meshes must concatenate to the whole-chunk mesh.
+// The allocation scenario counts heap allocations per section mesh with and without the per-thread
+// scratch arenas; both must produce the same faces.
+// The direction scenario places cameras on the terrain surface and counts the opaque and cutout faces
+// each section would still draw once the directions facing away from the camera are skipped.
+// The border scenario loads a render-distance-8 square nearest ring first, meshing each chunk as soon
+// as its terrain exists, then refreshes the border sections of every chunk whose neighbours arrived
+// later, and counts the hidden wall faces that removes. Refreshed chunks must equal full remeshes.
+// The LOD scenario generates a render-distance-32 square and counts the triangles drawn with every
+// chunk at full resolution against distant chunks drawn from their 2x / 4x downsampled meshes
+// (ChunkRenderer's default distances), including the LOD skirts on the full-resolution chunks.
+// The arena scenario allocates every greedy section mesh in a geometry arena allocator with 100%
+// headroom, then remeshes sections to new sizes and reloads whole chunks at random, and reports the
+// fragmentation of the free space and any allocation that no longer fits.
+
+#include "BenchmarkCommon.h"
+#include "World/ChunkMeshGenerator.h"
+#include "World/ChunkMeshInput.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include "Rendering/BlockTextureRegistry.h"
+#include "Rendering/ChunkGeometryArena.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace MinecraftClone;
+
+// Every heap allocation in the process is counted, for the allocations-per-mesh report
+static std::atomic<size_t> g_allocationCount{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int gridSize = 10;   // Generated chunks per side; the outer ring only provides neighbours
+        int repeats = 3;     // Mesh time is the best of this many passes
+        int lodDistance = 32;  // Render distance of the LOD scenario (0 skips it)
+    };
+
+    struct MeshResult
+    {
+        size_t chunks = 0;
+        size_t faces = 0;
+        size_t uploadBytes = 0;
+        double meshMicros = 0.0;   // Best pass, summed over all chunks
+        uint64_t faceHash = 0;     // FNV-1a over the packed faces of all chunks
+    };
+
+    // Bytes per face before vertex pulling: four 36-byte vertices and six 32-bit indices
+    constexpr size_t INDEXED_BYTES_PER_FACE = 4 * sizeof(Vertex) + 6 * sizeof(uint32_t);
+    constexpr double CULLING_SPEEDUP_TARGET = 10.0;  // Bitmask culling's goal over the per-face lookup
+
+    uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    uint64_t HashFaces(uint64_t hash, const ChunkMesh& mesh, RenderLayer layer)
+    {
+        const std::vector<ChunkFace>& faces = mesh.GetFaces(layer);
+        return HashBytes(hash, faces.data(), faces.size() * sizeof(ChunkFace));
+    }
+
+    // One direction's range of a layer (meshes fresh from the mesher hold each direction contiguously)
+    uint64_t HashFaces(uint64_t hash, const ChunkMesh& mesh, RenderLayer layer, int faceIndex)
+    {
+        size_t first = 0;
+        for (int direction = 0; direction < faceIndex; direction++)
+        {
+            first += mesh.GetDirectionFaceCount(layer, direction);
+        }
+        const ChunkFace* faces = mesh.GetFaces(layer).data() + first;
+        return HashBytes(hash, faces, mesh.GetDirectionFaceCount(layer, faceIndex) * sizeof(ChunkFace));
+    }
+
+    uint64_t HashFaces(uint64_t hash, const ChunkMesh& mesh)
+    {
+        for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+        {
+            hash = HashFaces(hash, mesh, static_cast<RenderLayer>(layer));
+        }
+        return hash;
+    }
+
+    void GenerateFlatWorld(World& world, int gridSize)
+    {
+        const int offset = gridSize / 2;
+        for (int chunkZ = -offset; chunkZ < gridSize - offset; chunkZ++)
+        {
+            for (int chunkX = -offset; chunkX < gridSize - offset; chunkX++)
+            {
+                Chunk* chunk = world.GetOrCreateChunk(chunkX, chunkZ);
+                chunk->FillSection(0, BlockType::Stone);
+                chunk->FillSection(1, BlockType::Stone);
+                chunk->FillSection(2, BlockType::Stone);
+                chunk->FillSection(3, BlockType::Dirt);
+                for (int z = 0; z < CHUNK_SIZE_Z; z++)
+                {
+                    for (int x = 0; x < CHUNK_SIZE_X; x++)
+                    {
+                        chunk->SetBlock(x, 0, z, BlockType::Bedrock);
+                        chunk->SetBlock(x, 64, z, BlockType::Grass);
+                    }
+                }
+            }
+        }
+    }
+
+    // Synthetic worst case: random solid, transparent and air blocks everywhere, including the border
+    void GenerateNoiseInputs(std::vector<std::unique_ptr<ChunkMeshInput>>& inputs, int count, int seed)
+    {
+        const BlockType palette[] = { BlockType::Air, BlockType::Air, BlockType::Stone, BlockType::Dirt,
+                                      BlockType::Glass, BlockType::Water, BlockType::Leaves };
+        std::mt19937 rng(static_cast<uint32_t>(seed));
+        std::uniform_int_distribution<int> pick(0, static_cast<int>(sizeof(palette) / sizeof(palette[0])) - 1);
+
+        for (int i = 0; i < count; i++)
+        {
+            auto input = std::make_unique<ChunkMeshInput>();
+            for (int y = 0; y < 64; y++)
+            {
+                for (int z = -1; z <= CHUNK_SIZE_Z; z++)
+                {
+                    for (int x = -1; x <= CHUNK_SIZE_X; x++)
+                    {
+                        input->Set(x, y, z, palette[pick(rng)]);
+                    }
+                }
+            }
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    using MeshFunction = std::function<std::unique_ptr<ChunkMesh>(int chunkIndex, MeshingMode mode)>;
+
+    MeshResult RunMeshing(const MeshFunction& meshChunk, int chunkCount, MeshingMode mode, bool bitmaskCulling, int repeats)
+    {
+        ChunkMeshGenerator::SetBitmaskCulling(bitmaskCulling);
+
+        MeshResult result;
+        result.meshMicros = std::numeric_limits<double>::max();
+
+        for (int pass = 0; pass < repeats; pass++)
+        {
+            MeshResult passResult;
+            passResult.faceHash = 14695981039346656037ull;
+            double passMicros = 0.0;
+
+            for (int chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                auto mesh = meshChunk(chunkIndex, mode);
+                auto end = std::chrono::steady_clock::now();
+
+                passMicros += std::chrono::duration<double, std::micro>(end - start).count();
+                passResult.chunks++;
+                passResult.faces += mesh->GetFaceCount();
+                passResult.uploadBytes += mesh->GetUploadSize();
+                passResult.faceHash = HashFaces(passResult.faceHash, *mesh);
+            }
+
+            passResult.meshMicros = std::min(result.meshMicros, passMicros);
+            result = passResult;
+        }
+
+        ChunkMeshGenerator::SetBitmaskCulling(true);
+        return result;
+    }
+
+    // Mesh the inner chunks of a generated world; the outer ring only provides neighbours
+    MeshFunction WorldMeshFunction(World& world, int gridSize, int& chunkCount)
+    {
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+        chunkCount = inner * inner;
+        return [&world, inner, first](int chunkIndex, MeshingMode mode) {
+            int chunkX = first + chunkIndex % inner;
+            int chunkZ = first + chunkIndex / inner;
+            return ChunkMeshGenerator::GenerateMesh(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ, &world, mode);
+        };
+    }
+
+    double MeasureAssembly(World& world, int gridSize, int repeats)
+    {
+        ChunkMeshInput input;
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+        double best = std::numeric_limits<double>::max();
+        for (int pass = 0; pass < repeats; pass++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < inner * inner; i++)
+            {
+                input.Assemble(&world, first + i % inner, first + i / inner);
+            }
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        return best / static_cast<double>(inner * inner);
+    }
+
+    void Report(const char* label, const char* modeName, const MeshResult& result)
+    {
+        double chunks = static_cast<double>(std::max<size_t>(1, result.chunks));
+        spdlog::info("{:<8} {:<14} chunks={:<4} faces/chunk={:>9.0f}  KiB/chunk={:>8.1f} (indexed {:>8.1f})  mesh={:>8.1f} us/chunk",
+                     label, modeName, result.chunks,
+                     static_cast<double>(result.faces) / chunks,
+                     static_cast<double>(result.uploadBytes) / chunks / 1024.0,
+                     static_cast<double>(result.faces * INDEXED_BYTES_PER_FACE) / chunks / 1024.0,
+                     result.meshMicros / chunks);
+    }
+
+    bool CompareModes(const char* label, const MeshFunction& meshChunk, int chunkCount, int repeats)
+    {
+        MeshResult naiveReference = RunMeshing(meshChunk, chunkCount, MeshingMode::Naive, false, repeats);
+        MeshResult naive = RunMeshing(meshChunk, chunkCount, MeshingMode::Naive, true, repeats);
+        MeshResult greedyReference = RunMeshing(meshChunk, chunkCount, MeshingMode::Greedy, false, repeats);
+        MeshResult greedy = RunMeshing(meshChunk, chunkCount, MeshingMode::Greedy, true, repeats);
+
+        Report(label, "naive/lookup", naiveReference);
+        Report(label, "naive/bitmask", naive);
+        Report(label, "greedy/lookup", greedyReference);
+        Report(label, "greedy/bitmask", greedy);
+
+        spdlog::info("{:<8} bitmask culling: {:.2f}x faster naive, {:.2f}x faster greedy", label,
+                     naiveReference.meshMicros / naive.meshMicros, greedyReference.meshMicros / greedy.meshMicros);
+        if (greedy.faces > 0)
+        {
+            spdlog::info("{:<8} greedy: {:.2f}x fewer faces, {:.2f}x mesh time of naive", label,
+                         static_cast<double>(naive.faces) / static_cast<double>(greedy.faces),
+                         greedy.meshMicros / naive.meshMicros);
+        }
+
+        if (naive.faceHash != naiveReference.faceHash || greedy.faceHash != greedyReference.faceHash)
+        {
+            spdlog::error("{}: bitmask culling produced different faces than the per-face lookup", label);
+            return false;
+        }
+        return true;
+    }
+
+    // Padded inputs of the inner chunks of a generated world, for timing without the World
+    void AssembleWorldInputs(World& world, int gridSize, std::vector<std::unique_ptr<ChunkMeshInput>>& inputs)
+    {
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+        for (int i = 0; i < inner * inner; i++)
+        {
+            auto input = std::make_unique<ChunkMeshInput>();
+            input->Assemble(&world, first + i % inner, first + i / inner);
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    // The culling step on its own (no quads built), per-face lookups against bitmask rows; both must
+    // leave the same number of faces
+    bool CompareCulling(const char* label, const std::vector<std::unique_ptr<ChunkMeshInput>>& inputs, int repeats)
+    {
+        double micros[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+        size_t faces[2] = { 0, 0 };
+        for (int bitmask = 0; bitmask < 2; bitmask++)
+        {
+            ChunkMeshGenerator::SetBitmaskCulling(bitmask != 0);
+            for (int pass = 0; pass < repeats; pass++)
+            {
+                faces[bitmask] = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (const auto& input : inputs)
+                {
+                    faces[bitmask] += ChunkMeshGenerator::CullFaces(*input);
+                }
+                auto end = std::chrono::steady_clock::now();
+                micros[bitmask] = std::min(micros[bitmask], std::chrono::duration<double, std::micro>(end - start).count());
+            }
+        }
+        ChunkMeshGenerator::SetBitmaskCulling(true);
+
+        const double chunks = static_cast<double>(std::max<size_t>(1, inputs.size()));
+        const double speedup = micros[0] / micros[1];
+        spdlog::info("{:<8} culling only: lookup {:>7.1f} us/chunk, bitmask {:>6.1f} us/chunk ({:.1f}x faster, {} the {:.0f}x target)", label,
+                     micros[0] / chunks, micros[1] / chunks, speedup, speedup >= CULLING_SPEEDUP_TARGET ? "meets" : "short of",
+                     CULLING_SPEEDUP_TARGET);
+        if (faces[0] != faces[1])
+        {
+            spdlog::error("{}: bitmask culling left {} faces, the per-face lookup {}", label, faces[1], faces[0]);
+            return false;
+        }
+        return true;
+    }
+
+    struct EditResult
+    {
+        int edits = 0;
+        size_t sections = 0;       // Sections (or chunks) remeshed over all edits
+        size_t uploadBytes = 0;
+        double meshMicros = 0.0;
+    };
+
+    // Remesh as block edits did before sections existed: the whole chunk, then its four face
+    // neighbours and the chunk itself twice more (the old offset table listed {0, 0} twice)
+    void RemeshChunks(World& world, int worldX, int worldZ, EditResult& result)
+    {
+        static const int offsets[7][2] = { {0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1}, {0, 0}, {0, 0} };
+        auto chunkCoords = World::GetChunkCoords(worldX, worldZ);
+        for (const auto& offset : offsets)
+        {
+            int chunkX = chunkCoords.first + offset[0];
+            int chunkZ = chunkCoords.second + offset[1];
+            auto mesh = ChunkMeshGenerator::GenerateMesh(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ, &world, MeshingMode::Greedy);
+            result.sections++;
+            result.uploadBytes += mesh->GetUploadSize();
+        }
+    }
+
+    void RemeshSections(World& world, int worldX, int worldY, int worldZ, EditResult& result)
+    {
+        SectionRemesh updates[ChunkMeshGenerator::MAX_AFFECTED_CHUNKS];
+        int updateCount = ChunkMeshGenerator::GetSectionsAffectedByBlock(worldX, worldY, worldZ, updates);
+        for (int i = 0; i < updateCount; i++)
+        {
+            auto meshes = ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(updates[i].chunkX, updates[i].chunkZ),
+                                                                    updates[i].chunkX, updates[i].chunkZ, &world,
+                                                                    updates[i].sectionMask, MeshingMode::Greedy);
+            result.sections += std::bitset<CHUNK_SECTION_COUNT>(updates[i].sectionMask).count();
+            for (const auto& mesh : meshes.sections)
+            {
+                result.uploadBytes += mesh ? mesh->GetUploadSize() : 0;
+            }
+        }
+    }
+
+    // Break or place surface blocks inside the meshed area and remesh after each edit both ways
+    void MeasureEdits(World& world, int gridSize, int editCount, int seed, EditResult& chunkResult, EditResult& sectionResult)
+    {
+        const int inner = gridSize - 2;
+        const int first = (-gridSize / 2 + 1) * CHUNK_SIZE_X;
+        std::mt19937 rng(static_cast<uint32_t>(seed));
+        std::uniform_int_distribution<int> coordDist(0, inner * CHUNK_SIZE_X - 1);
+
+        for (int edit = 0; edit < editCount; edit++)
+        {
+            int worldX = first + coordDist(rng);
+            int worldZ = first + coordDist(rng);
+            int worldY = Benchmark::FindSurface(world, worldX, worldZ);
+            if (edit % 2 == 0)
+            {
+                world.SetBlock(worldX, worldY, worldZ, BlockType::Air);
+            }
+            else
+            {
+                worldY = std::min(worldY + 1, CHUNK_SIZE_Y - 1);
+                world.SetBlock(worldX, worldY, worldZ, BlockType::Cobblestone);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            RemeshChunks(world, worldX, worldZ, chunkResult);
+            auto middle = std::chrono::steady_clock::now();
+            RemeshSections(world, worldX, worldY, worldZ, sectionResult);
+            auto end = std::chrono::steady_clock::now();
+
+            chunkResult.meshMicros += std::chrono::duration<double, std::micro>(middle - start).count();
+            sectionResult.meshMicros += std::chrono::duration<double, std::micro>(end - middle).count();
+            chunkResult.edits++;
+            sectionResult.edits++;
+        }
+    }
+
+    void ReportEdits(const char* label, const EditResult& result)
+    {
+        double edits = static_cast<double>(std::max(1, result.edits));
+        spdlog::info("edit     {:<14} edits={:<4} remeshed/edit={:>5.2f}  KiB/edit={:>8.1f}  remesh={:>8.1f} us/edit",
+                     label, result.edits, static_cast<double>(result.sections) / edits,
+                     static_cast<double>(result.uploadBytes) / edits / 1024.0, result.meshMicros / edits);
+    }
+
+    // Naive meshes have no cross-layer merging, so the section meshes of a chunk concatenated in
+    // order must be exactly the whole-chunk mesh
+    bool SectionsMatchChunks(World& world, int gridSize)
+    {
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+        for (int i = 0; i < inner * inner; i++)
+        {
+            int chunkX = first + i % inner;
+            int chunkZ = first + i / inner;
+            Chunk* chunk = world.GetChunk(chunkX, chunkZ);
+
+            auto whole = ChunkMeshGenerator::GenerateMesh(chunk, chunkX, chunkZ, &world, MeshingMode::Naive);
+            auto sections = ChunkMeshGenerator::GenerateSectionMeshes(chunk, chunkX, chunkZ, &world,
+                                                                      ChunkMeshGenerator::ALL_SECTIONS, MeshingMode::Naive);
+
+            // Range by range: each direction of each layer of the whole chunk is that range of every section in turn
+            bool same = true;
+            for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+            {
+                const RenderLayer renderLayer = static_cast<RenderLayer>(layer);
+                for (int direction = 0; direction < ChunkMesh::DIRECTION_COUNT; direction++)
+                {
+                    uint64_t wholeHash = HashFaces(14695981039346656037ull, *whole, renderLayer, direction);
+                    uint64_t sectionHash = 14695981039346656037ull;
+                    for (const auto& mesh : sections.sections)
+                    {
+                        if (mesh)
+                        {
+                            sectionHash = HashFaces(sectionHash, *mesh, renderLayer, direction);
+                        }
+                    }
+                    same = same && wholeHash == sectionHash;
+                }
+            }
+
+            if (!same)
+            {
+                spdlog::error("Section meshes of chunk ({}, {}) differ from the whole-chunk mesh", chunkX, chunkZ);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct AllocationResult
+    {
+        size_t chunks = 0;
+        size_t sectionMeshes = 0;   // Non-empty section meshes produced
+        size_t allocations = 0;     // Heap allocations made while meshing them
+        double meshMicros = 0.0;
+        uint64_t faceHash = 0;
+    };
+
+    // Mesh every section of the inner chunks as a worker would, once to warm up (the per-thread
+    // scratch grows on the first jobs) and once measured
+    AllocationResult MeasureAllocations(World& world, int gridSize, MeshingMode mode, bool scratchReuse)
+    {
+        ChunkMeshGenerator::SetScratchReuse(scratchReuse);
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+
+        AllocationResult result;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            result = AllocationResult();
+            result.faceHash = 14695981039346656037ull;
+            for (int i = 0; i < inner * inner; i++)
+            {
+                int chunkX = first + i % inner;
+                int chunkZ = first + i / inner;
+                Chunk* chunk = world.GetChunk(chunkX, chunkZ);
+
+                size_t before = g_allocationCount.load(std::memory_order_relaxed);
+                auto start = std::chrono::steady_clock::now();
+                auto meshes = ChunkMeshGenerator::GenerateSectionMeshes(chunk, chunkX, chunkZ, &world,
+                                                                        ChunkMeshGenerator::ALL_SECTIONS, mode);
+                auto end = std::chrono::steady_clock::now();
+                result.allocations += g_allocationCount.load(std::memory_order_relaxed) - before;
+                result.meshMicros += std::chrono::duration<double, std::micro>(end - start).count();
+                result.chunks++;
+
+                for (const auto& mesh : meshes.sections)
+                {
+                    if (mesh)
+                    {
+                        result.sectionMeshes++;
+                        result.faceHash = HashFaces(result.faceHash, *mesh);
+                    }
+                }
+            }
+        }
+
+        ChunkMeshGenerator::SetScratchReuse(true);
+        return result;
+    }
+
+    void ReportAllocations(const char* modeName, const char* scratchName, const AllocationResult& result)
+    {
+        double chunks = static_cast<double>(std::max<size_t>(1, result.chunks));
+        spdlog::info("alloc    {:<6} {:<12} allocations/chunk={:>7.1f}  allocations/section mesh={:>6.2f}  mesh={:>8.1f} us/chunk",
+                     modeName, scratchName, static_cast<double>(result.allocations) / chunks,
+                     static_cast<double>(result.allocations) / static_cast<double>(std::max<size_t>(1, result.sectionMeshes)),
+                     result.meshMicros / chunks);
+    }
+
+    bool CompareScratchReuse(World& world, int gridSize)
+    {
+        bool matches = true;
+        for (MeshingMode mode : { MeshingMode::Naive, MeshingMode::Greedy })
+        {
+            const char* modeName = (mode == MeshingMode::Naive) ? "naive" : "greedy";
+            AllocationResult fresh = MeasureAllocations(world, gridSize, mode, false);
+            AllocationResult reused = MeasureAllocations(world, gridSize, mode, true);
+            ReportAllocations(modeName, "fresh", fresh);
+            ReportAllocations(modeName, "scratch", reused);
+            if (fresh.faceHash != reused.faceHash)
+            {
+                spdlog::error("{}: meshing with scratch arenas produced different faces", modeName);
+                matches = false;
+            }
+        }
+        return matches;
+    }
+
+    struct DirectionResult
+    {
+        size_t faces = 0;          // Opaque and cutout faces of every section, summed over the cameras
+        size_t drawnFaces = 0;     // Those left after skipping the directions facing away
+        size_t distantFaces = 0;   // The same for sections more than two chunks from the camera
+        size_t distantDrawnFaces = 0;
+    };
+
+    DirectionResult MeasureDirectionCulling(World& world, int gridSize, MeshingMode mode, int cameraCount, int seed)
+    {
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+        std::mt19937 rng(static_cast<uint32_t>(seed));
+        std::uniform_int_distribution<int> coordDist(0, inner * CHUNK_SIZE_X - 1);
+
+        std::vector<glm::vec3> cameras;
+        for (int i = 0; i < cameraCount; i++)
+        {
+            int worldX = first * CHUNK_SIZE_X + coordDist(rng);
+            int worldZ = first * CHUNK_SIZE_Z + coordDist(rng);
+            cameras.emplace_back(worldX + 0.5f, Benchmark::FindSurface(world, worldX, worldZ) + 2.6f, worldZ + 0.5f);
+        }
+
+        DirectionResult result;
+        const float distantSquared = static_cast<float>(2 * CHUNK_SIZE_X) * static_cast<float>(2 * CHUNK_SIZE_X);
+        for (int i = 0; i < inner * inner; i++)
+        {
+            int chunkX = first + i % inner;
+            int chunkZ = first + i / inner;
+            auto meshes = ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ, &world,
+                                                                    ChunkMeshGenerator::ALL_SECTIONS, mode);
+            for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+            {
+                const ChunkMesh* mesh = meshes.sections[section].get();
+                if (!mesh)
+                {
+                    continue;
+                }
+
+                const glm::vec3 sectionMin(static_cast<float>(chunkX * CHUNK_SIZE_X), static_cast<float>(section * CHUNK_SECTION_SIZE),
+                                           static_cast<float>(chunkZ * CHUNK_SIZE_Z));
+                const glm::vec3 sectionMax = sectionMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z);
+                for (const glm::vec3& camera : cameras)
+                {
+                    const uint8_t directions = ChunkMesh::GetFacingDirections(camera, sectionMin, sectionMax);
+                    size_t faces = 0;
+                    size_t drawn = 0;
+                    for (RenderLayer layer : { RenderLayer::Opaque, RenderLayer::Cutout })
+                    {
+                        faces += mesh->GetFaces(layer).size();
+                        drawn += mesh->GetFaceCount(layer, directions);
+                    }
+                    result.faces += faces;
+                    result.drawnFaces += drawn;
+
+                    const glm::vec3 offset = (sectionMin + sectionMax) * 0.5f - camera;
+                    if (glm::dot(offset, offset) > distantSquared)
+                    {
+                        result.distantFaces += faces;
+                        result.distantDrawnFaces += drawn;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    void ReportDirectionCulling(const char* modeName, const DirectionResult& result)
+    {
+        auto skipped = [](size_t faces, size_t drawn) {
+            return 100.0 * static_cast<double>(faces - drawn) / static_cast<double>(std::max<size_t>(1, faces));
+        };
+        spdlog::info("backface {:<6} faces skipped by direction: {:.1f}% of all sections, {:.1f}% beyond two chunks",
+                     modeName, skipped(result.faces, result.drawnFaces), skipped(result.distantFaces, result.distantDrawnFaces));
+    }
+
+    struct BorderResult
+    {
+        size_t chunks = 0;
+        size_t facesOnArrival = 0;     // Every chunk meshed when its terrain arrived
+        size_t facesRefreshed = 0;     // After the border refreshes
+        size_t refreshes = 0;          // (chunk, neighbour) pairs refreshed
+        size_t refreshedSections = 0;
+        size_t outerRingFaces = 0;     // Walls toward chunks beyond the render distance, which never arrive
+        bool matchesFullRemesh = true;
+    };
+
+    size_t CountFaces(const ChunkSectionMeshes& meshes)
+    {
+        size_t faces = 0;
+        for (const auto& mesh : meshes.sections)
+        {
+            faces += mesh ? mesh->GetFaceCount() : 0;
+        }
+        return faces;
+    }
+
+    BorderResult MeasureBorderRefresh(TerrainGenerator& generator, int renderDistance, MeshingMode mode)
+    {
+        // ChunkManager's load order: nearest ring first (Chebyshev distance), (x, z) order within a ring
+        std::vector<std::pair<int, int>> order;
+        for (int chunkX = -renderDistance; chunkX <= renderDistance; chunkX++)
+        {
+            for (int chunkZ = -renderDistance; chunkZ <= renderDistance; chunkZ++)
+            {
+                order.emplace_back(chunkX, chunkZ);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+            return std::max(std::abs(a.first), std::abs(a.second)) < std::max(std::abs(b.first), std::abs(b.second));
+        });
+
+        BorderResult result;
+        World world;
+        std::map<std::pair<int, int>, ChunkSectionMeshes> meshes;
+        std::map<std::pair<int, int>, std::vector<std::pair<int, int>>> missing;  // Neighbour offsets meshed as air
+        spdlog::set_level(spdlog::level::warn);
+        for (const auto& coord : order)
+        {
+            Chunk* chunk = world.GetOrCreateChunk(coord.first, coord.second);
+            generator.GenerateChunk(chunk, coord.first, coord.second, &world);
+            for (int dz = -1; dz <= 1; dz++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    if ((dx != 0 || dz != 0) && !world.GetChunk(coord.first + dx, coord.second + dz))
+                    {
+                        missing[coord].emplace_back(dx, dz);
+                    }
+                }
+            }
+            meshes[coord] = ChunkMeshGenerator::GenerateSectionMeshes(chunk, coord.first, coord.second, &world,
+                                                                      ChunkMeshGenerator::ALL_SECTIONS, mode);
+            result.facesOnArrival += CountFaces(meshes[coord]);
+        }
+        spdlog::set_level(spdlog::level::info);
+        result.chunks = order.size();
+
+        for (const auto& coord : order)
+        {
+            Chunk* chunk = world.GetChunk(coord.first, coord.second);
+            uint32_t sections = 0;
+            bool outerRing = false;
+            for (const auto& offset : missing[coord])
+            {
+                if (!world.GetChunk(coord.first + offset.first, coord.second + offset.second))
+                {
+                    outerRing = true;
+                    continue;
+                }
+                const uint32_t border = ChunkMeshGenerator::GetBorderSections(*chunk, offset.first, offset.second);
+                sections |= border;
+                result.refreshes += (border != 0) ? 1 : 0;
+            }
+            result.refreshedSections += std::bitset<CHUNK_SECTION_COUNT>(sections).count();
+
+            ChunkSectionMeshes& current = meshes[coord];
+            if (sections != 0)
+            {
+                ChunkSectionMeshes refreshed = ChunkMeshGenerator::GenerateSectionMeshes(chunk, coord.first, coord.second, &world,
+                                                                                         sections, mode);
+                for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+                {
+                    if (sections & (1u << section))
+                    {
+                        current.sections[section] = std::move(refreshed.sections[section]);
+                    }
+                }
+            }
+            const size_t faces = CountFaces(current);
+            result.facesRefreshed += faces;
+            result.outerRingFaces += outerRing ? faces : 0;
+
+            // Sections outside the refreshed borders must already be what a full remesh produces now
+            ChunkSectionMeshes full = ChunkMeshGenerator::GenerateSectionMeshes(chunk, coord.first, coord.second, &world,
+                                                                                ChunkMeshGenerator::ALL_SECTIONS, mode);
+            for (int section = 0; section < CHUNK_SECTION_COUNT && !outerRing; section++)
+            {
+                const ChunkMesh* a = current.sections[section].get();
+                const ChunkMesh* b = full.sections[section].get();
+                const uint64_t seed = 14695981039346656037ull;
+                if ((a == nullptr) != (b == nullptr) || (a && HashFaces(seed, *a) != HashFaces(seed, *b)))
+                {
+                    spdlog::error("Border refresh of chunk ({}, {}) section {} differs from a full remesh",
+                                  coord.first, coord.second, section);
+                    result.matchesFullRemesh = false;
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    void ReportBorderRefresh(const char* modeName, const BorderResult& result)
+    {
+        const size_t removed = result.facesOnArrival - result.facesRefreshed;
+        spdlog::info("border   {:<6} chunks={}  faces on arrival={}  after refresh={}  hidden faces removed={} ({:.1f}%, {:.0f}/chunk)",
+                     modeName, result.chunks, result.facesOnArrival, result.facesRefreshed, removed,
+                     100.0 * static_cast<double>(removed) / static_cast<double>(std::max<size_t>(1, result.facesOnArrival)),
+                     static_cast<double>(removed) / static_cast<double>(std::max<size_t>(1, result.chunks)));
+        spdlog::info("border   {:<6} refreshes={}  sections remeshed={} ({:.1f}/refresh, against 16 for a full remesh)  outer ring faces={}",
+                     modeName, result.refreshes, result.refreshedSections,
+                     static_cast<double>(result.refreshedSections) / static_cast<double>(std::max<size_t>(1, result.refreshes)),
+                     result.outerRingFaces);
+    }
+
+    struct LodResult
+    {
+        size_t chunks = 0;
+        size_t fullFaces = 0;               // Every chunk's sections, no LOD
+        size_t nearFaces = 0;               // Chunks kept at full resolution, with LOD skirts
+        size_t nearFacesWithoutSkirts = 0;  // The same chunks without
+        size_t levelChunks[ChunkMeshInput::LOD_LEVEL_COUNT] = {};
+        size_t levelFaces[ChunkMeshInput::LOD_LEVEL_COUNT] = {};
+        double levelMicros[ChunkMeshInput::LOD_LEVEL_COUNT] = {};
+    };
+
+    LodResult MeasureLod(TerrainGenerator& generator, int renderDistance)
+    {
+        // ChunkRenderer's defaults: 2x from 8 chunks (camera to chunk centre), 4x from 16
+        const float lodDistances[ChunkMeshInput::LOD_LEVEL_COUNT] = { 8.0f * CHUNK_SIZE_X, 16.0f * CHUNK_SIZE_X };
+
+        World world;
+        spdlog::set_level(spdlog::level::warn);
+        Benchmark::GenerateTerrainSquare(world, generator, -renderDistance, renderDistance);
+        spdlog::set_level(spdlog::level::info);
+
+        LodResult result;
+        for (int chunkZ = -renderDistance; chunkZ <= renderDistance; chunkZ++)
+        {
+            for (int chunkX = -renderDistance; chunkX <= renderDistance; chunkX++)
+            {
+                Chunk* chunk = world.GetChunk(chunkX, chunkZ);
+                result.chunks++;
+
+                ChunkMeshGenerator::SetLodEnabled(false);
+                const size_t faces = CountFaces(ChunkMeshGenerator::GenerateSectionMeshes(
+                    chunk, chunkX, chunkZ, &world, ChunkMeshGenerator::ALL_SECTIONS, MeshingMode::Greedy));
+                result.fullFaces += faces;
+
+                // Camera in the middle of chunk (0, 0)
+                const float distance = std::sqrt(static_cast<float>(chunkX * chunkX + chunkZ * chunkZ)) * CHUNK_SIZE_X;
+                int level = -1;
+                for (int candidate = 0; candidate < ChunkMeshInput::LOD_LEVEL_COUNT; candidate++)
+                {
+                    level = (distance >= lodDistances[candidate]) ? candidate : level;
+                }
+
+                ChunkMeshGenerator::SetLodEnabled(true);
+                if (level < 0)
+                {
+                    result.nearFacesWithoutSkirts += faces;
+                    result.nearFaces += CountFaces(ChunkMeshGenerator::GenerateSectionMeshes(
+                        chunk, chunkX, chunkZ, &world, ChunkMeshGenerator::ALL_SECTIONS, MeshingMode::Greedy));
+                    continue;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                auto mesh = ChunkMeshGenerator::GenerateLodMesh(chunk, chunkX, chunkZ, &world, level);
+                auto end = std::chrono::steady_clock::now();
+                result.levelChunks[level]++;
+                result.levelFaces[level] += mesh ? mesh->GetFaceCount() : 0;
+                result.levelMicros[level] += std::chrono::duration<double, std::micro>(end - start).count();
+            }
+        }
+        ChunkMeshGenerator::SetLodEnabled(false);
+        return result;
+    }
+
+    void ReportLod(int renderDistance, const LodResult& result)
+    {
+        size_t lodFaces = result.nearFaces;
+        for (int level = 0; level < ChunkMeshInput::LOD_LEVEL_COUNT; level++)
+        {
+            lodFaces += result.levelFaces[level];
+        }
+
+        spdlog::info("lod      render distance {}: {} chunks, greedy", renderDistance, result.chunks);
+        spdlog::info("lod      full resolution  triangles={:>9}", result.fullFaces * 2);
+        spdlog::info("lod      with LOD         triangles={:>9}  ({:.1f}x fewer)", lodFaces * 2,
+                     static_cast<double>(result.fullFaces) / static_cast<double>(std::max<size_t>(1, lodFaces)));
+        spdlog::info("lod        full resolution chunks={:>5}  triangles={:>9}  (LOD skirts {:+.1f}%)",
+                     result.chunks - result.levelChunks[0] - result.levelChunks[1], result.nearFaces * 2,
+                     (static_cast<double>(result.nearFaces) / static_cast<double>(std::max<size_t>(1, result.nearFacesWithoutSkirts)) - 1.0) * 100.0);
+        for (int level = 0; level < ChunkMeshInput::LOD_LEVEL_COUNT; level++)
+        {
+            const double chunks = static_cast<double>(std::max<size_t>(1, result.levelChunks[level]));
+            spdlog::info("lod        {}x              chunks={:>5}  triangles={:>9}  mesh={:>7.1f} us/chunk",
+                         ChunkMeshInput::GetLodScale(level), result.levelChunks[level], result.levelFaces[level] * 2,
+                         result.levelMicros[level] / chunks);
+        }
+    }
+
+    struct ArenaResult
+    {
+        FreeListAllocator::Stats loaded;   // Every section allocated once
+        FreeListAllocator::Stats churned;  // After the remeshes and reloads
+        size_t operations = 0;             // Allocations and frees during the churn
+        double churnMicros = 0.0;
+    };
+
+    ArenaResult MeasureArena(World& world, int gridSize, int remeshes, int seed)
+    {
+        const int inner = gridSize - 2;
+        const int first = -gridSize / 2 + 1;
+
+        // Face count of every non-empty section, as the renderer would upload them
+        std::vector<std::vector<uint32_t>> sizes(inner * inner);
+        uint64_t totalFaces = 0;
+        for (int i = 0; i < inner * inner; i++)
+        {
+            int chunkX = first + i % inner;
+            int chunkZ = first + i / inner;
+            auto meshes = ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ, &world,
+                                                                    ChunkMeshGenerator::ALL_SECTIONS, MeshingMode::Greedy);
+            for (const auto& mesh : meshes.sections)
+            {
+                if (mesh)
+                {
+                    sizes[i].push_back(static_cast<uint32_t>(mesh->GetFaceCount()));
+                    totalFaces += mesh->GetFaceCount();
+                }
+            }
+        }
+
+        FreeListAllocator allocator(static_cast<uint32_t>(totalFaces * 2));
+        std::vector<std::vector<uint32_t>> offsets(sizes.size());
+        ArenaResult result;
+        auto allocate = [&](size_t chunk, size_t section) {
+            offsets[chunk][section] = allocator.Allocate(sizes[chunk][section]);
+            result.operations++;
+        };
+        auto release = [&](size_t chunk, size_t section) {
+            if (offsets[chunk][section] != FreeListAllocator::INVALID_OFFSET)
+            {
+                allocator.Free(offsets[chunk][section], sizes[chunk][section]);
+            }
+            result.operations++;
+        };
+
+        for (size_t chunk = 0; chunk < sizes.size(); chunk++)
+        {
+            offsets[chunk].resize(sizes[chunk].size());
+            for (size_t section = 0; section < sizes[chunk].size(); section++)
+            {
+                allocate(chunk, section);
+            }
+        }
+        result.loaded = allocator.GetStats();
+        result.operations = 0;
+
+        // Edits change a section's size by up to a quarter either way; every tenth operation reloads a whole chunk
+        std::mt19937 rng(static_cast<uint32_t>(seed));
+        std::uniform_int_distribution<size_t> pickChunk(0, sizes.size() - 1);
+        std::uniform_real_distribution<double> resize(0.75, 1.25);
+        auto start = std::chrono::steady_clock::now();
+        for (int operation = 0; operation < remeshes; operation++)
+        {
+            const size_t chunk = pickChunk(rng);
+            if (sizes[chunk].empty())
+            {
+                continue;
+            }
+            if (operation % 10 == 9)
+            {
+                for (size_t section = 0; section < sizes[chunk].size(); section++)
+                {
+                    release(chunk, section);
+                }
+                for (size_t section = 0; section < sizes[chunk].size(); section++)
+                {
+                    allocate(chunk, section);
+                }
+                continue;
+            }
+            const size_t section = std::uniform_int_distribution<size_t>(0, sizes[chunk].size() - 1)(rng);
+            release(chunk, section);
+            sizes[chunk][section] = std::max<uint32_t>(1, static_cast<uint32_t>(sizes[chunk][section] * resize(rng)));
+            allocate(chunk, section);
+        }
+        auto end = std::chrono::steady_clock::now();
+        result.churnMicros = std::chrono::duration<double, std::micro>(end - start).count();
+        result.churned = allocator.GetStats();
+        return result;
+    }
+
+    void ReportArena(const ArenaResult& result)
+    {
+        auto report = [](const char* label, const FreeListAllocator::Stats& stats) {
+            spdlog::info("arena    {:<8} used={:>6.1f} / {:>6.1f} KiB  allocations={:<5} free blocks={:<5} largest free={:>6.1f} KiB  "
+                         "fragmentation={:>5.1f}%  failed={}",
+                         label, static_cast<double>(stats.used) * sizeof(ChunkFace) / 1024.0,
+                         static_cast<double>(stats.capacity) * sizeof(ChunkFace) / 1024.0, stats.allocations, stats.freeBlocks,
+                         static_cast<double>(stats.largestFreeBlock) * sizeof(ChunkFace) / 1024.0,
+                         stats.GetFragmentation() * 100.0f, stats.failedAllocations);
+        };
+        report("loaded", result.loaded);
+        report("churned", result.churned);
+        spdlog::info("arena    {} allocations and frees, {:.2f} us each", result.operations,
+                     result.churnMicros / static_cast<double>(std::max<size_t>(1, result.operations)));
+    }
+
+    void CompareAmbientOcclusion(const char* label, const MeshFunction& meshChunk, int chunkCount, int repeats)
+    {
+        ChunkMeshGenerator::SetAmbientOcclusion(false);
+        MeshResult naiveOpen = RunMeshing(meshChunk, chunkCount, MeshingMode::Naive, true, repeats);
+        MeshResult greedyOpen = RunMeshing(meshChunk, chunkCount, MeshingMode::Greedy, true, repeats);
+        ChunkMeshGenerator::SetAmbientOcclusion(true);
+        MeshResult naive = RunMeshing(meshChunk, chunkCount, MeshingMode::Naive, true, repeats);
+        MeshResult greedy = RunMeshing(meshChunk, chunkCount, MeshingMode::Greedy, true, repeats);
+
+        Report(label, "naive/no AO", naiveOpen);
+        Report(label, "naive/AO", naive);
+        Report(label, "greedy/no AO", greedyOpen);
+        Report(label, "greedy/AO", greedy);
+        spdlog::info("{:<8} ambient occlusion: {:+.0f}% mesh time naive, {:+.0f}% mesh time greedy, {:.2f}x greedy faces",
+                     label, (naive.meshMicros / naiveOpen.meshMicros - 1.0) * 100.0,
+                     (greedy.meshMicros / greedyOpen.meshMicros - 1.0) * 100.0,
+                     static_cast<double>(greedy.faces) / static_cast<double>(std::max<size_t>(1, greedyOpen.faces)));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--seed", "S", &options.seed },
+            { "--grid", "N", &options.gridSize, 3 },
+            { "--repeats", "R", &options.repeats, 1 },
+            { "--lod-distance", "D", &options.lodDistance, 0 }
+        }))
+    {
+        return 2;
+    }
+
+    // Keep registry / generator setup logs out of the report
+    spdlog::set_level(spdlog::level::warn);
+    TerrainGenerator generator;
+    Benchmark::InitializeTerrain(generator, options.seed);
+    BlockTextureRegistry::Initialize();
+
+    World terrainWorld;
+    Benchmark::GenerateTerrainSquare(terrainWorld, generator, -options.gridSize / 2, options.gridSize - options.gridSize / 2 - 1);
+
+    World flatWorld;
+    GenerateFlatWorld(flatWorld, options.gridSize);
+    spdlog::set_level(spdlog::level::info);
+
+    int inner = options.gridSize - 2;
+    spdlog::info("Mesh benchmark: seed {}, {}x{} meshed chunks, best of {}", options.seed, inner, inner, options.repeats);
+    spdlog::info("padded input assembly: {:.1f} us/chunk (included in terrain / flat mesh times)",
+                 MeasureAssembly(terrainWorld, options.gridSize, options.repeats));
+
+    int chunkCount = 0;
+    MeshFunction meshTerrain = WorldMeshFunction(terrainWorld, options.gridSize, chunkCount);
+    bool matches = CompareModes("terrain", meshTerrain, chunkCount, options.repeats);
+    MeshFunction meshFlat = WorldMeshFunction(flatWorld, options.gridSize, chunkCount);
+    matches = CompareModes("flat", meshFlat, chunkCount, options.repeats) && matches;
+    CompareAmbientOcclusion("terrain", meshTerrain, chunkCount, options.repeats);
+    CompareAmbientOcclusion("flat", meshFlat, chunkCount, options.repeats);
+
+    // World-free input
+    std::vector<std::unique_ptr<ChunkMeshInput>> noiseInputs;
+    GenerateNoiseInputs(noiseInputs, 8, options.seed);
+    MeshFunction meshNoise = [&noiseInputs](int chunkIndex, MeshingMode mode) {
+        return ChunkMeshGenerator::GenerateMesh(*noiseInputs[chunkIndex], 0, 0, mode);
+    };
+    matches = CompareModes("noise", meshNoise, static_cast<int>(noiseInputs.size()), options.repeats) && matches;
+
+    // The culling step apart from quad output, which dominates the mesh times above
+    std::vector<std::unique_ptr<ChunkMeshInput>> terrainInputs;
+    std::vector<std::unique_ptr<ChunkMeshInput>> flatInputs;
+    AssembleWorldInputs(terrainWorld, options.gridSize, terrainInputs);
+    AssembleWorldInputs(flatWorld, options.gridSize, flatInputs);
+    matches = CompareCulling("terrain", terrainInputs, options.repeats) && matches;
+    matches = CompareCulling("flat", flatInputs, options.repeats) && matches;
+    matches = CompareCulling("noise", noiseInputs, options.repeats) && matches;
+
+    // Single block edits (greedy): whole chunks as before against the touched sections
+    matches = SectionsMatchChunks(terrainWorld, options.gridSize) && matches;
+    EditResult chunkEdits;
+    EditResult sectionEdits;
+    MeasureEdits(terrainWorld, options.gridSize, 100 * options.repeats, options.seed, chunkEdits, sectionEdits);
+    ReportEdits("chunks", chunkEdits);
+    ReportEdits("sections", sectionEdits);
+    spdlog::info("edit     sections: {:.1f}x lower remesh latency, {:.1f}x fewer bytes re-uploaded",
+                 chunkEdits.meshMicros / std::max(1e-3, sectionEdits.meshMicros),
+                 static_cast<double>(chunkEdits.uploadBytes) / static_cast<double>(std::max<size_t>(1, sectionEdits.uploadBytes)));
+
+    // Heap allocations per section mesh (terrain, all sections of every chunk)
+    matches = CompareScratchReuse(terrainWorld, options.gridSize) && matches;
+
+    // Opaque / cutout faces a camera on the surface still draws with per-direction ranges
+    ReportDirectionCulling("naive", MeasureDirectionCulling(terrainWorld, options.gridSize, MeshingMode::Naive, 16, options.seed));
+    ReportDirectionCulling("greedy", MeasureDirectionCulling(terrainWorld, options.gridSize, MeshingMode::Greedy, 16, options.seed));
+
+    // Wall faces left by meshing chunks before their neighbours, at render distance 8
+    for (MeshingMode mode : { MeshingMode::Naive, MeshingMode::Greedy })
+    {
+        BorderResult border = MeasureBorderRefresh(generator, 8, mode);
+        ReportBorderRefresh(mode == MeshingMode::Naive ? "naive" : "greedy", border);
+        matches = border.matchesFullRemesh && matches;
+    }
+
+    // Free-list fragmentation of the chunk geometry arena under remeshing and reloading
+    ReportArena(MeasureArena(terrainWorld, options.gridSize, 20000, options.seed));
+
+    // Triangles at a long render distance with and without downsampled distant chunks
+    if (options.lodDistance > 0)
+    {
+        ReportLod(options.lodDistance, MeasureLod(generator, options.lodDistance));
+    }
+
+    if (!matches)
+    {
+        return 1;
+    }
+
+    spdlog::info("Bitmask culling matches the per-face lookup for every mode; section meshes match whole chunks, "
+                 "are the same with scratch arenas, and border refreshes match full remeshes");
+    return 0;
+}
@@ -0,0 +1,359 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless chunk meshing throughput benchmark.
+// Meshes synthetic padded inputs (flat ground, generated terrain, a 3D checkerboard where every
+// solid block shows all six faces, and sparse random blocks) into section meshes exactly as the
+// ChunkManager workers do, with 1..hardware_concurrency threads and no window or GL context: meshes
+// are never built. Reports faces/sec, and per chunk the faces, the vertices the shader expands them
+// into, the bytes that would be uploaded and the heap allocations (including each new thread's
+// scratch arenas growing on its first jobs).
+// Every thread count must produce the same faces as the single-threaded run, or the run fails.
+
+#include "BenchmarkCommon.h"
+#include "World/ChunkMeshGenerator.h"
+#include "World/ChunkMeshInput.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include "Rendering/BlockTextureRegistry.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace MinecraftClone;
+
+// Every heap allocation in the process is counted, for the allocations-per-chunk report
+static std::atomic<size_t> g_allocationCount{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int chunks = 16;       // Inputs per scenario
+        int repeats = 4;       // Each input is meshed this many times per run
+        int maxThreads = 0;    // 0 = std::thread::hardware_concurrency()
+    };
+
+    using InputList = std::vector<std::unique_ptr<ChunkMeshInput>>;
+
+    struct RunResult
+    {
+        double seconds = 0.0;
+        size_t meshedChunks = 0;
+        size_t faces = 0;
+        size_t uploadBytes = 0;
+        size_t allocations = 0;
+        std::vector<uint64_t> faceHashes;  // Indexed by input, not by meshing order
+    };
+
+    // Vertices the shader expands each packed face into (two triangles, no index buffer)
+    constexpr size_t VERTICES_PER_FACE = 6;
+
+    uint64_t HashSections(const ChunkSectionMeshes& meshes)
+    {
+        // FNV-1a over the packed faces of every section and layer
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto& mesh : meshes.sections)
+        {
+            if (!mesh)
+            {
+                continue;
+            }
+            for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+            {
+                const std::vector<ChunkFace>& faces = mesh->GetFaces(static_cast<RenderLayer>(layer));
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(faces.data());
+                for (size_t i = 0; i < faces.size() * sizeof(ChunkFace); i++)
+                {
+                    hash ^= bytes[i];
+                    hash *= 1099511628211ull;
+                }
+            }
+        }
+        return hash;
+    }
+
+    // Bedrock, stone to y = 59, dirt to 63 and grass at 64, border included
+    void GenerateFlatInputs(InputList& inputs, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            auto input = std::make_unique<ChunkMeshInput>();
+            input->Clear();
+            for (int y = 0; y <= 64; y++)
+            {
+                BlockType type = (y == 0) ? BlockType::Bedrock
+                               : (y < 60) ? BlockType::Stone
+                               : (y < 64) ? BlockType::Dirt
+                               : BlockType::Grass;
+                for (int z = -1; z <= CHUNK_SIZE_Z; z++)
+                {
+                    for (int x = -1; x <= CHUNK_SIZE_X; x++)
+                    {
+                        input->Set(x, y, z, type);
+                    }
+                }
+            }
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    // Generated terrain assembled from a world one chunk larger on every side, so borders are real
+    void GenerateTerrainInputs(InputList& inputs, int count, int seed)
+    {
+        const int side = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+
+        TerrainGenerator generator;
+        generator.Initialize(seed);
+        World world;
+        Benchmark::GenerateTerrainSquare(world, generator, -1, side);
+
+        for (int i = 0; i < count; i++)
+        {
+            auto input = std::make_unique<ChunkMeshInput>();
+            input->Assemble(&world, i % side, i / side);
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    // Worst case: stone wherever x + y + z is even over the full height, so no face is ever culled
+    void GenerateCheckerboardInputs(InputList& inputs, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            auto input = std::make_unique<ChunkMeshInput>();
+            input->Clear();
+            for (int y = 0; y < CHUNK_SIZE_Y; y++)
+            {
+                for (int z = -1; z <= CHUNK_SIZE_Z; z++)
+                {
+                    for (int x = -1; x <= CHUNK_SIZE_X; x++)
+                    {
+                        if (((x + y + z) & 1) == 0)
+                        {
+                            input->Set(x, y, z, BlockType::Stone);
+                        }
+                    }
+                }
+            }
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    // About 2% of the blocks below y = 128 solid, mixed opaque and transparent, at random
+    void GenerateSparseInputs(InputList& inputs, int count, int seed)
+    {
+        const BlockType palette[] = { BlockType::Stone, BlockType::Dirt, BlockType::Glass, BlockType::Leaves };
+        std::mt19937 rng(static_cast<uint32_t>(seed));
+        std::uniform_int_distribution<int> chance(0, 49);
+        std::uniform_int_distribution<int> pick(0, static_cast<int>(sizeof(palette) / sizeof(palette[0])) - 1);
+
+        for (int i = 0; i < count; i++)
+        {
+            auto input = std::make_unique<ChunkMeshInput>();
+            input->Clear();
+            for (int y = 0; y < 128; y++)
+            {
+                for (int z = -1; z <= CHUNK_SIZE_Z; z++)
+                {
+                    for (int x = -1; x <= CHUNK_SIZE_X; x++)
+                    {
+                        if (chance(rng) == 0)
+                        {
+                            input->Set(x, y, z, palette[pick(rng)]);
+                        }
+                    }
+                }
+            }
+            inputs.push_back(std::move(input));
+        }
+    }
+
+    RunResult RunMeshing(const InputList& inputs, MeshingMode mode, int threadCount, int repeats)
+    {
+        const int inputCount = static_cast<int>(inputs.size());
+        const int jobCount = inputCount * repeats;
+
+        RunResult result;
+        result.faceHashes.resize(inputCount);
+
+        std::atomic<int> nextJob{0};
+        std::atomic<size_t> faces{0};
+        std::atomic<size_t> uploadBytes{0};
+        auto worker = [&]() {
+            size_t workerFaces = 0;
+            size_t workerBytes = 0;
+            while (true)
+            {
+                int job = nextJob.fetch_add(1);
+                if (job >= jobCount)
+                {
+                    break;
+                }
+
+                auto meshes = ChunkMeshGenerator::GenerateSectionMeshes(*inputs[job % inputCount], 0, 0,
+                                                                        ChunkMeshGenerator::ALL_SECTIONS, mode);
+                for (const auto& mesh : meshes.sections)
+                {
+                    if (mesh)
+                    {
+                        workerFaces += mesh->GetFaceCount();
+                        workerBytes += mesh->GetUploadSize();
+                    }
+                }
+                // Only the first repeat records the hash, so no two threads write the same entry
+                if (job < inputCount)
+                {
+                    result.faceHashes[job] = HashSections(meshes);
+                }
+            }
+            faces.fetch_add(workerFaces);
+            uploadBytes.fetch_add(workerBytes);
+        };
+
+        size_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        result.seconds = std::chrono::duration<double>(endTime - startTime).count();
+        result.allocations = g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        result.meshedChunks = static_cast<size_t>(jobCount);
+        result.faces = faces.load();
+        result.uploadBytes = uploadBytes.load();
+        return result;
+    }
+
+    void ReportRun(const char* label, const char* modeName, int threadCount, const RunResult& result)
+    {
+        double chunks = static_cast<double>(std::max<size_t>(1, result.meshedChunks));
+        spdlog::info("{:<12} {:<6} threads={:<3} Mfaces/sec={:>7.2f}  chunks/sec={:>8.1f}  faces/chunk={:>7.0f}  "
+                     "vertices/chunk={:>8.0f}  KiB/chunk={:>7.1f}  allocations/chunk={:>6.1f}",
+                     label, modeName, threadCount,
+                     static_cast<double>(result.faces) / result.seconds / 1e6,
+                     chunks / result.seconds,
+                     static_cast<double>(result.faces) / chunks,
+                     static_cast<double>(result.faces * VERTICES_PER_FACE) / chunks,
+                     static_cast<double>(result.uploadBytes) / chunks / 1024.0,
+                     static_cast<double>(result.allocations) / chunks);
+    }
+
+    // Every thread count against the single-threaded run; false if any produced different faces
+    bool RunScenario(const char* label, const InputList& inputs, int maxThreads, int repeats)
+    {
+        bool deterministic = true;
+        for (MeshingMode mode : { MeshingMode::Naive, MeshingMode::Greedy })
+        {
+            const char* modeName = (mode == MeshingMode::Naive) ? "naive" : "greedy";
+            std::vector<uint64_t> reference;
+            for (int threadCount = 1; threadCount <= maxThreads; threadCount++)
+            {
+                RunResult run = RunMeshing(inputs, mode, threadCount, repeats);
+                ReportRun(label, modeName, threadCount, run);
+                if (threadCount == 1)
+                {
+                    reference = run.faceHashes;
+                }
+                else if (run.faceHashes != reference)
+                {
+                    spdlog::error("{} {}: {} threads produced different faces than one", label, modeName, threadCount);
+                    deterministic = false;
+                }
+            }
+        }
+        return deterministic;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--seed", "S", &options.seed },
+            { "--chunks", "N", &options.chunks, 1 },
+            { "--repeats", "R", &options.repeats, 1 },
+            { "--threads", "T", &options.maxThreads, 1 }
+        }))
+    {
+        return 2;
+    }
+
+    int maxThreads = options.maxThreads;
+    if (maxThreads <= 0)
+    {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Keep registry / generator setup logs out of the report
+    spdlog::set_level(spdlog::level::warn);
+    BlockRegistry::Initialize();
+    BlockTextureRegistry::Initialize();
+
+    InputList flat;
+    InputList terrain;
+    InputList checkerboard;
+    InputList sparse;
+    GenerateFlatInputs(flat, options.chunks);
+    GenerateTerrainInputs(terrain, options.chunks, options.seed);
+    GenerateCheckerboardInputs(checkerboard, options.chunks);
+    GenerateSparseInputs(sparse, options.chunks, options.seed);
+    spdlog::set_level(spdlog::level::info);
+
+    spdlog::info("Mesh throughput benchmark: {} chunks per scenario, each meshed {} times, up to {} threads, seed {}",
+                 options.chunks, options.repeats, maxThreads, options.seed);
+
+    bool deterministic = RunScenario("flat", flat, maxThreads, options.repeats);
+    deterministic = RunScenario("terrain", terrain, maxThreads, options.repeats) && deterministic;
+    deterministic = RunScenario("checkerboard", checkerboard, maxThreads, options.repeats) && deterministic;
+    deterministic = RunScenario("sparse", sparse, maxThreads, options.repeats) && deterministic;
+
+    if (!deterministic)
+    {
+        return 1;
+    }
+
+    spdlog::info("Every thread count produced the same faces as the single-threaded run");
+    return 0;
+}
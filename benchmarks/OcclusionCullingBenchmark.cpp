@@ -0,0 +1,454 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless software occlusion culling benchmark.
+// First checks OcclusionCuller on hand-placed boxes (hidden behind a wall, in front of it, beside it,
+// under ground that crosses the near plane, a camera inside an occluder) and that every thread count
+// rasterizes the same depth buffer. Then generates terrain, meshes it as the renderer does, and for a
+// camera standing in the lowest spot near the centre (hills around it) turning on the spot, counts
+// the sections and faces that pass the frustum with and without the occlusion test, and the cost of
+// rasterizing and testing per frame with 1..N threads. Every section the test hides is checked by
+// casting rays from the camera to its exposed faces: a face a ray reaches means a wrong cull and
+// fails the run.
+
+#include "BenchmarkCommon.h"
+#include "World/ChunkMeshGenerator.h"
+#include "World/SectionVisibility.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include "Rendering/BlockTextureRegistry.h"
+#include "Rendering/Frustum.h"
+#include "Rendering/OcclusionCuller.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int renderDistance = 8;  // Chunks in every direction from the centre chunk
+        int views = 8;           // Camera headings
+        int frames = 50;         // Timed frames per heading and thread count
+        int maxThreads = 0;      // 0 = std::thread::hardware_concurrency()
+    };
+
+    const glm::mat4 PROJECTION = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    glm::mat4 LookFrom(const glm::vec3& eye, float yaw, float pitch)
+    {
+        const glm::vec3 forward(std::cos(yaw) * std::cos(pitch), std::sin(pitch), std::sin(yaw) * std::cos(pitch));
+        return PROJECTION * glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    bool Expect(const char* label, bool visible, bool expected)
+    {
+        if (visible != expected)
+        {
+            spdlog::error("{}: box should be {}", label, expected ? "visible" : "hidden");
+        }
+        return visible == expected;
+    }
+
+    bool CheckBoxes()
+    {
+        OcclusionCuller culler;
+        culler.Initialize(OcclusionCuller::DEFAULT_WIDTH, OcclusionCuller::DEFAULT_HEIGHT, 1);
+        bool passed = true;
+
+        // Looking down -Z at a 10 x 40 wall 20 to 30 blocks away
+        const glm::vec3 eye(0.0f, 10.0f, 0.0f);
+        culler.BeginFrame(LookFrom(eye, -glm::half_pi<float>(), 0.0f), eye);
+        culler.AddOccluder(glm::vec3(-5.0f, 0.0f, -30.0f), glm::vec3(5.0f, 40.0f, -20.0f));
+        culler.Rasterize();
+        passed = Expect("behind wall", culler.IsVisible(glm::vec3(-2.0f, 5.0f, -60.0f), glm::vec3(2.0f, 9.0f, -56.0f)), false) && passed;
+        passed = Expect("in front of wall", culler.IsVisible(glm::vec3(-2.0f, 5.0f, -15.0f), glm::vec3(2.0f, 9.0f, -11.0f)), true) && passed;
+        passed = Expect("beside wall", culler.IsVisible(glm::vec3(20.0f, 5.0f, -62.0f), glm::vec3(24.0f, 9.0f, -58.0f)), true) && passed;
+        passed = Expect("partly beside wall", culler.IsVisible(glm::vec3(10.0f, 5.0f, -42.0f), glm::vec3(14.0f, 9.0f, -38.0f)), true) && passed;
+        // Just past the wall's edge: only the one-pixel ring keeps it
+        passed = Expect("past the edge", culler.IsVisible(glm::vec3(5.2f, 5.0f, -21.0f), glm::vec3(5.6f, 9.0f, -20.6f)), true) && passed;
+
+        // Ground reaching behind the camera (clipped to the near plane) hides what is under it
+        const glm::vec3 standing(0.0f, 12.0f, 0.0f);
+        culler.BeginFrame(LookFrom(standing, -glm::half_pi<float>(), -0.3f), standing);
+        culler.AddOccluder(glm::vec3(-100.0f, 0.0f, -100.0f), glm::vec3(100.0f, 10.0f, 100.0f));
+        culler.Rasterize();
+        passed = Expect("under ground", culler.IsVisible(glm::vec3(-2.0f, -20.0f, -30.0f), glm::vec3(2.0f, -16.0f, -26.0f)), false) && passed;
+        passed = Expect("on ground", culler.IsVisible(glm::vec3(-2.0f, 10.0f, -30.0f), glm::vec3(2.0f, 14.0f, -26.0f)), true) && passed;
+
+        // A camera inside an occluder sees none of its faces
+        culler.BeginFrame(LookFrom(standing, -glm::half_pi<float>(), 0.0f), standing);
+        culler.AddOccluder(glm::vec3(-8.0f, 0.0f, -8.0f), glm::vec3(8.0f, 20.0f, 8.0f));
+        culler.Rasterize();
+        passed = Expect("camera inside", culler.IsVisible(glm::vec3(-2.0f, 5.0f, -40.0f), glm::vec3(2.0f, 9.0f, -36.0f)), true) && passed;
+        return passed;
+    }
+
+    // OcclusionCuller's input as ChunkRenderer builds it
+    struct SceneChunk
+    {
+        int chunkX;
+        int chunkZ;
+        ChunkSectionMeshes meshes;
+    };
+
+    void AddOccluders(OcclusionCuller& culler, const Frustum& frustum, const std::vector<SceneChunk>& chunks)
+    {
+        std::vector<OccluderBox> boxes;
+        for (const SceneChunk& chunk : chunks)
+        {
+            const glm::vec3 chunkMin(static_cast<float>(chunk.chunkX * CHUNK_SIZE_X), 0.0f, static_cast<float>(chunk.chunkZ * CHUNK_SIZE_Z));
+            if (frustum.IsAABBVisible(chunkMin, chunkMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z)))
+            {
+                GetChunkOccluders(chunk.chunkX, chunk.chunkZ, chunk.meshes.visibility.data(), boxes);
+            }
+        }
+        for (const OccluderBox& box : boxes)
+        {
+            culler.AddOccluder(box.min, box.max);
+        }
+    }
+
+    // Straight from the chunk, rounding negative coordinates down
+    BlockType GetBlockType(World& world, int x, int y, int z)
+    {
+        const int chunkX = (x < 0) ? (x + 1) / CHUNK_SIZE_X - 1 : x / CHUNK_SIZE_X;
+        const int chunkZ = (z < 0) ? (z + 1) / CHUNK_SIZE_Z - 1 : z / CHUNK_SIZE_Z;
+        const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
+        return chunk ? chunk->GetBlock(x - chunkX * CHUNK_SIZE_X, y, z - chunkZ * CHUNK_SIZE_Z).GetType() : BlockType::Air;
+    }
+
+    bool IsOpaque(World& world, const glm::ivec3& position)
+    {
+        if (position.y < 0 || position.y >= CHUNK_SIZE_Y)
+        {
+            return false;
+        }
+        const BlockType type = GetBlockType(world, position.x, position.y, position.z);
+        return BlockRegistry::IsOccluder(type);
+    }
+
+    // Exact voxel walk: false when an opaque block lies between from and to
+    bool HasLineOfSight(World& world, const glm::vec3& from, const glm::vec3& to)
+    {
+        const glm::vec3 delta = to - from;
+        glm::ivec3 voxel = glm::ivec3(glm::floor(from));
+        const glm::ivec3 target = glm::ivec3(glm::floor(to));
+        glm::ivec3 step(0);
+        glm::vec3 tMax(FLT_MAX);
+        glm::vec3 tDelta(FLT_MAX);
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (delta[axis] != 0.0f)
+            {
+                step[axis] = delta[axis] > 0.0f ? 1 : -1;
+                const float boundary = static_cast<float>(voxel[axis] + (step[axis] > 0 ? 1 : 0));
+                tMax[axis] = (boundary - from[axis]) / delta[axis];
+                tDelta[axis] = static_cast<float>(step[axis]) / delta[axis];
+            }
+        }
+
+        while (voxel != target)
+        {
+            int axis = (tMax.x < tMax.y) ? (tMax.x < tMax.z ? 0 : 2) : (tMax.y < tMax.z ? 1 : 2);
+            if (tMax[axis] > 1.0f)
+            {
+                break;
+            }
+            voxel[axis] += step[axis];
+            tMax[axis] += tDelta[axis];
+            if (IsOpaque(world, voxel))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether any exposed face of the section, facing the camera and on screen, can be seen from eye
+    bool IsSectionSeen(World& world, const glm::mat4& viewProjection, const glm::vec3& eye, int chunkX, int section, int chunkZ)
+    {
+        static const glm::ivec3 NORMALS[6] = { { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 } };
+        const glm::ivec3 origin(chunkX * CHUNK_SIZE_X, section * CHUNK_SECTION_SIZE, chunkZ * CHUNK_SIZE_Z);
+        for (int y = 0; y < CHUNK_SECTION_SIZE; y++)
+        {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
+                {
+                    const glm::ivec3 block = origin + glm::ivec3(x, y, z);
+                    if (!IsOpaque(world, block))
+                    {
+                        continue;
+                    }
+                    for (const glm::ivec3& normal : NORMALS)
+                    {
+                        const glm::vec3 faceCentre = glm::vec3(block) + glm::vec3(0.5f) + glm::vec3(normal) * 0.51f;
+                        if (IsOpaque(world, block + normal) || glm::dot(eye - faceCentre, glm::vec3(normal)) <= 0.0f)
+                        {
+                            continue;
+                        }
+                        const glm::vec4 clip = viewProjection * glm::vec4(faceCentre, 1.0f);
+                        if (clip.w <= 0.0f || std::abs(clip.x) > clip.w || std::abs(clip.y) > clip.w)
+                        {
+                            continue;
+                        }
+                        if (HasLineOfSight(world, eye, faceCentre))
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    struct SceneResult
+    {
+        size_t frustumSections = 0;
+        size_t frustumFaces = 0;
+        size_t drawnSections = 0;
+        size_t drawnFaces = 0;
+        size_t occluders = 0;
+        size_t triangles = 0;
+        double rasterizeMs = 0.0;
+        double testMs = 0.0;
+        size_t wrongCulls = 0;
+    };
+
+    SceneResult MeasureScene(World& world, const std::vector<SceneChunk>& chunks, const glm::vec3& eye, int views, int frames,
+                             int threads, bool verify)
+    {
+        OcclusionCuller culler;
+        culler.Initialize(OcclusionCuller::DEFAULT_WIDTH, OcclusionCuller::DEFAULT_HEIGHT, threads);
+        Frustum frustum;
+        SceneResult result;
+
+        for (int view = 0; view < views; view++)
+        {
+            const float yaw = glm::two_pi<float>() * static_cast<float>(view) / static_cast<float>(views);
+            const glm::mat4 viewProjection = LookFrom(eye, yaw, 0.05f);
+            frustum.ExtractPlanes(viewProjection);
+
+            for (int frame = 0; frame < frames; frame++)
+            {
+                const bool counted = (frame == 0);
+                culler.BeginFrame(viewProjection, eye);
+                AddOccluders(culler, frustum, chunks);
+                culler.Rasterize();
+                result.rasterizeMs += culler.GetStats().rasterizeMs;
+
+                auto testStart = std::chrono::steady_clock::now();
+                for (const SceneChunk& chunk : chunks)
+                {
+                    for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+                    {
+                        const ChunkMesh* mesh = chunk.meshes.sections[section].get();
+                        if (!mesh || mesh->IsEmpty())
+                        {
+                            continue;
+                        }
+                        const glm::vec3 sectionMin(static_cast<float>(chunk.chunkX * CHUNK_SIZE_X),
+                                                   static_cast<float>(section * CHUNK_SECTION_SIZE),
+                                                   static_cast<float>(chunk.chunkZ * CHUNK_SIZE_Z));
+                        const glm::vec3 sectionMax = sectionMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z);
+                        if (!frustum.IsAABBVisible(sectionMin, sectionMax))
+                        {
+                            continue;
+                        }
+                        const bool visible = culler.IsVisible(sectionMin, sectionMax);
+                        if (!counted)
+                        {
+                            continue;
+                        }
+                        result.frustumSections++;
+                        result.frustumFaces += mesh->GetFaceCount();
+                        if (visible)
+                        {
+                            result.drawnSections++;
+                            result.drawnFaces += mesh->GetFaceCount();
+                        }
+                        else if (verify && IsSectionSeen(world, viewProjection, eye, chunk.chunkX, section, chunk.chunkZ))
+                        {
+                            spdlog::error("Heading {}: section ({}, {}, {}) was culled but a face of it is in sight",
+                                          view, chunk.chunkX, section, chunk.chunkZ);
+                            result.wrongCulls++;
+                        }
+                    }
+                }
+                if (counted)
+                {
+                    result.occluders += culler.GetStats().occluders;
+                    result.triangles += culler.GetStats().triangles;
+                }
+                else
+                {
+                    result.testMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - testStart).count();
+                }
+            }
+        }
+
+        const double timedFrames = static_cast<double>(views) * static_cast<double>(std::max(1, frames - 1));
+        result.rasterizeMs /= static_cast<double>(views * frames);
+        result.testMs /= timedFrames;
+        return result;
+    }
+
+    // Depth buffers of the same frame with 1 and threads threads must match exactly
+    bool CheckThreadsMatch(const std::vector<SceneChunk>& chunks, const glm::vec3& eye, int threads)
+    {
+        OcclusionCuller reference;
+        OcclusionCuller threaded;
+        reference.Initialize(OcclusionCuller::DEFAULT_WIDTH, OcclusionCuller::DEFAULT_HEIGHT, 1);
+        threaded.Initialize(OcclusionCuller::DEFAULT_WIDTH, OcclusionCuller::DEFAULT_HEIGHT, threads);
+        const glm::mat4 viewProjection = LookFrom(eye, 0.7f, 0.05f);
+        Frustum frustum;
+        frustum.ExtractPlanes(viewProjection);
+        for (OcclusionCuller* culler : { &reference, &threaded })
+        {
+            culler->BeginFrame(viewProjection, eye);
+            AddOccluders(*culler, frustum, chunks);
+            culler->Rasterize();
+        }
+        const size_t pixels = static_cast<size_t>(reference.GetWidth()) * static_cast<size_t>(reference.GetHeight());
+        if (std::memcmp(reference.GetDepth(), threaded.GetDepth(), pixels * sizeof(float)) != 0)
+        {
+            spdlog::error("{} threads rasterized a different depth buffer than one", threads);
+            return false;
+        }
+        return true;
+    }
+
+    double Percent(size_t part, size_t whole)
+    {
+        return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--seed", "S", &options.seed },
+            { "--distance", "R", &options.renderDistance, 1 },
+            { "--views", "N", &options.views, 1 },
+            { "--frames", "F", &options.frames, 2 },
+            { "--threads", "T", &options.maxThreads, 1 }
+        }))
+    {
+        return 2;
+    }
+    if (options.maxThreads == 0)
+    {
+        options.maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    TerrainGenerator generator;
+    Benchmark::InitializeTerrain(generator, options.seed);
+    BlockTextureRegistry::Initialize();
+
+    if (!CheckBoxes())
+    {
+        return 1;
+    }
+
+    // One extra ring so every meshed chunk has its neighbours
+    const int distance = options.renderDistance;
+    World world;
+    Benchmark::GenerateTerrainSquare(world, generator, -distance - 1, distance + 1);
+
+    std::vector<SceneChunk> chunks;
+    size_t opaqueLayers = 0;
+    for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+    {
+        for (int chunkX = -distance; chunkX <= distance; chunkX++)
+        {
+            SceneChunk chunk{ chunkX, chunkZ, ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ,
+                                                                                       &world, ChunkMeshGenerator::ALL_SECTIONS,
+                                                                                       MeshingMode::Greedy) };
+            for (const SectionVisibility& visibility : chunk.meshes.visibility)
+            {
+                opaqueLayers += std::bitset<CHUNK_SECTION_SIZE>(visibility.GetOpaqueLayers()).count();
+            }
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+    // Stand in the lowest spot of the centre 3x3 chunks, so the surrounding hills hide what is behind them
+    glm::ivec2 lowest(8, 8);
+    int lowestSurface = CHUNK_SIZE_Y;
+    for (int z = -CHUNK_SIZE_Z; z < 2 * CHUNK_SIZE_Z; z++)
+    {
+        for (int x = -CHUNK_SIZE_X; x < 2 * CHUNK_SIZE_X; x++)
+        {
+            int surface = CHUNK_SIZE_Y - 1;
+            while (surface > 0 && GetBlockType(world, x, surface, z) == BlockType::Air)
+            {
+                surface--;
+            }
+            if (surface < lowestSurface)
+            {
+                lowestSurface = surface;
+                lowest = glm::ivec2(x, z);
+            }
+        }
+    }
+    const glm::vec3 eye(static_cast<float>(lowest.x) + 0.5f, static_cast<float>(lowestSurface) + 2.6f, static_cast<float>(lowest.y) + 0.5f);
+
+    if (!CheckThreadsMatch(chunks, eye, options.maxThreads))
+    {
+        return 1;
+    }
+    spdlog::set_level(spdlog::level::info);
+    spdlog::info("Occlusion culler checks passed");
+
+    spdlog::info("Occlusion culling benchmark: render distance {} ({} chunks, {:.1f} opaque layers per chunk), {}x{} depth, "
+                 "camera at ({:.1f}, {:.1f}, {:.1f}), {} headings",
+                 distance, chunks.size(), static_cast<double>(opaqueLayers) / static_cast<double>(chunks.size()),
+                 OcclusionCuller::DEFAULT_WIDTH, OcclusionCuller::DEFAULT_HEIGHT, eye.x, eye.y, eye.z, options.views);
+
+    bool correct = true;
+    for (int threads = 1; threads <= options.maxThreads; threads *= 2)
+    {
+        const SceneResult result = MeasureScene(world, chunks, eye, options.views, options.frames, threads, threads == 1);
+        if (threads == 1)
+        {
+            spdlog::info("  frustum only: {} sections, {} faces per heading", result.frustumSections / options.views,
+                         result.frustumFaces / options.views);
+            spdlog::info("  occlusion:    {} sections, {} faces per heading ({:.1f}% of sections and {:.1f}% of faces culled; "
+                         "{} occluders, {} triangles)",
+                         result.drawnSections / options.views, result.drawnFaces / options.views,
+                         100.0 - Percent(result.drawnSections, result.frustumSections),
+                         100.0 - Percent(result.drawnFaces, result.frustumFaces),
+                         result.occluders / options.views, result.triangles / options.views);
+            if (result.wrongCulls > 0)
+            {
+                spdlog::error("  {} culled sections had a face in sight", result.wrongCulls);
+                correct = false;
+            }
+            else
+            {
+                spdlog::info("  every culled section checked by ray casts: none in sight");
+            }
+        }
+        spdlog::info("  {} thread{}: {:.3f} ms rasterizing + {:.3f} ms testing per frame", threads, threads == 1 ? " " : "s",
+                     result.rasterizeMs, result.testMs);
+    }
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless terrain generation benchmark and determinism check.
+// Generates an N x N grid of chunks with 1..hardware_concurrency worker threads (no window, no GL
+// context), reports throughput and per-chunk latency, and hashes every chunk so that any dependence
+// on thread count or generation order fails the run with a non-zero exit code.
+// The fill stage (heightmap -> blocks) is also timed on its own for the vectorized and the
+// scalar path, and both must produce identical chunks.
+
+#include "BenchmarkCommon.h"
+#include "World/TerrainGenerator.h"
+#include "World/Chunk.h"
+#include "World/BlockType.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int gridSize = 16;     // Chunks per side
+        int seed = 12345;
+        int maxThreads = 0;    // 0 = std::thread::hardware_concurrency()
+    };
+
+    struct RunResult
+    {
+        double seconds = 0.0;
+        std::vector<double> latenciesMs;
+        std::vector<uint64_t> chunkHashes;  // Indexed by grid position, not by generation order
+    };
+
+    uint64_t HashChunk(const Chunk& chunk)
+    {
+        // FNV-1a over every block's type and light values
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](uint8_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+
+        for (int y = 0; y < CHUNK_SIZE_Y; y++)
+        {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
+                {
+                    const Block& block = chunk.GetBlock(x, y, z);
+                    mix(static_cast<uint8_t>(block.GetType()));
+                    mix(block.GetLightLevel());
+                    mix(block.GetSkyLight());
+                }
+            }
+        }
+        return hash;
+    }
+
+    double Percentile(std::vector<double> values, double percentile)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1) + 0.5);
+        return values[std::min(index, values.size() - 1)];
+    }
+
+    RunResult RunGeneration(TerrainGenerator& generator, const BenchmarkOptions& options, int threadCount, uint32_t orderSeed)
+    {
+        const int gridSize = options.gridSize;
+        const int chunkCount = gridSize * gridSize;
+        const int gridOffset = gridSize / 2;
+
+        // Allocate chunks up front so allocation is not part of the measured time
+        std::vector<std::unique_ptr<Chunk>> chunks(chunkCount);
+        for (int i = 0; i < chunkCount; i++)
+        {
+            chunks[i] = std::make_unique<Chunk>(i % gridSize - gridOffset, i / gridSize - gridOffset);
+        }
+
+        // Generation order: row-major for the reference run, shuffled otherwise
+        std::vector<int> order(chunkCount);
+        for (int i = 0; i < chunkCount; i++)
+        {
+            order[i] = i;
+        }
+        if (orderSeed != 0)
+        {
+            std::mt19937 rng(orderSeed);
+            std::shuffle(order.begin(), order.end(), rng);
+        }
+
+        RunResult result;
+        result.latenciesMs.resize(chunkCount);
+
+        std::atomic<int> nextTask{0};
+        auto worker = [&]() {
+            while (true)
+            {
+                int task = nextTask.fetch_add(1);
+                if (task >= chunkCount)
+                {
+                    break;
+                }
+
+                int index = order[task];
+                Chunk* chunk = chunks[index].get();
+
+                auto chunkStart = std::chrono::high_resolution_clock::now();
+                generator.GenerateChunk(chunk, chunk->GetChunkX(), chunk->GetChunkZ(), nullptr);
+                auto chunkEnd = std::chrono::high_resolution_clock::now();
+
+                result.latenciesMs[index] = std::chrono::duration<double, std::milli>(chunkEnd - chunkStart).count();
+            }
+        };
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        result.seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+        result.chunkHashes.resize(chunkCount);
+        for (int i = 0; i < chunkCount; i++)
+        {
+            result.chunkHashes[i] = HashChunk(*chunks[i]);
+        }
+
+        return result;
+    }
+
+    struct FillResult
+    {
+        double bestSeconds = 0.0;
+        std::vector<uint64_t> chunkHashes;
+    };
+
+    // Time only TerrainGenerator::FillChunk over pre-generated heightmaps (best of `rounds`)
+    FillResult RunFill(TerrainGenerator& generator, const std::vector<std::vector<int>>& heightmaps, int rounds)
+    {
+        const int chunkCount = static_cast<int>(heightmaps.size());
+
+        FillResult result;
+        std::vector<std::unique_ptr<Chunk>> chunks(chunkCount);
+        for (int round = 0; round < rounds; round++)
+        {
+            // Fresh (all air) chunks every round, allocated outside the measured time
+            for (int i = 0; i < chunkCount; i++)
+            {
+                chunks[i] = std::make_unique<Chunk>();
+            }
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < chunkCount; i++)
+            {
+                generator.FillChunk(chunks[i].get(), heightmaps[i].data());
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            double seconds = std::chrono::duration<double>(endTime - startTime).count();
+            if (round == 0 || seconds < result.bestSeconds)
+            {
+                result.bestSeconds = seconds;
+            }
+        }
+
+        result.chunkHashes.resize(chunkCount);
+        for (int i = 0; i < chunkCount; i++)
+        {
+            result.chunkHashes[i] = HashChunk(*chunks[i]);
+        }
+        return result;
+    }
+
+    void ReportFill(const char* label, int chunkCount, const FillResult& result)
+    {
+        spdlog::info("{:<12} chunks/sec={:>10.1f}  per chunk={:>8.2f} us",
+                     label,
+                     static_cast<double>(chunkCount) / result.bestSeconds,
+                     result.bestSeconds * 1e6 / static_cast<double>(chunkCount));
+    }
+
+    void ReportRun(const char* label, int threadCount, int chunkCount, const RunResult& result)
+    {
+        spdlog::info("{:<12} threads={:<3} chunks/sec={:>10.1f}  p50={:>7.3f} ms  p99={:>7.3f} ms  total={:>8.3f} s",
+                     label, threadCount,
+                     static_cast<double>(chunkCount) / result.seconds,
+                     Percentile(result.latenciesMs, 0.50),
+                     Percentile(result.latenciesMs, 0.99),
+                     result.seconds);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!Benchmark::ParseArguments(argc, argv, {
+            { "--grid", "N", &options.gridSize, 1 },
+            { "--seed", "S", &options.seed },
+            { "--threads", "T", &options.maxThreads, 1 }
+        }))
+    {
+        return 2;
+    }
+
+    int maxThreads = options.maxThreads;
+    if (maxThreads <= 0)
+    {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    TerrainGenerator generator;
+    Benchmark::InitializeTerrain(generator, options.seed);
+
+    const int chunkCount = options.gridSize * options.gridSize;
+    spdlog::info("Terrain benchmark: {}x{} chunks, seed {}, up to {} threads",
+                 options.gridSize, options.gridSize, options.seed, maxThreads);
+
+    // Reference: single thread, row-major order
+    RunResult reference = RunGeneration(generator, options, 1, 0);
+    ReportRun("reference", 1, chunkCount, reference);
+
+    bool deterministic = true;
+    for (int threadCount = 1; threadCount <= maxThreads; threadCount++)
+    {
+        RunResult run = RunGeneration(generator, options, threadCount, static_cast<uint32_t>(threadCount));
+        ReportRun("shuffled", threadCount, chunkCount, run);
+
+        for (int i = 0; i < chunkCount; i++)
+        {
+            if (run.chunkHashes[i] != reference.chunkHashes[i])
+            {
+                spdlog::error("Determinism failure: chunk ({}, {}) hash {:016x} != reference {:016x} with {} threads",
+                              i % options.gridSize - options.gridSize / 2, i / options.gridSize - options.gridSize / 2,
+                              run.chunkHashes[i], reference.chunkHashes[i], threadCount);
+                deterministic = false;
+                break;
+            }
+        }
+    }
+
+    // Full generation with the original scalar fill, single thread, for comparison
+    generator.SetVectorizedFill(false);
+    RunResult scalarRun = RunGeneration(generator, options, 1, 0);
+    generator.SetVectorizedFill(true);
+    ReportRun("scalar fill", 1, chunkCount, scalarRun);
+
+    // Fill stage only, on the same heightmaps
+    constexpr int HEIGHTMAP_SIZE = CHUNK_SIZE_X + 1;
+    std::vector<std::vector<int>> heightmaps(chunkCount, std::vector<int>(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE));
+    for (int i = 0; i < chunkCount; i++)
+    {
+        int chunkX = i % options.gridSize - options.gridSize / 2;
+        int chunkZ = i / options.gridSize - options.gridSize / 2;
+        generator.GenerateHeightmap(chunkX * CHUNK_SIZE_X, chunkZ * CHUNK_SIZE_Z, HEIGHTMAP_SIZE, 1, heightmaps[i].data());
+    }
+
+    constexpr int FILL_ROUNDS = 5;
+    generator.SetVectorizedFill(false);
+    FillResult scalarFill = RunFill(generator, heightmaps, FILL_ROUNDS);
+    generator.SetVectorizedFill(true);
+    FillResult vectorFill = RunFill(generator, heightmaps, FILL_ROUNDS);
+    ReportFill("fill scalar", chunkCount, scalarFill);
+    ReportFill("fill vector", chunkCount, vectorFill);
+    spdlog::info("Fill speedup: {:.2f}x", scalarFill.bestSeconds / vectorFill.bestSeconds);
+
+    for (int i = 0; i < chunkCount; i++)
+    {
+        if (scalarRun.chunkHashes[i] != reference.chunkHashes[i] || scalarFill.chunkHashes[i] != vectorFill.chunkHashes[i])
+        {
+            spdlog::error("Fill mismatch: chunk ({}, {}) differs between scalar and vectorized fill",
+                          i % options.gridSize - options.gridSize / 2, i / options.gridSize - options.gridSize / 2);
+            deterministic = false;
+            break;
+        }
+    }
+
+    if (!deterministic)
+    {
+        return 1;
+    }
+
+    spdlog::info("All {} chunk hashes match the reference run", chunkCount);
+    return 0;
+}
@@ -73,12 +73,15 @@ namespace MinecraftClone
         // Rendering
         std::unique_ptr<class TestCube> m_testCube;
         std::unique_ptr<class ChunkRenderer> m_chunkRenderer;
+        std::unique_ptr<class HorizonRenderer> m_horizonRenderer;
         std::unique_ptr<RemotePlayerRenderer> m_remotePlayerRenderer;
 
         // World
         std::unique_ptr<class World> m_world;
         std::unique_ptr<class TerrainGenerator> m_terrainGenerator;
         std::unique_ptr<class ChunkManager> m_chunkManager;
+        std::unique_ptr<class WorldStorage> m_worldStorage;
+        std::unique_ptr<class BlockTickScheduler> m_blockTickScheduler;
         std::unique_ptr<class BlockInteraction> m_blockInteraction;
         std::unique_ptr<class NetworkManager> m_networkManager;
 
@@ -16,11 +16,14 @@
 #include <unordered_map>
 #include <bitset>
 #include <queue>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace MinecraftClone
 {
     class ChunkRenderer; // forward declaration
+    class ChunkManager;
+    class BlockTickScheduler;
 
     // Connection configuration
     struct GameConnectionConfig : public yojimbo::ClientServerConfig
@@ -78,15 +81,25 @@ namespace MinecraftClone
         void SendPlayerPosition(const glm::vec3& position, float yaw, float pitch);
         void SendBlockUpdate(int x, int y, int z, BlockType type, bool isPlacement);
 
+        // Server: blocks changed by block ticks, for every client that has their chunk. Queued per
+        // client and sent a few hundred per frame with the type the block has when it goes out, so a
+        // block that changes again while waiting is sent once
+        void BroadcastTickedBlocks(const std::vector<glm::ivec3>& blocks);
+
         // Getters
         bool IsServer() const { return m_isServer; }
         uint32_t GetLocalPlayerId() const { return m_localPlayerId; }
+        // False while connected or connecting to a server: block ticks then run only on the host,
+        // and this world mirrors the results through block updates
+        bool HasWorldAuthority() const { return m_isServer || (!IsConnected() && !IsConnecting()); }
 
         const std::unordered_map<uint32_t, RemotePlayer>& GetRemotePlayers() const { return m_remotePlayers; }
 
         // World / Renderer wiring
         void SetWorld(World* world) { m_world = world; }
         void SetChunkRenderer(ChunkRenderer* renderer) { m_chunkRenderer = renderer; }
+        void SetChunkManager(ChunkManager* manager) { m_chunkManager = manager; }  // Remeshes on worker threads
+        void SetBlockTickScheduler(BlockTickScheduler* scheduler) { m_blockTickScheduler = scheduler; }  // Remote edits wake neighbours
 
         // Server: Send chunks to clients
         void SendChunkToClient(int clientIndex, int chunkX, int chunkZ);
@@ -97,6 +110,7 @@ namespace MinecraftClone
         void UpdateServer(double time, float deltaTime);
         void ProcessServerMessages();
         void ProcessChunkQueue(int clientIndex);
+        void ProcessBlockUpdateQueue(int clientIndex);
         void BroadcastPlayerPosition(uint32_t playerId, const glm::vec3& position, float yaw, float pitch);
         void OnClientConnected(int clientIndex);
 
@@ -127,6 +141,14 @@ namespace MinecraftClone
         };
         std::unordered_map<int, std::queue<PendingChunkSlice>> m_clientChunkQueue;  // Queue of slices to send per client
 
+        // Block tick results waiting to be sent, per client
+        struct PendingBlockUpdates
+        {
+            std::queue<glm::ivec3> blocks;
+            std::unordered_set<uint64_t> queued;  // Keys of the positions in blocks
+        };
+        std::unordered_map<int, PendingBlockUpdates> m_clientBlockQueue;
+
         // Client
         std::unique_ptr<yojimbo::Client> m_client;
         std::unordered_map<uint32_t, RemotePlayer> m_remotePlayers;  // Client-side view of other players
@@ -139,6 +161,8 @@ namespace MinecraftClone
         // Non-owning pointers into game state
         World* m_world = nullptr;
         ChunkRenderer* m_chunkRenderer = nullptr;
+        ChunkManager* m_chunkManager = nullptr;
+        BlockTickScheduler* m_blockTickScheduler = nullptr;
     };
 }
 
@@ -42,6 +42,11 @@ namespace MinecraftClone
         // Texture atlas support
         static AtlasUV GetAtlasUV(BlockType type, BlockFace face);
         static int GetAtlasIndex(BlockType type, BlockFace face);
+        // The face's layer in the block texture array (Texture::LoadArrayFromGrid of the atlas)
+        static int GetTextureLayer(BlockType type, BlockFace face) { return GetAtlasIndex(type, face); }
+
+        // Atlas is 4x4 grid (16 texture slots)
+        static constexpr int ATLAS_SIZE = 4;
 
     private:
         static void RegisterTexture(BlockType type, BlockFace face, const std::string& path);
@@ -53,8 +58,6 @@ namespace MinecraftClone
 
         static uint32_t MakeKey(BlockType type, BlockFace face);
         
-        // Atlas is 4x4 grid (16 texture slots)
-        static constexpr int ATLAS_SIZE = 4;
         static constexpr float TILE_SIZE = 1.0f / ATLAS_SIZE;
     };
 }
@@ -0,0 +1,117 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef CHUNKGEOMETRYARENA_H
+#define CHUNKGEOMETRYARENA_H
+
+#pragma once
+
+#include "Rendering/ChunkMesh.h"
+#include <glad/gl.h>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace MinecraftClone
+{
+    // Offset / size allocator over a fixed range of units: best fit, and a freed range merges with
+    // the free ranges on either side. CPU-only (no GL), so it can be exercised headless.
+    class FreeListAllocator
+    {
+    public:
+        static constexpr uint32_t INVALID_OFFSET = UINT32_MAX;
+
+        struct Stats
+        {
+            uint32_t capacity = 0;
+            uint32_t used = 0;
+            uint32_t freeBlocks = 0;
+            uint32_t largestFreeBlock = 0;
+            size_t allocations = 0;        // Live allocations
+            size_t failedAllocations = 0;  // Since the last Reset
+
+            // Share of the free space outside the largest free block: 0 = one contiguous hole
+            float GetFragmentation() const
+            {
+                const uint32_t freeUnits = capacity - used;
+                return freeUnits == 0 ? 0.0f : 1.0f - static_cast<float>(largestFreeBlock) / static_cast<float>(freeUnits);
+            }
+        };
+
+        explicit FreeListAllocator(uint32_t capacity = 0) { Reset(capacity); }
+
+        void Reset(uint32_t capacity);  // One free block spanning the whole range
+        uint32_t Allocate(uint32_t size);  // INVALID_OFFSET if no free block is large enough
+        void Free(uint32_t offset, uint32_t size);  // size must be the size it was allocated with
+        Stats GetStats() const;
+
+    private:
+        void InsertFree(uint32_t offset, uint32_t size);
+        void EraseFree(std::map<uint32_t, uint32_t>::iterator block);
+
+        std::map<uint32_t, uint32_t> m_freeByOffset;       // Offset -> size
+        std::multimap<uint32_t, uint32_t> m_freeBySize;    // Size -> offset, for best fit
+        uint32_t m_capacity = 0;
+        uint32_t m_used = 0;
+        size_t m_allocations = 0;
+        size_t m_failedAllocations = 0;
+    };
+
+    // One persistently mapped buffer holding the packed faces of every arena-built ChunkMesh, viewed
+    // as a single buffer texture, so meshes are sub-ranges drawn together with one indirect
+    // multi-draw per layer instead of one buffer and one draw each. Meshes write straight into the
+    // mapping; a freed range is only handed out again once the frames that could still read it have
+    // completed on the GPU. Requires OpenGL 4.4 (immutable buffer storage).
+    class ChunkGeometryArena
+    {
+    public:
+        ChunkGeometryArena();
+        ~ChunkGeometryArena();
+
+        // False (and the arena stays unused) without OpenGL 4.4 or if the buffer cannot be created;
+        // capacity is clamped to the largest buffer texture the driver allows
+        bool Initialize(uint32_t capacityFaces);
+        void Shutdown();
+        bool IsInitialized() const { return m_mapped != nullptr; }
+
+        // Reserve faceCount faces; FreeListAllocator::INVALID_OFFSET when the arena is full
+        uint32_t Allocate(uint32_t faceCount);
+        // Mapped storage of an allocation (write-only, coherent: no flush needed)
+        ChunkFace* GetFaces(uint32_t offset) { return m_mapped + offset; }
+        void Free(uint32_t offset, uint32_t faceCount);  // Reused after the current frame completes
+
+        // Fence the frame just submitted and reclaim ranges whose frames have completed
+        void EndFrame();
+
+        // Buffer texture over the whole arena (RG32UI), sampled as "faces" by the chunk shader
+        GLuint GetFaceTexture() const { return m_faceTexture; }
+        // Attribute-less VAO for drawing a single arena mesh (ChunkMesh::Render)
+        GLuint GetVertexArray() const { return m_VAO; }
+        FreeListAllocator::Stats GetStats() const { return m_allocator.GetStats(); }
+
+    private:
+        using Range = std::pair<uint32_t, uint32_t>;  // Offset, face count
+
+        struct RetiredRanges
+        {
+            GLsync fence;
+            std::vector<Range> ranges;
+        };
+
+        void ReclaimCompleted();
+
+        FreeListAllocator m_allocator;
+        std::vector<Range> m_pendingFrees;      // Freed during the current frame
+        std::deque<RetiredRanges> m_retired;    // Freed during earlier frames still in flight, oldest first
+
+        GLuint m_buffer;
+        GLuint m_faceTexture;
+        GLuint m_VAO;
+        ChunkFace* m_mapped;
+    };
+}
+
+#endif
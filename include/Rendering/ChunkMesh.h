@@ -7,50 +7,172 @@
 
 #pragma once
 
+#include "World/BlockType.h"
 #include <glad/gl.h>
 #include <glm/glm.hpp>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace MinecraftClone
 {
-    class Shader;
+    class ChunkGeometryArena;
 
+    // One quad as stored and uploaded: the vertex shader expands it into its six vertices
+    // placement: x (bits 0-3), z (4-7), y (8-15) of the quad's origin block relative to the mesh origin,
+    //            face direction (16-18), width - 1 (19-22), height - 1 (23-30)
+    // material:  texture layer (bits 0-15), corner ambient occlusion (16-23, see ChunkMesh::AO_OPEN)
+    struct ChunkFace
+    {
+        uint32_t placement;
+        uint32_t material;
+    };
+
+    // A fully expanded vertex, as the vertex shader outputs it (CPU reference and tooling only)
     struct Vertex
     {
         glm::vec3 position;
         glm::vec2 texCoord;
         glm::vec3 normal;
+        uint32_t tile;       // Block texture array layer (bits 0-15); texCoord is in block units and repeats it.
+                             // Bits 16-17: ambient occlusion level, 0 = fully occluded .. 3 = open
+    };
+
+    // The chunk shaders' per-frame uniform block "FrameData" (std140), uploaded once per frame
+    struct FrameData
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 lightPosition;   // xyz
+        glm::vec4 lightColor;      // rgb
+        glm::vec4 viewPosition;    // xyz, the camera
+    };
+
+    // glMultiDrawArraysIndirect record (layout fixed by OpenGL)
+    struct DrawArraysIndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint first;
+        GLuint baseInstance;
     };
 
     class ChunkMesh
     {
     public:
+        // Per-corner ambient occlusion of a quad, 2 bits per corner in (u, v) order
+        // (0, 0), (width, 0), (width, height), (0, height), u / v being AddQuad's width / height axes
+        static constexpr uint8_t AO_OPEN = 0xFF;
+        static constexpr int AO_SHIFT = 16;
+
+        // Largest quad extents a ChunkFace can hold
+        static constexpr int MAX_QUAD_WIDTH = 16;
+        static constexpr int MAX_QUAD_HEIGHT = 256;
+
+        // Texture unit the face buffer is bound to while drawing (the shader's "faces" sampler)
+        static constexpr int FACE_TEXTURE_UNIT = 1;
+        // Vertex attribute holding the mesh origin: a constant value for Render, and per indirect
+        // draw (an instanced attribute indexed by baseInstance) for batched arena meshes
+        static constexpr GLuint ORIGIN_ATTRIBUTE = 0;
+        // Uniform buffer binding point of the FrameData block
+        static constexpr GLuint FRAME_DATA_BINDING = 0;
+
+        // Face direction bits (1 << faceIndex) for Render's direction mask
+        static constexpr int DIRECTION_COUNT = 6;
+        static constexpr uint8_t ALL_DIRECTIONS = (1u << DIRECTION_COUNT) - 1;
+
+        // Directions whose faces can be front-facing to a camera at cameraPosition when every face lies
+        // inside [boxMin, boxMax]: +X faces only if the camera is past boxMin.x, and so on
+        static uint8_t GetFacingDirections(const glm::vec3& cameraPosition, const glm::vec3& boxMin, const glm::vec3& boxMax);
+
         ChunkMesh();
         ~ChunkMesh();
 
-        void Clear();
-        void AddFace(const glm::vec3& position, const glm::vec2& texCoord0, const glm::vec2& texCoord1,
-            const glm::vec2& texCoord2, const glm::vec2& texCoord3, const glm::vec3& normal, int faceIndex);
-        void AddQuad(const glm::vec3& position, float width, float height, const glm::vec3& normal, int faceIndex);
-        void Build();
-        void Render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Shader* shader);
+        // Vertex shader that expands ChunkFaces; outputs FragPos, TexCoord, Normal, AO and Tile
+        static const char* GetVertexShaderSource();
+        // Point a linked program's FrameData block at FRAME_DATA_BINDING (again after every relink)
+        static void BindFrameData(GLuint program);
+
+        void Clear();  // Keeps the capacity, so a reused mesh stops allocating once it has grown
+        void Reserve(size_t quadCount);
+        // Replace this mesh's faces and origin with a right-sized copy of source's (one allocation per non-empty layer)
+        void CopyGeometry(const ChunkMesh& source);
+
+        // World position face coordinates are relative to (the chunk's corner)
+        void SetOrigin(const glm::ivec3& origin) { m_origin = origin; }
+        const glm::ivec3& GetOrigin() const { return m_origin; }
+        // World-space box around every face (only meaningful while not empty)
+        glm::vec3 GetBoundsMin() const { return glm::vec3(m_origin + m_boundsMin); }
+        glm::vec3 GetBoundsMax() const { return glm::vec3(m_origin + m_boundsMax); }
+
+        // x, y, z: block relative to the origin; width / height along the face's u / v axes
+        void AddFace(int x, int y, int z, int faceIndex, uint32_t tile, uint8_t ao = AO_OPEN,
+                     RenderLayer layer = RenderLayer::Opaque);
+        void AddQuad(int x, int y, int z, int width, int height, int faceIndex, uint32_t tile,
+                     uint8_t ao = AO_OPEN, RenderLayer layer = RenderLayer::Opaque);
+        // Upload the faces into the arena when one is given and has room, else into a buffer of this mesh's own
+        void Build(ChunkGeometryArena* arena = nullptr);
+        // Draw one layer; the shader must be in use with FrameData bound and "faces" on FACE_TEXTURE_UNIT.
+        // Only the directions in the mask are drawn, except in the translucent layer (kept back-to-front
+        // instead of grouped by direction). Returns the number of faces drawn.
+        size_t Render(RenderLayer layer = RenderLayer::Opaque, uint8_t directions = ALL_DIRECTIONS);
+        // The same ranges as indirect draws into the arena (IsInArena() meshes only), each reading its
+        // origin from instanced attribute entry drawIndex. Returns the number of faces they draw.
+        size_t AppendDraws(RenderLayer layer, uint8_t directions, GLuint drawIndex,
+                           std::vector<DrawArraysIndirectCommand>& commands) const;
         void Shutdown();
 
-        bool IsEmpty() const { return m_vertices.empty(); }
-        size_t GetVertexCount() const { return m_vertices.size(); }
-        size_t GetIndexCount() const { return m_indices.size(); }
+        // Reorder the translucent quads back-to-front as seen from cameraPosition (re-uploads them if built)
+        void SortTranslucent(const glm::vec3& cameraPosition);
+
+        // The vertices the shader produces, six per face in draw order (layer by layer), for the same mask as Render
+        void ExpandVertices(std::vector<Vertex>& vertices, uint8_t directions = ALL_DIRECTIONS) const;
+
+        bool IsEmpty() const { return GetFaceCount() == 0; }
+        bool IsInArena() const { return m_arena != nullptr; }
+        bool HasLayer(RenderLayer layer) const { return !m_faces[static_cast<size_t>(layer)].empty(); }
+        size_t GetFaceCount() const;
+        size_t GetFaceCount(RenderLayer layer, uint8_t directions) const;  // Faces Render would draw
+        size_t GetDirectionFaceCount(RenderLayer layer, int faceIndex) const
+        {
+            return m_directionCounts[static_cast<size_t>(layer)][faceIndex];
+        }
+        const std::vector<ChunkFace>& GetFaces(RenderLayer layer) const { return m_faces[static_cast<size_t>(layer)]; }
+        size_t GetUploadSize() const { return GetFaceCount() * sizeof(ChunkFace); }
 
     private:
-        std::vector<Vertex> m_vertices;
-        std::vector<unsigned int> m_indices;
+        static constexpr size_t LAYER_COUNT = static_cast<size_t>(RenderLayer::Count);
+
+        // Stable-sort a layer's faces by direction (only needed when they were not added in that order)
+        void GroupByDirection(size_t layer);
+        // Vertex ranges Render draws for one layer, relative to this mesh's first face; adjacent ranges merged
+        GLsizei GetDrawRanges(size_t layer, uint8_t directions, GLint firsts[DIRECTION_COUNT], GLsizei counts[DIRECTION_COUNT],
+                              size_t& faceCount) const;
+        void CopyFacesTo(ChunkFace* destination);  // Layers back to back, recording m_layerOffsets
+        bool IsDrawnByDirection(size_t layer) const
+        {
+            return m_isGrouped[layer] && layer != static_cast<size_t>(RenderLayer::Translucent);
+        }
+
+        std::vector<ChunkFace> m_faces[LAYER_COUNT];  // One face list per render layer
+        uint32_t m_directionCounts[LAYER_COUNT][DIRECTION_COUNT];
+        bool m_isGrouped[LAYER_COUNT];                // Faces are in direction order: one contiguous range per direction
+        size_t m_layerOffsets[LAYER_COUNT];           // First face of each layer in the uploaded buffer
+        glm::ivec3 m_origin;
+        glm::ivec3 m_boundsMin;  // Block corners relative to the origin, grown by every face added
+        glm::ivec3 m_boundsMax;
+
+        GLuint m_VAO;            // Empty: vertices are pulled from the face buffer by gl_VertexID
+        GLuint m_faceBuffer;
+        GLuint m_faceTexture;    // Buffer texture view of m_faceBuffer (RG32UI)
 
-        GLuint m_VAO;
-        GLuint m_VBO;
-        GLuint m_EBO;
+        // Arena-built meshes own no GL objects: their faces are [m_arenaOffset, + m_arenaFaceCount) of the arena
+        ChunkGeometryArena* m_arena;
+        uint32_t m_arenaOffset;
+        uint32_t m_arenaFaceCount;
 
         bool m_isBuilt;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -8,9 +8,31 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
 
 namespace MinecraftClone
 {
+    // Boxes stored as one array per coordinate (structure of arrays), so Frustum::CullAABBs can load
+    // the same coordinate of several boxes at once
+    class AABBArray
+    {
+    public:
+        void Clear();
+        void Reserve(size_t count);
+        void Add(const glm::vec3& min, const glm::vec3& max);
+
+        size_t Size() const { return m_minX.size(); }
+        glm::vec3 GetMin(size_t index) const { return glm::vec3(m_minX[index], m_minY[index], m_minZ[index]); }
+        glm::vec3 GetMax(size_t index) const { return glm::vec3(m_maxX[index], m_maxY[index], m_maxZ[index]); }
+
+    private:
+        friend class Frustum;
+
+        std::vector<float> m_minX, m_minY, m_minZ;
+        std::vector<float> m_maxX, m_maxY, m_maxZ;
+    };
+
     class Frustum
     {
     public:
@@ -24,6 +46,10 @@ namespace MinecraftClone
         // Returns true if the AABB is at least partially inside the frustum
         bool IsAABBVisible(const glm::vec3& min, const glm::vec3& max) const;
 
+        // The same test for every box of the array: appends the indices of the visible ones, in
+        // order, to visibleIndices
+        void CullAABBs(const AABBArray& boxes, std::vector<uint32_t>& visibleIndices) const;
+
     private:
         // Frustum planes: left, right, bottom, top, near, far
         // Each plane is represented as: normal.x, normal.y, normal.z, distance
@@ -0,0 +1,105 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MinecraftClone
+{
+    struct OcclusionStats
+    {
+        size_t occluders = 0;     // Boxes added this frame
+        size_t triangles = 0;     // Back-face triangles rasterized (after near-plane clipping)
+        size_t tests = 0;         // IsVisible calls this frame
+        size_t culled = 0;        // ... that returned false
+        double rasterizeMs = 0.0; // Wall time of Rasterize
+    };
+
+    // Low-resolution depth buffer rasterized on the CPU from occluder boxes, for rejecting boxes
+    // hidden behind them before anything is submitted to the GPU. Occluders must be solid and the
+    // buffer never claims more than they hide: a pixel is written only when a box covers all of it,
+    // with the depth of the box's back faces at their farthest within the pixel. A tested box counts
+    // as hidden only when every pixel its screen rectangle touches (widened to whole 4-pixel groups)
+    // holds something nearer than its nearest corner. Depth is stored as 1/w (clip w is view
+    // distance), which interpolates linearly across the screen. Rows are rasterized in 8-row tiles
+    // shared out between the calling thread and persistent workers, 4 pixels at a time with SSE2
+    // where available.
+    class OcclusionCuller
+    {
+    public:
+        static constexpr int DEFAULT_WIDTH = 256;
+        static constexpr int DEFAULT_HEIGHT = 128;
+        static constexpr int TILE_ROWS = 8;
+
+        OcclusionCuller();
+        ~OcclusionCuller();
+
+        // width must be a multiple of 4; threadCount 0 = hardware_concurrency(), the calling thread always takes part
+        void Initialize(int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT, int threadCount = 0);
+        void Shutdown();
+
+        // Clear the buffer and start a frame; cameraPosition selects each occluder's back faces
+        void BeginFrame(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+        void AddOccluder(const glm::vec3& boxMin, const glm::vec3& boxMax);  // Queued until Rasterize; ignored around the camera
+        void Rasterize();
+        // False when the box is hidden behind rasterized occluders; boxes crossing the near plane are visible
+        bool IsVisible(const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+        const OcclusionStats& GetStats() const { return m_stats; }
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        int GetThreadCount() const { return static_cast<int>(m_workerThreads.size()) + 1; }
+        const float* GetDepth() const { return m_depth.data(); }  // 1/w, row-major, bottom row first; 0 = empty
+
+    private:
+        // A screen-space triangle: inside where all three edge functions are >= 0 at a pixel centre
+        struct Triangle
+        {
+            float edgeA[3];
+            float edgeB[3];
+            float edgeC[3];
+            int minX, maxX, minY, maxY;  // Pixel bounds, clamped to the buffer
+            float depthA, depthB, depthC;  // 1/w at (x, y) = A x + B y + C, already lowered to the pixel's farthest
+            float minDepth;                // 1/w of the box's farthest corner
+        };
+
+        // Clip-space quad, clipped to the near plane and split into triangles; outline[i] marks edge i
+        // (corner i to i + 1) as part of the box's outline; farthest is 1/w of the box's farthest corner
+        void AddFace(const glm::vec4 corners[4], const bool outline[4], float farthest);
+        void AddTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const bool outline[3], float farthest);  // Pixel x, y and 1/w
+        void RasterizeTiles();                       // Take tiles until none are left
+        void RasterizeTile(int tile);
+        void WorkerThreadFunction();
+
+        int m_width;
+        int m_height;
+        std::vector<float> m_depth;
+        std::vector<Triangle> m_triangles;
+        glm::mat4 m_viewProjection;
+        glm::vec3 m_cameraPosition;
+        OcclusionStats m_stats;
+
+        // Persistent workers for Rasterize
+        std::vector<std::thread> m_workerThreads;
+        std::mutex m_jobMutex;
+        std::condition_variable m_jobCondition;
+        std::condition_variable m_jobDoneCondition;
+        std::atomic<int> m_nextTile;
+        uint64_t m_jobGeneration;
+        int m_workersBusy;
+        bool m_shouldStopWorkers;
+    };
+}
+
+#endif
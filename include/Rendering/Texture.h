@@ -19,20 +19,26 @@ namespace MinecraftClone
         ~Texture();
 
         bool LoadFromFile(const std::string& filepath);
+        // Load an image made of a columns x rows grid of equal tiles as a GL_TEXTURE_2D_ARRAY with one
+        // layer per tile, numbered left to right from the top row, each with its own mip chain
+        bool LoadArrayFromGrid(const std::string& filepath, int columns, int rows);
         void Bind(GLuint textureUnit = 0) const;
         void Unbind() const;
 
         GLuint GetID() const { return m_textureID; }
         int GetWidth() const { return m_width; }
         int GetHeight() const { return m_height; }
+        int GetLayerCount() const { return m_layers; }  // 0 for a 2D texture
 
         void Shutdown();
 
     private:
         GLuint m_textureID;
+        GLenum m_target;  // GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
         int m_width;
         int m_height;
         int m_channels;
+        int m_layers;
     };
 }
 
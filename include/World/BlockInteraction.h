@@ -18,6 +18,7 @@ namespace MinecraftClone
 {
     class NetworkManager;  // Forward declaration
     class PhysicsManager;  // Forward declaration
+    class BlockTickScheduler;  // Forward declaration
 
     class BlockInteraction
     {
@@ -28,6 +29,7 @@ namespace MinecraftClone
         void Initialize(World* world, ChunkRenderer* chunkRenderer, ChunkManager* chunkManager);
         void SetNetworkManager(NetworkManager* networkManager) { m_networkManager = networkManager; }
         void SetPhysicsManager(PhysicsManager* physicsManager) { m_physicsManager = physicsManager; }
+        void SetBlockTickScheduler(BlockTickScheduler* scheduler) { m_blockTickScheduler = scheduler; }
         void Update(Camera* camera, float reachDistance = 5.0f);
 
         // Block interaction
@@ -49,6 +51,7 @@ namespace MinecraftClone
         ChunkManager* m_chunkManager;
         NetworkManager* m_networkManager;
         PhysicsManager* m_physicsManager;
+        BlockTickScheduler* m_blockTickScheduler;
 
         RaycastResult m_lastRaycastResult;
         BlockType m_selectedBlockType;
@@ -0,0 +1,161 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef BLOCKTICKSCHEDULER_H
+#define BLOCKTICKSCHEDULER_H
+
+#pragma once
+
+#include "World/World.h"
+#include "World/BlockType.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace MinecraftClone
+{
+    struct BlockTickStats
+    {
+        double lastTickMs = 0.0;        // Wall time of the most recent game tick
+        size_t processedLastTick = 0;   // Scheduled ticks executed in the most recent game tick
+        size_t regionsLastTick = 0;     // Chunks that had due ticks in the most recent game tick
+    };
+
+    // Fixed-rate world simulation (falling sand/gravel, flowing water).
+    // Nothing is scanned: a block only runs when a tick was scheduled for it, either by an edit
+    // next to it (NotifyBlockChanged) or by a previous tick. Each chunk keeps per-section sets of
+    // scheduled blocks (for de-duplication and counting) and a priority queue ordered by game tick.
+    // A block update reads and writes at most one block away, so chunks are processed in 9 phases
+    // ((x mod 3, z mod 3) colouring) and chunks in the same phase run in parallel: their 3x3
+    // neighbourhoods never overlap. Results do not depend on the thread count.
+    //
+    // Chunk workers (ChunkManager) may be meshing a chunk while a phase writes to it. That is the
+    // same exposure as a block edit on the main thread, and safe for the same reasons: the mesher
+    // copies the blocks once (ChunkMeshInput) and each copy is one byte per block, so it sees every
+    // block either before or after the tick; and every written block is reported by
+    // TakeChangedBlocks for a remesh that starts only after any mesh already running on that chunk,
+    // so the last mesh always has the new blocks. Terrain a worker is still generating is different
+    // (it would overwrite the tick's writes), so those chunks are left out (SetTerrainPending).
+    class BlockTickScheduler
+    {
+    public:
+        static constexpr int TICKS_PER_SECOND = 20;
+        static constexpr int MAX_TICKS_PER_UPDATE = 5;  // Catch-up limit after a long frame
+        static constexpr int FALL_DELAY = 2;            // Ticks between sand/gravel fall steps
+        static constexpr int WATER_DELAY = 5;           // Ticks between water spread steps
+        static constexpr int MAX_WATER_LEVEL = 7;       // Flowing water stops spreading past this level
+
+        BlockTickScheduler();
+        ~BlockTickScheduler();
+
+        // threadCount 0 = hardware_concurrency(); the calling thread always takes part
+        void Initialize(World* world, int threadCount = 0);
+        void Shutdown();
+
+        // Run as many fixed-rate ticks as deltaTime covers (independent of frame rate)
+        void Update(float deltaTime);
+        void Tick();  // Run exactly one game tick
+
+        void ScheduleTick(int worldX, int worldY, int worldZ, int delayTicks);
+        void NotifyBlockChanged(int worldX, int worldY, int worldZ);  // Wake the block and its 6 neighbours
+        void UnloadChunk(int chunkX, int chunkZ);
+        // While set, the chunk's own ticks wait and neighbouring regions see it as an unloaded wall
+        void SetTerrainPending(int chunkX, int chunkZ, bool pending);
+
+        // World positions of the blocks changed since the last call, for per-block remeshing
+        // (ChunkManager::RequestBlockRemesh works out the sections and neighbours each one touches)
+        void TakeChangedBlocks(std::vector<glm::ivec3>& changedBlocks);
+        // Chunks where a block became or stopped being solid since the last call (for collision);
+        // water flowing through air never shows up here
+        void TakeCollisionChangedChunks(std::vector<std::pair<int, int>>& collisionChunks);
+
+        uint64_t GetCurrentTick() const { return m_currentTick; }
+        size_t GetActiveBlockCount() const;
+        size_t GetActiveChunkCount() const;
+        const BlockTickStats& GetStats() const { return m_stats; }
+
+    private:
+        struct ScheduledTick
+        {
+            uint64_t tick;
+            uint32_t sequence;  // FIFO order among ticks due in the same game tick
+            int index;          // Chunk-local block index (y * 256 + z * 16 + x)
+
+            bool operator>(const ScheduledTick& other) const
+            {
+                return tick != other.tick ? tick > other.tick : sequence > other.sequence;
+            }
+        };
+
+        struct ChunkTickState
+        {
+            std::array<std::unordered_set<uint16_t>, CHUNK_SECTION_COUNT> scheduled;  // Section-local indices
+            std::priority_queue<ScheduledTick, std::vector<ScheduledTick>, std::greater<ScheduledTick>> queue;
+            std::unordered_map<int, uint8_t> waterLevels;  // Flowing water only; sources have no entry
+            uint32_t nextSequence = 0;
+        };
+
+        // A chunk with due ticks plus its 3x3 neighbourhood, resolved on the main thread
+        struct TickRegion
+        {
+            int chunkX = 0;
+            int chunkZ = 0;
+            Chunk* chunks[3][3] = {};
+            ChunkTickState* states[3][3] = {};
+            std::vector<glm::ivec3> changedBlocks;  // World positions
+            std::vector<std::pair<int, int>> collisionChunks;
+            size_t processed = 0;
+        };
+
+        void ProcessRegion(TickRegion& region);
+        void UpdateBlock(TickRegion& region, int x, int y, int z);
+
+        // Region-local access; x and z may be one block outside the centre chunk
+        BlockType GetType(TickRegion& region, int x, int y, int z) const;
+        void SetType(TickRegion& region, int x, int y, int z, BlockType type);
+        uint8_t GetWaterLevel(TickRegion& region, int x, int y, int z) const;
+        void SetWaterLevel(TickRegion& region, int x, int y, int z, uint8_t level);
+        void ScheduleInRegion(TickRegion& region, int x, int y, int z);
+        void NotifyNeighboursInRegion(TickRegion& region, int x, int y, int z);
+
+        static bool IsTickable(BlockType type);
+        static int GetTickDelay(BlockType type);
+        static void Schedule(ChunkTickState& state, int index, uint64_t tick);
+
+        void RunPhase(std::vector<TickRegion>& regions);
+        void WorkerThreadFunction();
+
+        World* m_world;
+        std::unordered_map<std::pair<int, int>, ChunkTickState, ChunkCoordHash> m_states;
+        std::vector<glm::ivec3> m_changedBlocks;
+        std::unordered_set<std::pair<int, int>, ChunkCoordHash> m_collisionChunks;
+        std::unordered_set<std::pair<int, int>, ChunkCoordHash> m_terrainPending;
+
+        uint64_t m_currentTick;
+        float m_accumulator;
+        BlockTickStats m_stats;
+        bool m_initialized;
+
+        // Persistent workers for parallel phases
+        std::vector<std::thread> m_workerThreads;
+        std::mutex m_jobMutex;
+        std::condition_variable m_jobCondition;
+        std::condition_variable m_jobDoneCondition;
+        std::vector<TickRegion>* m_jobRegions;
+        std::atomic<size_t> m_nextRegion;
+        uint64_t m_jobGeneration;
+        int m_workersBusy;
+        bool m_shouldStopWorkers;
+    };
+}
+
+#endif
@@ -30,6 +30,15 @@ namespace MinecraftClone
         Count  // Keep this last for iteration
     };
 
+    // Mesh bucket of a block's faces, drawn in this order
+    enum class RenderLayer : uint8_t
+    {
+        Opaque = 0,    // Depth-tested and written, front-to-back
+        Cutout,        // Alpha-tested (holes are discarded), otherwise like opaque
+        Translucent,   // Alpha-blended back-to-front, no depth writes
+        Count
+    };
+
     struct BlockProperties
     {
         bool isSolid;
@@ -38,6 +47,7 @@ namespace MinecraftClone
         bool isOpaque;
         float hardness;  // Time to break (0 = unbreakable)
         float resistance; // Blast resistance
+        RenderLayer renderLayer;
     };
 
     class BlockRegistry
@@ -49,11 +59,30 @@ namespace MinecraftClone
         static bool IsTransparent(BlockType type);
         static bool IsLiquid(BlockType type);
         static bool IsOpaque(BlockType type);
+        static bool IsOccluder(BlockType type);  // Hides a neighbour's face and blocks line of sight: not air, not transparent
+        static RenderLayer GetRenderLayer(BlockType type);
 
     private:
         static BlockProperties s_properties[static_cast<std::size_t>(BlockType::Count)];
         static bool s_initialized;
     };
+
+    // BlockRegistry::IsOccluder as a table indexed by the block byte, for per-block loops (mesher,
+    // section visibility); build it after BlockRegistry::Initialize
+    struct OccluderTable
+    {
+        bool occludes[256] = {};
+
+        OccluderTable()
+        {
+            for (size_t type = 0; type < static_cast<size_t>(BlockType::Count); type++)
+            {
+                occludes[type] = BlockRegistry::IsOccluder(static_cast<BlockType>(type));
+            }
+        }
+
+        bool operator()(BlockType type) const { return occludes[static_cast<uint8_t>(type)]; }
+    };
 }
 
 #endif
\ No newline at end of file
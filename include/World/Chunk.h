@@ -20,6 +20,11 @@ namespace MinecraftClone
     constexpr int CHUNK_SIZE_Z = 16;
     constexpr int CHUNK_VOLUME = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
 
+    // Vertical 16x16x16 sections (contiguous in block storage)
+    constexpr int CHUNK_SECTION_SIZE = 16;
+    constexpr int CHUNK_SECTION_COUNT = CHUNK_SIZE_Y / CHUNK_SECTION_SIZE;
+    constexpr int CHUNK_SECTION_VOLUME = CHUNK_SIZE_X * CHUNK_SECTION_SIZE * CHUNK_SIZE_Z;
+
     class Chunk
     {
     public:
@@ -44,6 +49,17 @@ namespace MinecraftClone
         // Check if coordinates are valid within chunk
         static bool IsValidPosition(int x, int y, int z);
 
+        // Raw block storage, y-major (y * 256 + z * 16 + x), for bulk serialization
+        Block* GetBlockData() { return m_blocks.data(); }
+        const Block* GetBlockData() const { return m_blocks.data(); }
+
+        // Bulk-set the block types of one section from a dense y-major buffer of CHUNK_SECTION_VOLUME types
+        void SetSectionTypes(int sectionY, const BlockType* types);
+        void FillSection(int sectionY, BlockType type);
+
+        // Fill sky light top-down per column (15 until the first opaque block, -1 per transparent block)
+        void CalculateSkyLight();
+
         // Chunk state
         bool IsEmpty() const;
         bool NeedsMeshUpdate() const { return m_needsMeshUpdate; }
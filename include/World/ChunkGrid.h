@@ -0,0 +1,298 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef CHUNKGRID_H
+#define CHUNKGRID_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace MinecraftClone
+{
+    // One T per chunk column within a square window around a centre chunk (Chebyshev radius), kept
+    // in a toroidal array: a chunk's slot is its coordinates modulo the side, so moving the window
+    // only clears the slots of the chunks that left it and lookups are two masks, no hashing.
+    // The side is the power of two above 2 * radius + 1, so no two chunks in the window share a slot.
+    template <typename T>
+    class ChunkGrid
+    {
+    public:
+        explicit ChunkGrid(int radius = 0) { SetWindow(0, 0, radius); }
+
+        // Centre the window on (centerX, centerZ) with the given radius. Chunks left outside go to
+        // onEvict(chunkX, chunkZ, T&) and are then cleared; a new radius reallocates the slots (so
+        // pointers to values are only stable while the radius stays the same).
+        template <typename Evict>
+        void SetWindow(int centerX, int centerZ, int radius, Evict&& onEvict);
+        void SetWindow(int centerX, int centerZ, int radius)
+        {
+            SetWindow(centerX, centerZ, radius, [](int, int, T&) {});
+        }
+
+        int GetCenterX() const { return m_centerX; }
+        int GetCenterZ() const { return m_centerZ; }
+        int GetRadius() const { return m_radius; }
+        bool IsInWindow(int chunkX, int chunkZ) const
+        {
+            return chunkX >= m_centerX - m_radius && chunkX <= m_centerX + m_radius &&
+                   chunkZ >= m_centerZ - m_radius && chunkZ <= m_centerZ + m_radius;
+        }
+
+        T* Find(int chunkX, int chunkZ)
+        {
+            return const_cast<T*>(static_cast<const ChunkGrid*>(this)->Find(chunkX, chunkZ));
+        }
+        const T* Find(int chunkX, int chunkZ) const
+        {
+            const Slot& slot = m_slots[Index(chunkX, chunkZ)];
+            return (slot.occupied && slot.chunkX == chunkX && slot.chunkZ == chunkZ) ? &slot.value : nullptr;
+        }
+
+        // The chunk's value, default-constructed if it has none; null outside the window
+        T* Insert(int chunkX, int chunkZ);
+        bool Erase(int chunkX, int chunkZ);
+        void Clear();
+        size_t Size() const { return m_size; }
+        bool IsEmpty() const { return m_size == 0; }
+
+        // fn(chunkX, chunkZ, T&) for every chunk, row by row through the window
+        template <typename Function>
+        void ForEach(Function&& fn);
+        template <typename Function>
+        void ForEach(Function&& fn) const;
+
+        // fn(chunkX, chunkZ, T&) for every chunk in square rings outward from the centre (nearest
+        // first by Chebyshev distance); fn returns false to stop
+        template <typename Function>
+        void ForEachNearestFirst(Function&& fn);
+
+        // fn(chunkX, chunkZ) for every coordinate within radius of the centre, in square rings
+        // outward from it; fn returns false to stop
+        template <typename Function>
+        static void ForEachInRings(int centerX, int centerZ, int radius, Function&& fn);
+
+    private:
+        struct Slot
+        {
+            int chunkX = 0;
+            int chunkZ = 0;
+            bool occupied = false;
+            T value{};
+        };
+
+        size_t Index(int chunkX, int chunkZ) const
+        {
+            return (static_cast<size_t>(static_cast<uint32_t>(chunkZ) & m_mask) << m_shift) |
+                   (static_cast<uint32_t>(chunkX) & m_mask);
+        }
+
+        std::vector<Slot> m_slots;
+        uint32_t m_mask = 0;  // Side - 1
+        uint32_t m_shift = 0;  // log2(side)
+        int m_centerX = 0;
+        int m_centerZ = 0;
+        int m_radius = -1;
+        size_t m_size = 0;
+    };
+
+    template <typename T>
+    template <typename Evict>
+    void ChunkGrid<T>::SetWindow(int centerX, int centerZ, int radius, Evict&& onEvict)
+    {
+        radius = radius < 0 ? 0 : radius;
+        if (radius != m_radius)
+        {
+            // New storage: keep what stays in the new window, evict the rest
+            uint32_t shift = 0;
+            while ((1u << shift) < static_cast<uint32_t>(2 * radius + 1))
+            {
+                shift++;
+            }
+            std::vector<Slot> oldSlots(static_cast<size_t>(1) << (2 * shift));
+            oldSlots.swap(m_slots);
+            m_mask = (1u << shift) - 1u;
+            m_shift = shift;
+            m_centerX = centerX;
+            m_centerZ = centerZ;
+            m_radius = radius;
+            m_size = 0;
+            for (Slot& old : oldSlots)
+            {
+                if (!old.occupied)
+                {
+                    continue;
+                }
+                if (IsInWindow(old.chunkX, old.chunkZ))
+                {
+                    Slot& slot = m_slots[Index(old.chunkX, old.chunkZ)];
+                    slot.chunkX = old.chunkX;
+                    slot.chunkZ = old.chunkZ;
+                    slot.occupied = true;
+                    slot.value = std::move(old.value);
+                    m_size++;
+                }
+                else
+                {
+                    onEvict(old.chunkX, old.chunkZ, old.value);
+                }
+            }
+            return;
+        }
+
+        // Same storage: only the rows and columns of the old window outside the new one can hold
+        // chunks to evict
+        const int oldCenterX = m_centerX;
+        const int oldCenterZ = m_centerZ;
+        m_centerX = centerX;
+        m_centerZ = centerZ;
+        for (int chunkZ = oldCenterZ - radius; chunkZ <= oldCenterZ + radius; chunkZ++)
+        {
+            const bool rowLeft = chunkZ < centerZ - radius || chunkZ > centerZ + radius;
+            for (int chunkX = oldCenterX - radius; chunkX <= oldCenterX + radius; chunkX++)
+            {
+                if (!rowLeft && chunkX >= centerX - radius && chunkX <= centerX + radius)
+                {
+                    chunkX = centerX + radius;  // Skip the part of the row still in the window
+                    continue;
+                }
+                Slot& slot = m_slots[Index(chunkX, chunkZ)];
+                if (slot.occupied && slot.chunkX == chunkX && slot.chunkZ == chunkZ)
+                {
+                    onEvict(chunkX, chunkZ, slot.value);
+                    slot.value = T{};
+                    slot.occupied = false;
+                    m_size--;
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    T* ChunkGrid<T>::Insert(int chunkX, int chunkZ)
+    {
+        if (!IsInWindow(chunkX, chunkZ))
+        {
+            return nullptr;
+        }
+        Slot& slot = m_slots[Index(chunkX, chunkZ)];
+        if (!slot.occupied)
+        {
+            slot.chunkX = chunkX;
+            slot.chunkZ = chunkZ;
+            slot.occupied = true;
+            m_size++;
+        }
+        return &slot.value;
+    }
+
+    template <typename T>
+    bool ChunkGrid<T>::Erase(int chunkX, int chunkZ)
+    {
+        if (!IsInWindow(chunkX, chunkZ))
+        {
+            return false;
+        }
+        Slot& slot = m_slots[Index(chunkX, chunkZ)];
+        if (!slot.occupied)
+        {
+            return false;
+        }
+        slot.value = T{};
+        slot.occupied = false;
+        m_size--;
+        return true;
+    }
+
+    template <typename T>
+    void ChunkGrid<T>::Clear()
+    {
+        for (Slot& slot : m_slots)
+        {
+            if (slot.occupied)
+            {
+                slot.value = T{};
+                slot.occupied = false;
+            }
+        }
+        m_size = 0;
+    }
+
+    template <typename T>
+    template <typename Function>
+    void ChunkGrid<T>::ForEach(Function&& fn)
+    {
+        for (int chunkZ = m_centerZ - m_radius; chunkZ <= m_centerZ + m_radius && m_size > 0; chunkZ++)
+        {
+            for (int chunkX = m_centerX - m_radius; chunkX <= m_centerX + m_radius; chunkX++)
+            {
+                Slot& slot = m_slots[Index(chunkX, chunkZ)];
+                if (slot.occupied)
+                {
+                    fn(chunkX, chunkZ, slot.value);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    template <typename Function>
+    void ChunkGrid<T>::ForEach(Function&& fn) const
+    {
+        for (int chunkZ = m_centerZ - m_radius; chunkZ <= m_centerZ + m_radius && m_size > 0; chunkZ++)
+        {
+            for (int chunkX = m_centerX - m_radius; chunkX <= m_centerX + m_radius; chunkX++)
+            {
+                const Slot& slot = m_slots[Index(chunkX, chunkZ)];
+                if (slot.occupied)
+                {
+                    fn(chunkX, chunkZ, slot.value);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    template <typename Function>
+    void ChunkGrid<T>::ForEachNearestFirst(Function&& fn)
+    {
+        ForEachInRings(m_centerX, m_centerZ, m_radius, [this, &fn](int chunkX, int chunkZ) {
+            Slot& slot = m_slots[Index(chunkX, chunkZ)];
+            return !slot.occupied || fn(chunkX, chunkZ, slot.value);
+        });
+    }
+
+    template <typename T>
+    template <typename Function>
+    void ChunkGrid<T>::ForEachInRings(int centerX, int centerZ, int radius, Function&& fn)
+    {
+        if (!fn(centerX, centerZ))
+        {
+            return;
+        }
+        for (int ring = 1; ring <= radius; ring++)
+        {
+            // The top and bottom rows of the ring, then the two sides between them
+            for (int dx = -ring; dx <= ring; dx++)
+            {
+                if (!fn(centerX + dx, centerZ - ring) || !fn(centerX + dx, centerZ + ring))
+                {
+                    return;
+                }
+            }
+            for (int dz = -ring + 1; dz <= ring - 1; dz++)
+            {
+                if (!fn(centerX - ring, centerZ + dz) || !fn(centerX + ring, centerZ + dz))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+#endif
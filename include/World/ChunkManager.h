@@ -9,20 +9,25 @@
 
 #include "World/World.h"
 #include "World/TerrainGenerator.h"
+#include "World/ChunkGrid.h"
 #include "World/ChunkRenderer.h"
 #include <glm/glm.hpp>
-#include <set>
 #include <unordered_set>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <deque>
 #include <atomic>
+#include <chrono>
+#include <unordered_map>
 
 namespace MinecraftClone
 {
     class PhysicsManager;
+    class WorldStorage;
+    class BlockTickScheduler;
 
     // Structure for chunk generation tasks
     struct ChunkGenerationTask
@@ -30,9 +35,15 @@ namespace MinecraftClone
         int chunkX;
         int chunkZ;
         bool needsTerrain;
+        uint32_t sectionMask;  // Sections to mesh
+        bool isRemesh;         // From the remesh queue
+        bool isEdit;           // Remesh requested by a block edit (rather than a border refresh)
+        std::chrono::steady_clock::time_point requestTime;
         
-        ChunkGenerationTask() : chunkX(0), chunkZ(0), needsTerrain(false) {}
-        ChunkGenerationTask(int x, int z, bool terrain) : chunkX(x), chunkZ(z), needsTerrain(terrain) {}
+        ChunkGenerationTask()
+            : chunkX(0), chunkZ(0), needsTerrain(false), sectionMask(ChunkMeshGenerator::ALL_SECTIONS), isRemesh(false), isEdit(false) {}
+        ChunkGenerationTask(int x, int z, bool terrain)
+            : chunkX(x), chunkZ(z), needsTerrain(terrain), sectionMask(ChunkMeshGenerator::ALL_SECTIONS), isRemesh(false), isEdit(false) {}
     };
 
     // Structure for completed chunk meshes
@@ -40,10 +51,22 @@ namespace MinecraftClone
     {
         int chunkX;
         int chunkZ;
-        std::unique_ptr<ChunkMesh> mesh;
+        ChunkSectionMeshes meshes;
+        bool isEdit;
+        bool terrainArrived;        // First mesh since the chunk's terrain became complete
+        uint16_t missingNeighbors;  // Neighbours (NeighborBit) meshed as air because their terrain was not there yet
+        std::chrono::steady_clock::time_point requestTime;
         
-        CompletedChunkMesh(int x, int z, std::unique_ptr<ChunkMesh> m) 
-            : chunkX(x), chunkZ(z), mesh(std::move(m)) {}
+        CompletedChunkMesh(int x, int z, ChunkSectionMeshes m) 
+            : chunkX(x), chunkZ(z), meshes(std::move(m)), isEdit(false), terrainArrived(false), missingNeighbors(0) {}
+    };
+
+    // Sections of one chunk waiting for a remesh; later requests OR into the mask
+    struct PendingRemesh
+    {
+        uint32_t sectionMask = 0;
+        bool isEdit = false;                                // Any merged request came from a block edit
+        std::chrono::steady_clock::time_point requestTime;  // Oldest merged request
     };
 
     class ChunkManager
@@ -54,6 +77,9 @@ namespace MinecraftClone
 
         void Initialize(World* world, TerrainGenerator* terrainGenerator, ChunkRenderer* chunkRenderer);
         void SetPhysicsManager(PhysicsManager* physicsManager) { m_physicsManager = physicsManager; }
+        void SetWorldStorage(WorldStorage* worldStorage) { m_worldStorage = worldStorage; }  // Pre-generated chunks
+        WorldStorage* GetWorldStorage() const { return m_worldStorage; }
+        void SetBlockTickScheduler(BlockTickScheduler* scheduler) { m_blockTickScheduler = scheduler; }  // Told about unloads and terrain in progress
         void Update(const glm::vec3& playerPosition, float deltaTime);
         void Shutdown();
 
@@ -64,25 +90,66 @@ namespace MinecraftClone
         int GetLoadDistance() const { return m_loadDistance; }
 
         // Get loaded chunks info
-        size_t GetLoadedChunkCount() const { return m_loadedChunks.size(); }
+        size_t GetLoadedChunkCount() const { return m_loadedChunkCount; }
         std::pair<int, int> GetCurrentChunk() const { return m_currentChunk; }
 
+        // Rebuild every loaded chunk's mesh on the worker threads (e.g. after a meshing mode change)
+        void RemeshAllChunks();
+
+        // Queue sections of a chunk for remeshing on the worker threads. Requests for the same chunk
+        // merge until a worker takes them, so a burst of edits costs one remesh per chunk; the old
+        // meshes stay visible until all of the chunk's new sections are swapped in on the main thread.
+        void RequestRemesh(int chunkX, int chunkZ, uint32_t sectionMask);
+        void RequestBlockRemesh(int worldX, int worldY, int worldZ);  // Sections affected by one block change
+        // Whole chunk whose blocks were replaced (e.g. received from the server): merged and ordered
+        // like the above, but queued as a background remesh, not an edit (no priority, no latency stat)
+        void RequestChunkRemesh(int chunkX, int chunkZ);
+
+        // Rebuild a loaded chunk's collision through the deferred physics queue (one chunk per frame)
+        // instead of on the spot; for changes nobody is standing on yet, such as block ticks
+        void RequestCollisionRebuild(int chunkX, int chunkZ);
+
+        // Edit remesh statistics (debug overlay)
+        size_t GetPendingRemeshCount() const;
+        double GetLastRemeshLatencyMs() const { return m_lastRemeshLatencyMs; }  // Request to swap-in
+
+        // Border refreshes queued because a neighbour's terrain arrived after a chunk was meshed
+        size_t GetBorderRefreshCount() const { return m_borderRefreshCount; }
+        size_t GetBorderRefreshSectionCount() const { return m_borderRefreshSections; }
+
     private:
+        // Chunks around the player: queued for loading, then loaded
+        enum class ChunkState : uint8_t
+        {
+            Queued,
+            Loaded
+        };
+        struct ChunkSlot
+        {
+            ChunkState state = ChunkState::Queued;
+            bool physicsPending = false;    // Waiting in the physics queue
+            bool rebuildCollision = false;  // ... to replace existing collision rather than add the first
+        };
+
         void UpdateChunks(const glm::vec3& playerPosition);
         void ProcessChunkQueue();  // Load queued chunks gradually
         void ProcessPhysicsQueue();  // Process deferred physics collision
         void LoadChunk(int chunkX, int chunkZ, bool addPhysicsImmediately = true);
-        void UnloadChunk(int chunkX, int chunkZ);
-        bool ShouldLoadChunk(int chunkX, int chunkZ, int centerChunkX, int centerChunkZ) const;
-        bool ShouldUnloadChunk(int chunkX, int chunkZ, int centerChunkX, int centerChunkZ) const;
+        void UnloadChunk(int chunkX, int chunkZ, ChunkSlot& slot);  // The caller erases the slot
         int GetChunkDistance(int chunkX1, int chunkZ1, int chunkX2, int chunkZ2) const;
 
         World* m_world;
         TerrainGenerator* m_terrainGenerator;
         ChunkRenderer* m_chunkRenderer;
         PhysicsManager* m_physicsManager;
+        WorldStorage* m_worldStorage;
+        BlockTickScheduler* m_blockTickScheduler;
 
-        std::set<std::pair<int, int>> m_loadedChunks;  // Chunks that are currently loaded
+        // Queued and loaded chunks, in a window of the load distance around the player's chunk that
+        // is moved as the player crosses chunks; chunks it leaves are unloaded
+        ChunkGrid<ChunkSlot> m_chunks;
+        size_t m_loadedChunkCount;
+        size_t m_pendingPhysicsCount;
         std::vector<std::pair<int, int>> m_chunksToLoad;  // Chunks queued for loading (ordered by priority)
         std::pair<int, int> m_currentChunk;  // Current chunk player is in
         std::pair<int, int> m_lastUpdateChunk;  // Last chunk we updated for
@@ -96,21 +163,50 @@ namespace MinecraftClone
         static constexpr float UPDATE_INTERVAL = 0.1f;  // Update chunks every 100ms
         static constexpr int MAX_CHUNKS_PER_FRAME = 2;  // Load max 2 chunks per frame
         static constexpr float MAX_FRAME_TIME_MS = 8.0f;  // Max 8ms per frame for chunk loading (target 60fps = 16.67ms)
-        
-        // Separate queue for physics collision (deferred to reduce frame time)
-        std::set<std::pair<int, int>> m_chunksPendingPhysics;
+
         
         // OPTIMIZATION 6: Multi-threading for chunk generation
         std::vector<std::thread> m_workerThreads;
-        std::queue<ChunkGenerationTask> m_generationQueue;
+        std::deque<ChunkGenerationTask> m_generationQueue;  // FIFO; tasks for a chunk in flight wait their turn
         std::queue<CompletedChunkMesh> m_completedMeshes;
-        std::mutex m_generationQueueMutex;
+        mutable std::mutex m_generationQueueMutex;
         std::mutex m_completedMeshesMutex;
         std::condition_variable m_generationCondition;
         std::atomic<bool> m_shouldStopWorkers;
         static constexpr int NUM_WORKER_THREADS = 2;  // Number of background threads
+
+        // Edit remeshes (guarded by m_generationQueueMutex): served before generation tasks, nearest
+        // chunk to m_remeshCenter first. m_remeshesInFlight holds every chunk a worker is meshing,
+        // remesh or generation task alike, and no task starts on a chunk in it, so a chunk's meshes
+        // are swapped in in the order they were started and the last one always has the latest blocks.
+        std::unordered_map<std::pair<int, int>, PendingRemesh, ChunkCoordHash> m_pendingRemeshes;
+        std::unordered_set<std::pair<int, int>, ChunkCoordHash> m_remeshesInFlight;
+        size_t m_remeshTasksInFlight;  // Entries of m_remeshesInFlight from the remesh queue
+        std::pair<int, int> m_remeshCenter;
+        double m_lastRemeshLatencyMs;
+
+        // Neighbour dependencies: a chunk meshed before a neighbour's terrain was complete saw air
+        // there and kept wall faces along that border. m_generatedChunks (guarded by
+        // m_generationQueueMutex) holds the chunks whose terrain is complete; m_missingNeighbors (main
+        // thread) the neighbours each chunk's current meshes were built without, until they arrive.
+        std::unordered_set<std::pair<int, int>, ChunkCoordHash> m_generatedChunks;
+        std::unordered_map<std::pair<int, int>, uint16_t, ChunkCoordHash> m_missingNeighbors;
+        size_t m_borderRefreshCount;
+        size_t m_borderRefreshSections;
+
+        static uint16_t NeighborBit(int dx, int dz) { return static_cast<uint16_t>(1u << ((dz + 1) * 3 + (dx + 1))); }
+        uint16_t GetMissingNeighbors(int chunkX, int chunkZ) const;  // Caller holds m_generationQueueMutex
+        void TrackMissingNeighbors(int chunkX, int chunkZ, uint16_t missingNeighbors);
+        void RefreshNeighborBorders(int chunkX, int chunkZ);  // The chunk's terrain just arrived
+        void RequestBorderRefresh(int chunkX, int chunkZ, int dx, int dz);
+        void QueueRemesh(int chunkX, int chunkZ, uint32_t sectionMask, bool isEdit);
         
         void WorkerThreadFunction();  // Background thread function
+        bool TakeRemeshTask(ChunkGenerationTask& task);      // Caller holds m_generationQueueMutex
+        bool TakeGenerationTask(ChunkGenerationTask& task);  // Caller holds m_generationQueueMutex
+        bool HasRunnableRemesh() const;                      // Caller holds m_generationQueueMutex
+        bool HasRunnableGenerationTask() const;              // Caller holds m_generationQueueMutex
+        void FinishChunkTask(const ChunkGenerationTask& task);  // Lets the next task for the chunk start
         void ProcessCompletedMeshes();  // Process completed meshes on main thread
     };
 }
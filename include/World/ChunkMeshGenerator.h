@@ -10,19 +10,130 @@
 #include "World/Chunk.h"
 #include "Rendering/ChunkMesh.h"
 #include "World/World.h"
+#include "World/ChunkMeshInput.h"
+#include "World/SectionVisibility.h"
+#include <array>
 #include <memory>
+#include <atomic>
+#include <cstdint>
 
 namespace MinecraftClone
 {
+    enum class MeshingMode
+    {
+        Naive,   // One quad per visible block face
+        Greedy   // Coplanar faces of the same block type merged into maximal rectangles
+    };
+
+    // Meshes of the 16-block-high sections of one chunk. Only sections whose bit is set in
+    // sectionMask were meshed; a null mesh there means the section has no visible faces.
+    struct ChunkSectionMeshes
+    {
+        uint32_t sectionMask = 0;
+        std::array<std::unique_ptr<ChunkMesh>, CHUNK_SECTION_COUNT> sections;
+        // Face-to-face connectivity of every section in sectionMask, meshed or not (all-air sections are
+        // open, fully opaque ones closed)
+        std::array<SectionVisibility, CHUNK_SECTION_COUNT> visibility;
+
+        // Whole-chunk downsampled meshes, one per ChunkMeshInput LOD level (null where a level has no
+        // faces); only filled in, and hasLods set, when LOD meshing is on
+        bool hasLods = false;
+        std::array<std::unique_ptr<ChunkMesh>, ChunkMeshInput::LOD_LEVEL_COUNT> lods;
+    };
+
+    // Sections of one chunk that need remeshing
+    struct SectionRemesh
+    {
+        int chunkX;
+        int chunkZ;
+        uint32_t sectionMask;
+    };
+
     class ChunkMeshGenerator
     {
     public:
+        static constexpr uint32_t ALL_SECTIONS = (1u << CHUNK_SECTION_COUNT) - 1u;
+
+        // CPU-only meshing with the current meshing mode; the caller uploads with Build() on the GL thread
         static std::unique_ptr<ChunkMesh> GenerateMesh(Chunk* chunk, int chunkX, int chunkZ, World* world);
-        static void AddFace(ChunkMesh* mesh, const glm::vec3& position, BlockType blockType, int faceIndex);
+        // CPU-only meshing with an explicit mode; the returned mesh is not built
+        static std::unique_ptr<ChunkMesh> GenerateMesh(Chunk* chunk, int chunkX, int chunkZ, World* world, MeshingMode mode);
+        // CPU-only meshing of an assembled padded volume (no World needed); chunkX/Z place the vertices
+        static std::unique_ptr<ChunkMesh> GenerateMesh(const ChunkMeshInput& input, int chunkX, int chunkZ, MeshingMode mode);
+        // CPU-only meshing of the sections selected by sectionMask (bit s = layers [16s, 16s + 16)), one mesh each
+        static ChunkSectionMeshes GenerateSectionMeshes(Chunk* chunk, int chunkX, int chunkZ, World* world,
+                                                        uint32_t sectionMask, MeshingMode mode);
+        static ChunkSectionMeshes GenerateSectionMeshes(const ChunkMeshInput& input, int chunkX, int chunkZ,
+                                                        uint32_t sectionMask, MeshingMode mode);
+        // CPU-only greedy meshing of the chunk downsampled to one LOD level; null if it has no faces
+        static std::unique_ptr<ChunkMesh> GenerateLodMesh(Chunk* chunk, int chunkX, int chunkZ, World* world, int level);
+        static void GenerateLodMeshes(Chunk* chunk, int chunkX, int chunkZ, World* world, ChunkSectionMeshes& meshes);
+        // Sections whose faces or corner occlusion can change when the block at (worldX, worldY, worldZ)
+        // changes: everything within one block of it, i.e. its own section, the section across a section
+        // boundary and the chunks across a border or corner. Writes at most MAX_AFFECTED_CHUNKS entries,
+        // own chunk first, and returns the count.
+        static constexpr int MAX_AFFECTED_CHUNKS = 4;
+        static int GetSectionsAffectedByBlock(int worldX, int worldY, int worldZ, SectionRemesh out[MAX_AFFECTED_CHUNKS]);
+        // Sections of chunk holding a block on its border toward the neighbour at offset (dx, dz) (a side or
+        // a corner column): the only faces whose culling or corner occlusion reads that neighbour
+        static uint32_t GetBorderSections(const Chunk& chunk, int dx, int dz);
+        // One unlit face of the block at localPosition (relative to the mesh origin)
+        static void AddFace(ChunkMesh* mesh, const glm::ivec3& localPosition, BlockType blockType, int faceIndex);
+        static glm::vec3 GetBlockColor(BlockType type);
+
+        // Runtime meshing mode (read by worker threads)
+        static void SetMeshingMode(MeshingMode mode) { s_meshingMode = mode; }
+        static MeshingMode GetMeshingMode() { return s_meshingMode; }
+
+        // Face culling: bitmask rows (default) or per-face neighbour lookups (reference for benchmarks)
+        static void SetBitmaskCulling(bool enabled) { s_bitmaskCulling = enabled; }
+        static bool IsBitmaskCulling() { return s_bitmaskCulling; }
+        // Face culling alone, with the current method, over every non-air layer of the input: the number
+        // of faces left visible, without building any quads (times the culling step on its own)
+        static size_t CullFaces(const ChunkMeshInput& input);
+
+        // Baked per-vertex ambient occlusion (default on); off gives every corner full light
+        static void SetAmbientOcclusion(bool enabled) { s_ambientOcclusion = enabled; }
+        static bool IsAmbientOcclusion() { return s_ambientOcclusion; }
+
+        // Per-thread scratch buffers reused across meshing calls (default on); off allocates them
+        // fresh every call and grows each mesh in place (reference for benchmarks)
+        static void SetScratchReuse(bool enabled) { s_scratchReuse = enabled; }
+        static bool IsScratchReuse() { return s_scratchReuse; }
+
+        // Downsampled meshes for distant chunks (default off). While on, every mesh is assembled with
+        // LOD skirts (see ChunkMeshInput) so chunks drawn at different levels meet without cracks.
+        static void SetLodEnabled(bool enabled) { s_lodEnabled = enabled; }
+        static bool IsLodEnabled() { return s_lodEnabled; }
 
     private:
-        static glm::vec3 GetBlockColor(BlockType type);
-        static bool ShouldRenderFace(Chunk* chunk, int x, int y, int z, int faceIndex, World* world, int chunkX, int chunkZ, Chunk* neighborChunks[4]);
+        struct FaceMasks;    // Visible faces per direction as 16-bit X rows
+        struct MeshScratch;  // Padded input, masks, greedy slices and a staging mesh
+
+        // The calling thread's scratch, or a fresh one held by owned when reuse is off
+        static MeshScratch& AcquireScratch(std::unique_ptr<MeshScratch>& owned);
+        // Mesh layers [yBegin, yEnd) into the scratch staging mesh (or a fresh mesh when reuse is off) and
+        // return a right-sized mesh, or null if it has no faces
+        static std::unique_ptr<ChunkMesh> MeshLayers(MeshScratch& scratch, const ChunkMeshInput& input, int chunkX, int chunkZ,
+                                                     int yBegin, int yEnd, MeshingMode mode, bool ambientOcclusion);
+
+        // Masks and faces cover layers [yBegin, yEnd); callers clamp yEnd to the input's top layer
+        static void BuildFaceMasks(const ChunkMeshInput& input, int yBegin, int yEnd, FaceMasks& masks);
+        static void BuildFaceMasksReference(const ChunkMeshInput& input, int yBegin, int yEnd, FaceMasks& masks);
+        static void BuildFaceMasksBitwise(const ChunkMeshInput& input, int yBegin, int yEnd, FaceMasks& masks);
+        static void GenerateFaces(ChunkMesh* mesh, const ChunkMeshInput& input, int chunkX, int chunkZ,
+                                  const FaceMasks& masks, int yBegin, int yEnd, MeshingMode mode, bool ambientOcclusion,
+                                  MeshScratch& scratch);
+        static void GenerateNaiveFaces(ChunkMesh* mesh, const ChunkMeshInput& input, const FaceMasks& masks,
+                                       int yBegin, int yEnd, bool ambientOcclusion);
+        static void GenerateGreedyFaces(ChunkMesh* mesh, const ChunkMeshInput& input, const FaceMasks& masks,
+                                        int yBegin, int yEnd, bool ambientOcclusion, MeshScratch& scratch);
+
+        static std::atomic<MeshingMode> s_meshingMode;
+        static std::atomic<bool> s_bitmaskCulling;
+        static std::atomic<bool> s_ambientOcclusion;
+        static std::atomic<bool> s_scratchReuse;
+        static std::atomic<bool> s_lodEnabled;
     };
 }
 
@@ -0,0 +1,72 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef CHUNKMESHINPUT_H
+#define CHUNKMESHINPUT_H
+
+#pragma once
+
+#include "World/Chunk.h"
+#include "World/BlockType.h"
+#include <vector>
+
+namespace MinecraftClone
+{
+    class World;
+
+    // Dense block types of one chunk plus a one-block border on every side (18 x 258 x 18),
+    // assembled once before meshing so the mesher never branches on chunk or world boundaries.
+    // Coordinates are chunk-local: x and z in [-1, 16], y in [-1, 256]. The border comes from the
+    // eight surrounding chunks; missing chunks and the layers below y = 0 and above y = 255 are air.
+    // Above GetTopY() (the highest layer meshing reads) the border is left as air.
+    //
+    // With LOD skirts, a border block only counts when it is also solid in the neighbour's 2x and 4x
+    // downsampled cells: every mesh of every level then keeps its border faces wherever the
+    // neighbour, at whatever level it is drawn, could leave the border open, so levels never crack.
+    class ChunkMeshInput
+    {
+    public:
+        static constexpr int SIZE_X = CHUNK_SIZE_X + 2;
+        static constexpr int SIZE_Y = CHUNK_SIZE_Y + 2;
+        static constexpr int SIZE_Z = CHUNK_SIZE_Z + 2;
+        static constexpr int VOLUME = SIZE_X * SIZE_Y * SIZE_Z;
+
+        ChunkMeshInput();
+
+        // Downsampled levels: level 0 has 2x2x2-block cells, level 1 4x4x4
+        static constexpr int LOD_LEVEL_COUNT = 2;
+        static constexpr int GetLodScale(int level) { return 2 << level; }
+
+        // neighbors[dz + 1][dx + 1] is the chunk at offset (dx, dz); the centre entry is ignored
+        void Assemble(const Chunk& chunk, const Chunk* const neighbors[3][3], bool lodSkirts = false);
+        bool Assemble(World* world, int chunkX, int chunkZ, bool lodSkirts = false);  // False if the chunk is not loaded
+        // The chunk downsampled to scale x scale x scale cells, each cell's majority type repeated over its
+        // blocks, so the regular meshers produce scale-aligned quads. The border is the full-resolution
+        // neighbours with LOD skirts.
+        void AssembleDownsampled(const Chunk& chunk, const Chunk* const neighbors[3][3], int scale);
+        void Clear();  // All air (for building synthetic input)
+
+        // Majority vote of one cell: air unless at least half its blocks are solid, else the most common solid type
+        static BlockType GetCellType(const Chunk& chunk, int cellX, int cellY, int cellZ, int scale);
+
+        BlockType Get(int x, int y, int z) const { return m_types[Index(x, y, z)]; }
+        void Set(int x, int y, int z, BlockType type);
+
+        // One past the highest layer of the centre chunk that is not air (0 = nothing to mesh)
+        int GetTopY() const { return m_topY; }
+
+        // Padded storage, y-major: ((y + 1) * SIZE_Z + (z + 1)) * SIZE_X + (x + 1)
+        const BlockType* GetData() const { return m_types.data(); }
+        static int Index(int x, int y, int z) { return ((y + 1) * SIZE_Z + (z + 1)) * SIZE_X + (x + 1); }
+
+    private:
+        void AssembleBorder(const Chunk* const neighbors[3][3]);  // Border rows below GetTopY() + 1
+        void ApplyLodSkirts(const Chunk* const neighbors[3][3]);
+
+        std::vector<BlockType> m_types;
+        int m_topY;
+    };
+}
+
+#endif
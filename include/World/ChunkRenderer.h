@@ -8,14 +8,21 @@
 #pragma once
 
 #include "World/Chunk.h"
+#include "World/ChunkGrid.h"
 #include "Rendering/ChunkMesh.h"
+#include "Rendering/ChunkGeometryArena.h"
 #include "Rendering/Shader.h"
 #include "Rendering/Frustum.h"
+#include "Rendering/OcclusionCuller.h"
 #include "World/World.h"
 #include "Rendering/Texture.h"
 #include "Rendering/BlockTextureRegistry.h"
-#include <unordered_map>
+#include "World/ChunkMeshGenerator.h"
+#include "World/SectionVisibility.h"
+#include <glm/glm.hpp>
+#include <array>
 #include <memory>
+#include <vector>
 
 namespace MinecraftClone
 {
@@ -24,21 +31,152 @@ namespace MinecraftClone
     class ChunkRenderer
     {
     public:
+        // CPU time of one RenderChunks call, split at the end of culling / sorting
+        struct RenderTimings
+        {
+            float cullMs = 0.0f;    // Frustum, cave and occlusion culling, LOD selection, sorting
+            float occlusionMs = 0.0f;  // Occluder rasterization (part of cullMs)
+            float submitMs = 0.0f;  // Frame state, uniform upload and draw submission
+        };
+
         ChunkRenderer();
         ~ChunkRenderer();
 
         bool Initialize();
-        void UpdateChunk(Chunk* chunk, int chunkX, int chunkZ, World* world);
-        void SetChunkMesh(int chunkX, int chunkZ, std::unique_ptr<ChunkMesh> mesh);  // Set pre-built mesh (for multi-threading)
+        void UpdateChunk(Chunk* chunk, int chunkX, int chunkZ, World* world);  // Remesh every section
+        void UpdateSections(Chunk* chunk, int chunkX, int chunkZ, World* world, uint32_t sectionMask);
+        // Remesh after a single block change: its section, plus the sections across any face it touches
+        void UpdateBlock(int worldX, int worldY, int worldZ, World* world);
+        // Replace the sections in meshes.sectionMask with CPU-built meshes (for multi-threading); uploads them
+        void SetSectionMeshes(int chunkX, int chunkZ, ChunkSectionMeshes meshes);
         void RenderChunks(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
         void UnloadChunk(int chunkX, int chunkZ);
         void Shutdown();
 
+        // Chunks are kept for a square of chunk columns around a centre (ChunkManager moves it with
+        // the player); meshes for chunks outside it are dropped, and moving it unloads those it leaves
+        void SetChunkWindow(int centerX, int centerZ, int radius);
+
+        // Mesh statistics (debug overlay)
+        size_t GetChunkCount() const { return m_chunks.Size(); }
+        size_t GetMeshCount() const;  // Non-empty section meshes
+        size_t GetTotalFaceCount() const;     // Full-resolution section meshes
+        size_t GetTotalLodFaceCount() const;  // Downsampled meshes of every level
+        size_t GetTotalUploadSize() const;
+        bool IsArenaEnabled() const { return m_arena.IsInitialized(); }
+        FreeListAllocator::Stats GetArenaStats() const { return m_arena.GetStats(); }  // In faces
+        const RenderTimings& GetLastRenderTimings() const { return m_lastTimings; }
+
+        // Skip frustum-visible sections that opaque blocks hide from the camera's section (default on)
+        void SetCaveCulling(bool enabled) { m_caveCulling = enabled; }
+        bool IsCaveCulling() const { return m_caveCulling; }
+        int GetLastCaveCulledSections() const { return m_lastCaveCulled; }  // In the frustum but unreachable
+
+        // Test sections against a CPU depth buffer of fully opaque layers before drawing them (default on)
+        void SetOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; }
+        bool IsOcclusionCulling() const { return m_occlusionCulling; }
+        const OcclusionStats& GetOcclusionStats() const { return m_occlusionCuller.GetStats(); }  // Last frame
+
+        // Horizontal distance (blocks, camera to chunk centre) from which chunks are drawn from their
+        // LOD meshes instead of their sections, per level; only while LOD meshing is on
+        void SetLodDistances(float level0, float level1) { m_lodDistances[0] = level0; m_lodDistances[1] = level1; }
+
     private:
+        // One mesh per 16-block section; null where the section has no visible faces
+        using SectionMeshArray = std::array<std::unique_ptr<ChunkMesh>, CHUNK_SECTION_COUNT>;
+        using LodMeshArray = std::array<std::unique_ptr<ChunkMesh>, ChunkMeshInput::LOD_LEVEL_COUNT>;
+        using SectionVisibilityArray = std::array<SectionVisibility, CHUNK_SECTION_COUNT>;
+
+        // Everything the renderer keeps for one chunk column
+        struct ChunkSlot
+        {
+            SectionMeshArray sections;
+            LodMeshArray lods;
+            bool hasLods = false;  // Meshed while LOD meshing was on
+            SectionVisibilityArray visibility;
+        };
+
+        // A section that passed frustum culling this frame
+        struct VisibleSection
+        {
+            ChunkMesh* mesh;
+            float distanceSquared;  // Camera to section centre
+            uint8_t directions;     // Face directions that can face the camera (ChunkMesh::GetFacingDirections)
+        };
+
+        // Entries of the cull lists, parallel to their bounds in m_chunkBounds / m_sectionBounds
+        struct CullChunk
+        {
+            std::pair<int, int> coord;
+            const LodMeshArray* lods;  // Null without LOD meshes
+            int sectionCount;          // Its entries in m_cullSections
+        };
+        struct CullSection
+        {
+            ChunkMesh* mesh;
+            uint32_t chunk;  // Index into m_cullChunks
+            int section;
+        };
+
+        // Arena face capacity: 64 MiB of packed faces
+        static constexpr uint32_t ARENA_CAPACITY_FACES = 8u << 20;
+        // Chunk window until SetChunkWindow is called: 16 chunks around the origin
+        static constexpr int DEFAULT_CHUNK_WINDOW_RADIUS = 16;
+
+        void SortTranslucentSections(const glm::vec3& cameraPosition);
+        static void ReleaseChunk(ChunkSlot& slot);
+        // Gather every chunk and non-empty section with its mesh bounds (after meshes changed)
+        void RebuildCullLists();
+        // Queue one occluder box per vertical run of fully opaque layers of every chunk in the frustum
+        void AddOccluders();
+        // Draw one layer of every visible section, arena meshes batched into indirect multi-draws
+        size_t DrawLayer(RenderLayer layer, bool backToFront);
+        void FlushDraws();
+        int SelectLodLevel(float distance) const;  // -1 = full resolution
+
         std::unique_ptr<Shader> m_shader;
-        std::unordered_map<std::pair<int, int>, std::unique_ptr<ChunkMesh>, ChunkCoordHash> m_chunkMeshes;
-        std::unique_ptr<Texture> m_atlasTexture;  // Single texture atlas
+        GLuint m_frameDataBuffer;       // ChunkMesh::FrameData, uploaded once per frame
+        GLint m_alphaCutoffLocation;    // The only uniforms set per layer
+        GLint m_layerAlphaLocation;
+        ChunkGrid<ChunkSlot> m_chunks;  // Every chunk that has been meshed
+        float m_lodDistances[ChunkMeshInput::LOD_LEVEL_COUNT];
+        std::unique_ptr<Texture> m_blockTextures;  // Array texture, one layer per atlas tile
         Frustum m_frustum; // For frustum culling
+        SectionVisibilityGraph m_visibilityGraph;  // For cave culling
+        bool m_caveCulling;
+        int m_lastCaveCulled;
+        OcclusionCuller m_occlusionCuller;
+        bool m_occlusionCulling;
+        std::vector<OccluderBox> m_occluderBoxes;       // Reused every frame
+        std::vector<VisibleSection> m_visibleSections;  // Reused every frame
+
+        // Chunk boxes (union of their meshes, for LOD selection) and section boxes, packed for
+        // Frustum::CullAABBs and rebuilt only when meshes are added, replaced or removed
+        AABBArray m_chunkBounds;
+        std::vector<CullChunk> m_cullChunks;
+        AABBArray m_sectionBounds;
+        std::vector<CullSection> m_cullSections;
+        bool m_cullListsDirty;
+        std::vector<uint32_t> m_frustumVisible;  // Reused every frame
+        std::vector<uint8_t> m_chunkDrawsLod;    // Per m_cullChunks entry, this frame
+
+        // Indirect batches: draw i reads m_drawOrigins[baseInstance], one origin per visible section
+        ChunkGeometryArena m_arena;
+        GLuint m_batchVAO;
+        GLuint m_originBuffer;
+        GLuint m_indirectBuffer;
+        std::vector<glm::vec3> m_drawOrigins;
+        std::vector<DrawArraysIndirectCommand> m_drawCommands;
+        size_t m_multiDrawCalls;    // This frame
+        size_t m_indirectCommands;
+
+        RenderTimings m_lastTimings;
+        RenderTimings m_timingTotals;  // Summed since the last stats log
+
+        // Translucent quads are sorted for the camera as of the last section boundary it crossed
+        glm::vec3 m_sortCameraPosition;
+        glm::ivec3 m_sortCameraSection;
+        bool m_hasSortCamera;
     };
 }
 
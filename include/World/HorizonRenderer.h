@@ -0,0 +1,84 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef HORIZONRENDERER_H
+#define HORIZONRENDERER_H
+
+#pragma once
+
+#include "World/World.h"
+#include "Rendering/Shader.h"
+#include "Rendering/Frustum.h"
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+namespace MinecraftClone
+{
+    class TerrainGenerator;
+
+    // Far-horizon terrain between the render distance and the LOD distance.
+    // Only the 2D heightmap is generated (no Chunk, no physics, no per-block storage) and drawn as
+    // coarse tiles, each covering TILE_CHUNKS x TILE_CHUNKS chunks with one height sample per cell.
+    class HorizonRenderer
+    {
+    public:
+        HorizonRenderer();
+        ~HorizonRenderer();
+
+        bool Initialize(TerrainGenerator* terrainGenerator);
+        void Update(const glm::vec3& playerPosition, int renderDistance);
+        void Render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+        void Shutdown();
+
+        // Settings
+        void SetLodDistance(int distance) { m_lodDistance = distance; m_hasCenter = false; }
+        int GetLodDistance() const { return m_lodDistance; }
+
+        size_t GetTileCount() const { return m_tiles.size(); }
+
+    private:
+        struct HorizonVertex
+        {
+            glm::vec3 position;
+            glm::vec3 color;
+        };
+
+        struct HorizonTile
+        {
+            GLuint VAO = 0;
+            GLuint VBO = 0;
+            GLuint EBO = 0;
+            GLsizei indexCount = 0;
+            glm::vec3 boundsMin = glm::vec3(0.0f);
+            glm::vec3 boundsMax = glm::vec3(0.0f);
+        };
+
+        void RefreshTiles();
+        bool IsTileNeeded(int tileX, int tileZ) const;
+        void BuildTile(int tileX, int tileZ);
+        void DestroyTile(HorizonTile& tile);
+
+        TerrainGenerator* m_terrainGenerator;
+        std::unique_ptr<Shader> m_shader;
+        Frustum m_frustum;
+
+        std::unordered_map<std::pair<int, int>, HorizonTile, ChunkCoordHash> m_tiles;
+        std::vector<std::pair<int, int>> m_tilesToBuild;  // Ordered by distance (closest first)
+
+        std::pair<int, int> m_centerChunk;
+        int m_renderDistance;
+        int m_lodDistance;
+        bool m_hasCenter;
+
+        static constexpr int TILE_CHUNKS = 4;                                     // Tile covers 4x4 chunks
+        static constexpr int CELL_SIZE = 4;                                       // Blocks per height sample
+        static constexpr int TILE_CELLS = TILE_CHUNKS * CHUNK_SIZE_X / CELL_SIZE; // Cells per tile side
+        static constexpr int MAX_TILES_PER_FRAME = 2;
+    };
+}
+
+#endif
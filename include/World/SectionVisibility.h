@@ -0,0 +1,115 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef SECTIONVISIBILITY_H
+#define SECTIONVISIBILITY_H
+
+#pragma once
+
+#include "World/Chunk.h"
+#include "World/ChunkMeshInput.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace MinecraftClone
+{
+    // Which faces of one 16x16x16 section are connected through its non-opaque blocks: two faces are
+    // connected when some run of air / transparent blocks touches both, so a line of sight entering
+    // through one can leave through the other. Faces use the mesh face order (0=+Z, 1=-Z, 2=-X, 3=+X,
+    // 4=+Y, 5=-Y; face ^ 1 is the opposite face). CPU-only, computed by flood fill at mesh time, along
+    // with the layers that are opaque across the whole section (occluders for OcclusionCuller).
+    class SectionVisibility
+    {
+    public:
+        static constexpr int FACE_COUNT = 6;
+
+        SectionVisibility() : m_connections(ALL_CONNECTED), m_opaqueLayers(0) {}  // Open: every face sees every other
+
+        static SectionVisibility Closed() { return SectionVisibility(0, ALL_LAYERS); }  // Solid: no face sees another
+        // Flood fill layers [16 * section, 16 * section + 16) of input's centre chunk
+        static SectionVisibility Compute(const ChunkMeshInput& input, int section);
+
+        bool IsConnected(int fromFace, int toFace) const { return (m_connections >> (fromFace * FACE_COUNT + toFace) & 1u) != 0; }
+        // Faces connected to fromFace, as bits 1 << face
+        uint8_t GetConnectedFaces(int fromFace) const { return static_cast<uint8_t>(m_connections >> (fromFace * FACE_COUNT) & 0x3Fu); }
+        bool IsOpen() const { return m_connections == ALL_CONNECTED; }
+        bool IsClosed() const { return m_connections == 0; }
+        // Bit y set when all 16x16 blocks of the section's layer y are opaque
+        uint16_t GetOpaqueLayers() const { return m_opaqueLayers; }
+
+        // Connect every pair of the faces in faceMask (a face touched by a pocket reaches itself too)
+        void ConnectFaces(uint8_t faceMask);
+
+        bool operator==(const SectionVisibility& other) const
+        {
+            return m_connections == other.m_connections && m_opaqueLayers == other.m_opaqueLayers;
+        }
+        bool operator!=(const SectionVisibility& other) const { return !(*this == other); }
+
+    private:
+        static constexpr uint64_t ALL_CONNECTED = (uint64_t(1) << (FACE_COUNT * FACE_COUNT)) - 1u;
+        static constexpr uint16_t ALL_LAYERS = 0xFFFF;
+
+        SectionVisibility(uint64_t connections, uint16_t opaqueLayers) : m_connections(connections), m_opaqueLayers(opaqueLayers) {}
+
+        uint64_t m_connections;  // Bit from * 6 + to; symmetric
+        uint16_t m_opaqueLayers;
+    };
+
+    // Axis-aligned box of fully opaque blocks, in world coordinates
+    struct OccluderBox
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // Occluder boxes of one chunk column (CHUNK_SECTION_COUNT visibilities): one per run of fully opaque
+    // layers, which may cross section boundaries
+    void GetChunkOccluders(int chunkX, int chunkZ, const SectionVisibility* column, std::vector<OccluderBox>& boxes);
+
+    // Breadth-first walk over sections outward from the camera's section. A step from one section to
+    // a neighbour is taken only when the face it leaves through is connected to the face it entered
+    // through, never back toward the camera (opposite to any direction already stepped in), and only
+    // into sections the caller accepts (the view frustum). Sections the walk never reaches are hidden
+    // behind opaque blocks from every point of the camera's section.
+    class SectionVisibilityGraph
+    {
+    public:
+        // Visibility of a loaded section; null when the chunk has none yet (not meshed), which the walk
+        // treats as open so nothing disappears while it arrives
+        using VisibilityLookup = std::function<const SectionVisibility*(int chunkX, int section, int chunkZ)>;
+        using SectionFilter = std::function<bool(int chunkX, int section, int chunkZ)>;
+
+        // Walk at most radius chunks from the camera's chunk in x and z. False (and nothing is reached)
+        // when the camera is above or below the world, where every section can be in sight.
+        bool Traverse(const glm::vec3& cameraPosition, int radius, const VisibilityLookup& lookup, const SectionFilter& filter);
+
+        bool IsReachable(int chunkX, int section, int chunkZ) const;
+        bool IsChunkReachable(int chunkX, int chunkZ) const;  // Any of its sections
+        size_t GetReachableCount() const { return m_reachableCount; }
+
+    private:
+        struct Step
+        {
+            int chunkX;
+            int chunkZ;
+            int section;
+            int entryFace;       // Face of this section the walk came in through; -1 for the camera's section
+            uint8_t directions;  // Face directions stepped in so far (bits 1 << face)
+        };
+
+        int Index(int chunkX, int section, int chunkZ) const;  // -1 outside the walked square
+
+        int m_centreX = 0;
+        int m_centreZ = 0;
+        int m_radius = -1;
+        std::vector<uint8_t> m_reached;  // [z][x][section] over the walked square
+        std::vector<Step> m_queue;       // Reused every walk
+        size_t m_reachableCount = 0;
+    };
+}
+
+#endif
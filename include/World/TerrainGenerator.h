@@ -24,6 +24,20 @@ namespace MinecraftClone
         void Initialize(int seed = 12345);
         void GenerateChunk(Chunk* chunk, int chunkX, int chunkZ, World* world);
 
+        // Sample size x size terrain heights spaced `step` blocks apart, starting at world (worldX, worldZ),
+        // using only the batched 2D noise path. worldX and worldZ must be multiples of step.
+        // With step 1 this is exactly the heightmap GenerateChunk builds, so coarse terrain lines up with chunks.
+        void GenerateHeightmap(int worldX, int worldZ, int size, int step, int* heights);
+        BlockType GetSurfaceBlockType(int height) { return GetBlockTypeForHeight(height, height); }
+
+        // Fill stage of GenerateChunk: place stone, dirt and surface layers from a 17x17 heightmap
+        // (GenerateHeightmap with step 1). Expects a freshly constructed (all air) chunk.
+        void FillChunk(Chunk* chunk, const int* heightSamples);
+
+        // Vectorized section fill (default) or the original per-block scalar fill, for benchmarking
+        void SetVectorizedFill(bool enabled) { m_vectorizedFill = enabled; }
+        bool IsVectorizedFill() const { return m_vectorizedFill; }
+
         // Terrain settings
         void SetSeaLevel(int level) { m_seaLevel = level; }
         void SetBaseHeight(int height) { m_baseHeight = height; }
@@ -33,6 +47,9 @@ namespace MinecraftClone
         int GetHeightAt(int worldX, int worldZ);
         BlockType GetBlockTypeForHeight(int height, int y);
 
+        void FillChunkScalar(Chunk* chunk, const int* heightSamples);
+        void FillChunkVectorized(Chunk* chunk, const int* heightSamples);
+
         FastNoise::SmartNode<> m_heightNoise;
         FastNoise::SmartNode<> m_detailNoise;
 
@@ -41,6 +58,7 @@ namespace MinecraftClone
         int m_baseHeight;
         int m_heightVariation;
         bool m_initialized;
+        bool m_vectorizedFill;
     };
 }
 
@@ -0,0 +1,51 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef WORLDSTORAGE_H
+#define WORLDSTORAGE_H
+
+#pragma once
+
+#include "World/Chunk.h"
+#include <string>
+
+namespace MinecraftClone
+{
+    // On-disk world format:
+    //   <directory>/world.json           - world metadata (seed, sky light, format version)
+    //   <directory>/chunks/c.<x>.<z>.dat  - one zlib-compressed chunk per file
+    // Chunk files are written to a temporary file and renamed into place, so a chunk
+    // is either fully present or absent and interrupted writers can simply resume.
+    class WorldStorage
+    {
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        WorldStorage();
+        ~WorldStorage() = default;
+
+        bool Open(const std::string& directory, bool create = true);
+        bool IsOpen() const { return m_isOpen; }
+        const std::string& GetDirectory() const { return m_directory; }
+
+        // World metadata. skyLight records whether chunks were saved with sky light calculated;
+        // worlds written before it was stored load as unlit.
+        bool SaveMetadata(int seed, bool skyLight);
+        bool LoadMetadata(int& seed, bool& skyLight) const;
+        bool HasMetadata() const;  // world.json exists, readable or not
+
+        // Chunk access (safe to call concurrently for different chunks)
+        bool HasChunk(int chunkX, int chunkZ) const;
+        bool SaveChunk(const Chunk& chunk) const;
+        bool LoadChunk(Chunk& chunk, int chunkX, int chunkZ) const;
+
+    private:
+        std::string GetChunkPath(int chunkX, int chunkZ) const;
+
+        std::string m_directory;
+        bool m_isOpen;
+    };
+}
+
+#endif
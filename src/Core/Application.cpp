@@ -15,8 +15,12 @@
 #include "World/BlockType.h"
 #include "World/World.h"
 #include "World/ChunkRenderer.h"
+#include "World/HorizonRenderer.h"
+#include "World/BlockTickScheduler.h"
 #include "World/TerrainGenerator.h"
 #include "World/ChunkManager.h"
+#include "World/ChunkMeshGenerator.h"
+#include "World/WorldStorage.h"
 #include "World/BlockInteraction.h"
 #include "Networking/NetworkManager.h"
 #include "Rendering/RemotePlayerRenderer.h"
@@ -171,8 +175,9 @@ namespace MinecraftClone
         m_world = std::make_unique<World>();
 
         // Initialize terrain generator
+        const int worldSeed = 12345;
         m_terrainGenerator = std::make_unique<TerrainGenerator>();
-        m_terrainGenerator->Initialize(12345); // Seed
+        m_terrainGenerator->Initialize(worldSeed);
 
         // Initialize chunk renderer
         m_chunkRenderer = std::make_unique<ChunkRenderer>();
@@ -182,6 +187,15 @@ namespace MinecraftClone
             return false;
         }
 
+        // Initialize far-horizon renderer (heightmap-only terrain beyond the render distance)
+        m_horizonRenderer = std::make_unique<HorizonRenderer>();
+        if (!m_horizonRenderer->Initialize(m_terrainGenerator.get()))
+        {
+            spdlog::error("Failed to initialize horizon renderer!");
+            return false;
+        }
+        m_horizonRenderer->SetLodDistance(24);  // 24 chunks horizon distance
+
         m_remotePlayerRenderer = std::make_unique<RemotePlayerRenderer>();
         if (!m_remotePlayerRenderer->Initialize())
         {
@@ -204,9 +218,26 @@ namespace MinecraftClone
         m_chunkManager->SetPhysicsManager(m_physicsManager.get());
         m_chunkManager->SetRenderDistance(8);  // 8 chunks render distance
 
+        // Use chunks pre-generated by WorldPregen if a world with the same seed exists
+        m_worldStorage = std::make_unique<WorldStorage>();
+        int storedSeed = 0;
+        bool storedSkyLight = false;
+        if (m_worldStorage->Open("world", false) && m_worldStorage->LoadMetadata(storedSeed, storedSkyLight) &&
+            storedSeed == worldSeed)
+        {
+            m_chunkManager->SetWorldStorage(m_worldStorage.get());
+            spdlog::info("Loading pre-generated chunks from world/");
+        }
+
+        // Initialize block ticks (falling sand/gravel, flowing water)
+        m_blockTickScheduler = std::make_unique<BlockTickScheduler>();
+        m_blockTickScheduler->Initialize(m_world.get(), 2);  // Chunk workers already use 2 threads
+        m_chunkManager->SetBlockTickScheduler(m_blockTickScheduler.get());
+
         // Initialize block interaction
         m_blockInteraction = std::make_unique<BlockInteraction>();
         m_blockInteraction->Initialize(m_world.get(), m_chunkRenderer.get(), m_chunkManager.get());
+        m_blockInteraction->SetBlockTickScheduler(m_blockTickScheduler.get());
         // Block type will be set by InitializeHotbar() later
 
         // Initialize yojimbo
@@ -233,6 +264,8 @@ namespace MinecraftClone
         // Wire world / renderer into network manager so it can apply block updates
         m_networkManager->SetWorld(m_world.get());
         m_networkManager->SetChunkRenderer(m_chunkRenderer.get());
+        m_networkManager->SetChunkManager(m_chunkManager.get());
+        m_networkManager->SetBlockTickScheduler(m_blockTickScheduler.get());
 
         // Set network manager in block interaction (so local edits can send updates)
         m_blockInteraction->SetNetworkManager(m_networkManager.get());
@@ -355,6 +388,43 @@ namespace MinecraftClone
             }
         }
 
+        // Run fixed-rate block ticks and remesh the sections they changed, like block edits; collision
+        // only where a solid block moved, one chunk per frame through the chunk manager's physics queue.
+        // Only the world with authority (single player or host) simulates; the host sends the changed
+        // blocks to its clients, which apply them as block updates instead of ticking themselves
+        if (m_blockTickScheduler && m_world && (!m_networkManager || m_networkManager->HasWorldAuthority()))
+        {
+            m_blockTickScheduler->Update(deltaTime);
+
+            std::vector<glm::ivec3> changedBlocks;
+            m_blockTickScheduler->TakeChangedBlocks(changedBlocks);
+            if (m_networkManager && m_networkManager->IsServerRunning())
+            {
+                m_networkManager->BroadcastTickedBlocks(changedBlocks);
+            }
+            for (const glm::ivec3& block : changedBlocks)
+            {
+                if (m_chunkManager)
+                {
+                    m_chunkManager->RequestBlockRemesh(block.x, block.y, block.z);
+                }
+                else if (m_chunkRenderer)
+                {
+                    m_chunkRenderer->UpdateBlock(block.x, block.y, block.z, m_world.get());
+                }
+            }
+
+            std::vector<std::pair<int, int>> collisionChunks;
+            m_blockTickScheduler->TakeCollisionChangedChunks(collisionChunks);
+            for (const auto& chunkCoord : collisionChunks)
+            {
+                if (m_chunkManager)
+                {
+                    m_chunkManager->RequestCollisionRebuild(chunkCoord.first, chunkCoord.second);
+                }
+            }
+        }
+
         // Update camera
         if (m_camera)
         {
@@ -364,6 +434,12 @@ namespace MinecraftClone
             if (m_chunkManager)
             {
                 m_chunkManager->Update(m_camera->GetPosition(), deltaTime);
+
+                // Update horizon tiles beyond the render distance
+                if (m_horizonRenderer)
+                {
+                    m_horizonRenderer->Update(m_camera->GetPosition(), m_chunkManager->GetRenderDistance());
+                }
             }
 
             // Update block interaction (raycast)
@@ -385,6 +461,11 @@ namespace MinecraftClone
                 m_chunkRenderer->RenderChunks(m_camera->GetViewMatrix(), m_camera->GetProjectionMatrix());
             }
 
+            if (m_horizonRenderer)
+            {
+                m_horizonRenderer->Render(m_camera->GetViewMatrix(), m_camera->GetProjectionMatrix());
+            }
+
             // Keep test cube for now (can remove later)
             if (m_testCube)
             {
@@ -446,6 +527,44 @@ namespace MinecraftClone
                 ImGui::Text("Chunk Manager: Active");
             }
 
+            if (m_chunkRenderer)
+            {
+                bool greedy = ChunkMeshGenerator::GetMeshingMode() == MeshingMode::Greedy;
+                ImGui::Text("Meshing: %s (F4)", greedy ? "Greedy" : "Naive");
+                ImGui::Text("Section Meshes: %zu (%zu chunks)", m_chunkRenderer->GetMeshCount(), m_chunkRenderer->GetChunkCount());
+                ImGui::Text("Faces: %zu", m_chunkRenderer->GetTotalFaceCount());
+                ImGui::Text("LOD (F5): %s, %zu faces", ChunkMeshGenerator::IsLodEnabled() ? "On" : "Off",
+                            m_chunkRenderer->GetTotalLodFaceCount());
+                ImGui::Text("Mesh GPU Memory: %.2f MB", static_cast<double>(m_chunkRenderer->GetTotalUploadSize()) / (1024.0 * 1024.0));
+                if (m_chunkRenderer->IsArenaEnabled())
+                {
+                    const FreeListAllocator::Stats arena = m_chunkRenderer->GetArenaStats();
+                    ImGui::Text("Geometry Arena: %.1f / %.0f MB, %u free blocks, %.1f%% fragmented",
+                                static_cast<double>(arena.used) * sizeof(ChunkFace) / (1024.0 * 1024.0),
+                                static_cast<double>(arena.capacity) * sizeof(ChunkFace) / (1024.0 * 1024.0),
+                                arena.freeBlocks, arena.GetFragmentation() * 100.0f);
+                    if (arena.failedAllocations > 0)
+                    {
+                        ImGui::Text("Arena Full: %zu meshes in own buffers", arena.failedAllocations);
+                    }
+                }
+                ImGui::Text("Cave Culling (F6): %s, %d sections hidden", m_chunkRenderer->IsCaveCulling() ? "On" : "Off",
+                            m_chunkRenderer->GetLastCaveCulledSections());
+                const OcclusionStats& occlusion = m_chunkRenderer->GetOcclusionStats();
+                ImGui::Text("Occlusion Culling (F7): %s, %zu of %zu tested hidden, %.2f ms", m_chunkRenderer->IsOcclusionCulling() ? "On" : "Off",
+                            occlusion.culled, occlusion.tests, occlusion.rasterizeMs);
+                const ChunkRenderer::RenderTimings& renderTimings = m_chunkRenderer->GetLastRenderTimings();
+                ImGui::Text("Render CPU: %.2f ms (cull %.2f, submit %.2f)", renderTimings.cullMs + renderTimings.submitMs,
+                            renderTimings.cullMs, renderTimings.submitMs);
+                if (m_chunkManager)
+                {
+                    ImGui::Text("Edit Remesh: %.2f ms to visible, %zu pending", m_chunkManager->GetLastRemeshLatencyMs(),
+                                m_chunkManager->GetPendingRemeshCount());
+                    ImGui::Text("Border Refresh: %zu chunks, %zu sections", m_chunkManager->GetBorderRefreshCount(),
+                                m_chunkManager->GetBorderRefreshSectionCount());
+                }
+            }
+
             ImGui::Separator();
 
             // Networking Info
@@ -480,6 +599,10 @@ namespace MinecraftClone
             ImGui::BulletText("F1 - Start Server");
             ImGui::BulletText("F2 - Connect as Client");
             ImGui::BulletText("F3 - Disconnect/Stop");
+            ImGui::BulletText("F4 - Toggle Greedy Meshing");
+            ImGui::BulletText("F5 - Toggle LOD Meshes");
+            ImGui::BulletText("F6 - Toggle Cave Culling");
+            ImGui::BulletText("F7 - Toggle Occlusion Culling");
             ImGui::BulletText("Left Click - Break Block");
             ImGui::BulletText("Right Click - Place Block");
 
@@ -654,6 +777,12 @@ namespace MinecraftClone
             m_chunkManager.reset();
         }
 
+        if (m_blockTickScheduler)
+        {
+            m_blockTickScheduler->Shutdown();
+            m_blockTickScheduler.reset();
+        }
+
         if (m_physicsManager)
         {
             m_physicsManager->Shutdown();
@@ -666,6 +795,12 @@ namespace MinecraftClone
             m_remotePlayerRenderer.reset();
         }
 
+        if (m_horizonRenderer)
+        {
+            m_horizonRenderer->Shutdown();
+            m_horizonRenderer.reset();
+        }
+
         if (m_chunkRenderer)
         {
             m_chunkRenderer->Shutdown();
@@ -833,6 +968,42 @@ namespace MinecraftClone
                     }
                 }
             }
+            // F4 - Toggle naive / greedy meshing and rebuild loaded chunks
+            else if (keyEvent.GetKey() == GLFW_KEY_F4)
+            {
+                MeshingMode mode = ChunkMeshGenerator::GetMeshingMode() == MeshingMode::Greedy
+                    ? MeshingMode::Naive : MeshingMode::Greedy;
+                ChunkMeshGenerator::SetMeshingMode(mode);
+                spdlog::info("Meshing mode: {}", mode == MeshingMode::Greedy ? "Greedy" : "Naive");
+
+                if (m_chunkManager)
+                {
+                    m_chunkManager->RemeshAllChunks();
+                }
+            }
+            // F5 - Toggle downsampled meshes for distant chunks and rebuild loaded chunks
+            else if (keyEvent.GetKey() == GLFW_KEY_F5)
+            {
+                ChunkMeshGenerator::SetLodEnabled(!ChunkMeshGenerator::IsLodEnabled());
+                spdlog::info("LOD meshes: {}", ChunkMeshGenerator::IsLodEnabled() ? "On" : "Off");
+
+                if (m_chunkManager)
+                {
+                    m_chunkManager->RemeshAllChunks();
+                }
+            }
+            // F6 - Toggle cave culling (section connectivity is always computed, so no remesh)
+            else if (keyEvent.GetKey() == GLFW_KEY_F6 && m_chunkRenderer)
+            {
+                m_chunkRenderer->SetCaveCulling(!m_chunkRenderer->IsCaveCulling());
+                spdlog::info("Cave culling: {}", m_chunkRenderer->IsCaveCulling() ? "On" : "Off");
+            }
+            // F7 - Toggle software occlusion culling
+            else if (keyEvent.GetKey() == GLFW_KEY_F7 && m_chunkRenderer)
+            {
+                m_chunkRenderer->SetOcclusionCulling(!m_chunkRenderer->IsOcclusionCulling());
+                spdlog::info("Occlusion culling: {}", m_chunkRenderer->IsOcclusionCulling() ? "On" : "Off");
+            }
         }
         else if (event.GetEventType() == EventType::MouseScrolled)
         {
@@ -1037,8 +1208,12 @@ namespace MinecraftClone
 
                 Chunk* chunk = m_world->GetOrCreateChunk(worldChunkX, worldChunkZ);
 
-                // Generate terrain for this chunk
-                m_terrainGenerator->GenerateChunk(chunk, worldChunkX, worldChunkZ, m_world.get());
+                // Generate terrain for this chunk (unless it was pre-generated)
+                WorldStorage* storage = m_chunkManager ? m_chunkManager->GetWorldStorage() : nullptr;
+                if (!storage || !storage->LoadChunk(*chunk, worldChunkX, worldChunkZ))
+                {
+                    m_terrainGenerator->GenerateChunk(chunk, worldChunkX, worldChunkZ, m_world.get());
+                }
 
                 // Update mesh
                 m_chunkRenderer->UpdateChunk(chunk, worldChunkX, worldChunkZ, m_world.get());
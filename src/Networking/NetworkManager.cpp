@@ -10,6 +10,8 @@
 #include "World/World.h"
 #include "World/Chunk.h"
 #include "World/ChunkRenderer.h"
+#include "World/ChunkManager.h"
+#include "World/BlockTickScheduler.h"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <cstring>
@@ -19,6 +21,17 @@ namespace MinecraftClone
 {
     const uint8_t NetworkManager::DEFAULT_PRIVATE_KEY[32] = { 0 };
 
+    namespace
+    {
+        // One key per block position (x and z within +-8M blocks, y within a chunk column)
+        uint64_t BlockKey(const glm::ivec3& block)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(block.x)) << 32)
+                 | (static_cast<uint64_t>(static_cast<uint32_t>(block.z) & 0xFFFFFFu) << 8)
+                 | static_cast<uint64_t>(block.y & 0xFF);
+        }
+    }
+
     NetworkManager::NetworkManager()
         : m_isServer(false)
         , m_localPlayerId(0)
@@ -87,6 +100,7 @@ namespace MinecraftClone
             m_playerPositions.clear();
             m_clientChunksSent.clear();
             m_clientChunkQueue.clear();  // Clear queues
+            m_clientBlockQueue.clear();
             spdlog::info("Server stopped");
         }
     }
@@ -179,6 +193,11 @@ namespace MinecraftClone
 
                 // Process chunk queue for this client
                 ProcessChunkQueue(i);
+                ProcessBlockUpdateQueue(i);
+            }
+            else
+            {
+                m_clientBlockQueue.erase(i);
             }
         }
 
@@ -382,7 +401,14 @@ namespace MinecraftClone
                         // If all 16 slices received, update mesh
                         if (m_clientChunkSlicesReceived[chunkKey].all())
                         {
-                            m_chunkRenderer->UpdateChunk(chunk, sliceMsg->chunkX, sliceMsg->chunkZ, m_world);
+                            if (m_chunkManager)
+                            {
+                                m_chunkManager->RequestChunkRemesh(sliceMsg->chunkX, sliceMsg->chunkZ);
+                            }
+                            else
+                            {
+                                m_chunkRenderer->UpdateChunk(chunk, sliceMsg->chunkX, sliceMsg->chunkZ, m_world);
+                            }
                             m_clientChunkSlicesReceived.erase(chunkKey);  // Clean up
                             spdlog::info("Completed chunk ({}, {}) - mesh updated", sliceMsg->chunkX, sliceMsg->chunkZ);
                         }
@@ -518,40 +544,23 @@ namespace MinecraftClone
             m_world->SetBlock(x, y, z, BlockType::Air);
         }
 
-        // Figure out which chunk this block belongs to
-        auto chunkCoords = World::GetChunkCoords(x, z);
-        Chunk* chunk = m_world->GetChunk(chunkCoords.first, chunkCoords.second);
-        if (!chunk)
+        // Remote edits wake sand, gravel and water around them, as local edits do in BlockInteraction
+        // (on a client the ticks only run once it is back on its own world; until then the host's
+        // results arrive here as block updates)
+        if (m_blockTickScheduler)
         {
-            return;
+            m_blockTickScheduler->NotifyBlockChanged(x, y, z);
         }
 
-        // Update this chunk's mesh
-        m_chunkRenderer->UpdateChunk(chunk, chunkCoords.first, chunkCoords.second, m_world);
-
-        // Optionally: also update adjacent chunks if on a border (same logic as BlockInteraction::MarkChunkForUpdate)
-        glm::ivec3 local = World::GetLocalCoords(x, y, z);
-
-        struct Offset { int dx, dz; };
-        std::vector<Offset> neighborOffsets;
-
-        const int kChunkSizeX = CHUNK_SIZE_X;
-        const int kChunkSizeZ = CHUNK_SIZE_Z;
-
-        if (local.x == 0)                   neighborOffsets.push_back({ -1,  0 });
-        if (local.x == kChunkSizeX - 1)     neighborOffsets.push_back({  1,  0 });
-        if (local.z == 0)                   neighborOffsets.push_back({  0, -1 });
-        if (local.z == kChunkSizeZ - 1)     neighborOffsets.push_back({  0,  1 });
-
-        for (const auto& o : neighborOffsets)
+        // Rebuild the edited section and the sections across any face it touches (same as BlockInteraction);
+        // queued so a burst of block messages is coalesced into one remesh per chunk
+        if (m_chunkManager)
         {
-            int adjChunkX = chunkCoords.first  + o.dx;
-            int adjChunkZ = chunkCoords.second + o.dz;
-            Chunk* adjChunk = m_world->GetChunk(adjChunkX, adjChunkZ);
-            if (adjChunk)
-            {
-                m_chunkRenderer->UpdateChunk(adjChunk, adjChunkX, adjChunkZ, m_world);
-            }
+            m_chunkManager->RequestBlockRemesh(x, y, z);
+        }
+        else
+        {
+            m_chunkRenderer->UpdateBlock(x, y, z, m_world);
         }
     }
 
@@ -630,6 +639,92 @@ namespace MinecraftClone
         }
     }
 
+    void NetworkManager::BroadcastTickedBlocks(const std::vector<glm::ivec3>& blocks)
+    {
+        if (!m_isServer || !m_server || blocks.empty())
+        {
+            return;
+        }
+
+        const int MAX_PLAYERS = 64;
+        for (int clientIndex = 0; clientIndex < MAX_PLAYERS; ++clientIndex)
+        {
+            if (!m_server->IsClientConnected(clientIndex))
+            {
+                continue;
+            }
+
+            // Chunks not sent yet carry the ticked blocks in their slices (read when each slice goes out)
+            auto sentIt = m_clientChunksSent.find(clientIndex);
+            if (sentIt == m_clientChunksSent.end())
+            {
+                continue;
+            }
+
+            PendingBlockUpdates& pending = m_clientBlockQueue[clientIndex];
+            for (const glm::ivec3& block : blocks)
+            {
+                if (sentIt->second.count(World::GetChunkCoords(block.x, block.z)) != 0 && pending.queued.insert(BlockKey(block)).second)
+                {
+                    pending.blocks.push(block);
+                }
+            }
+        }
+    }
+
+    void NetworkManager::ProcessBlockUpdateQueue(int clientIndex)
+    {
+        auto queueIt = m_clientBlockQueue.find(clientIndex);
+        if (queueIt == m_clientBlockQueue.end() || !m_world)
+        {
+            return;
+        }
+
+        // Like chunk slices: a bounded number per frame, and only while the reliable channel has room
+        const int MAX_BLOCK_UPDATES_PER_FRAME = 256;
+        PendingBlockUpdates& pending = queueIt->second;
+        int sent = 0;
+
+        while (!pending.blocks.empty() && sent < MAX_BLOCK_UPDATES_PER_FRAME
+               && m_server->CanSendMessage(clientIndex, (int)GameChannel::RELIABLE))
+        {
+            glm::ivec3 block = pending.blocks.front();
+            auto chunkCoords = World::GetChunkCoords(block.x, block.z);
+            if (!m_world->GetChunk(chunkCoords.first, chunkCoords.second))
+            {
+                // Unloaded on the server since; its blocks are unknown here, not air
+                pending.blocks.pop();
+                pending.queued.erase(BlockKey(block));
+                continue;
+            }
+
+            BlockUpdateMessage* outMsg =
+                (BlockUpdateMessage*)m_server->CreateMessage(clientIndex, (int)GameMessageType::BLOCK_UPDATE);
+            if (!outMsg)
+            {
+                break;  // Try again next frame
+            }
+
+            pending.blocks.pop();
+            pending.queued.erase(BlockKey(block));
+
+            BlockType type = static_cast<const World*>(m_world)->GetBlock(block.x, block.y, block.z).GetType();
+            outMsg->blockX      = block.x;
+            outMsg->blockY      = block.y;
+            outMsg->blockZ      = block.z;
+            outMsg->blockType   = static_cast<uint8_t>(type);
+            outMsg->isPlacement = type != BlockType::Air;
+
+            m_server->SendMessage(clientIndex, (int)GameChannel::RELIABLE, outMsg);
+            sent++;
+        }
+
+        if (pending.blocks.empty())
+        {
+            m_clientBlockQueue.erase(queueIt);
+        }
+    }
+
     void NetworkManager::SendChunkToClient(int clientIndex, int chunkX, int chunkZ)
     {
         if (!m_server || !m_server->IsClientConnected(clientIndex) || !m_world)
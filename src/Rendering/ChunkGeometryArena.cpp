@@ -0,0 +1,256 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "Rendering/ChunkGeometryArena.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <iterator>
+
+namespace MinecraftClone
+{
+    void FreeListAllocator::Reset(uint32_t capacity)
+    {
+        m_freeByOffset.clear();
+        m_freeBySize.clear();
+        m_capacity = capacity;
+        m_used = 0;
+        m_allocations = 0;
+        m_failedAllocations = 0;
+        if (capacity > 0)
+        {
+            InsertFree(0, capacity);
+        }
+    }
+
+    uint32_t FreeListAllocator::Allocate(uint32_t size)
+    {
+        if (size == 0)
+        {
+            return INVALID_OFFSET;
+        }
+
+        // Best fit: the smallest free block that holds size, so large holes stay whole
+        auto fit = m_freeBySize.lower_bound(size);
+        if (fit == m_freeBySize.end())
+        {
+            m_failedAllocations++;
+            return INVALID_OFFSET;
+        }
+
+        const uint32_t offset = fit->second;
+        const uint32_t blockSize = fit->first;
+        EraseFree(m_freeByOffset.find(offset));
+        if (blockSize > size)
+        {
+            InsertFree(offset + size, blockSize - size);
+        }
+
+        m_used += size;
+        m_allocations++;
+        return offset;
+    }
+
+    void FreeListAllocator::Free(uint32_t offset, uint32_t size)
+    {
+        if (size == 0 || offset == INVALID_OFFSET)
+        {
+            return;
+        }
+        m_used -= size;
+        m_allocations--;
+
+        // Merge with the free blocks ending at offset and starting at offset + size
+        auto next = m_freeByOffset.lower_bound(offset);
+        if (next != m_freeByOffset.begin())
+        {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset)
+            {
+                offset = previous->first;
+                size += previous->second;
+                EraseFree(previous);
+            }
+        }
+        if (next != m_freeByOffset.end() && next->first == offset + size)
+        {
+            size += next->second;
+            EraseFree(next);
+        }
+        InsertFree(offset, size);
+    }
+
+    FreeListAllocator::Stats FreeListAllocator::GetStats() const
+    {
+        Stats stats;
+        stats.capacity = m_capacity;
+        stats.used = m_used;
+        stats.freeBlocks = static_cast<uint32_t>(m_freeByOffset.size());
+        stats.largestFreeBlock = m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first;
+        stats.allocations = m_allocations;
+        stats.failedAllocations = m_failedAllocations;
+        return stats;
+    }
+
+    void FreeListAllocator::InsertFree(uint32_t offset, uint32_t size)
+    {
+        m_freeByOffset.emplace(offset, size);
+        m_freeBySize.emplace(size, offset);
+    }
+
+    void FreeListAllocator::EraseFree(std::map<uint32_t, uint32_t>::iterator block)
+    {
+        auto [first, last] = m_freeBySize.equal_range(block->second);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second == block->first)
+            {
+                m_freeBySize.erase(it);
+                break;
+            }
+        }
+        m_freeByOffset.erase(block);
+    }
+
+    ChunkGeometryArena::ChunkGeometryArena()
+        : m_buffer(0), m_faceTexture(0), m_VAO(0), m_mapped(nullptr)
+    {
+    }
+
+    ChunkGeometryArena::~ChunkGeometryArena()
+    {
+        Shutdown();
+    }
+
+    bool ChunkGeometryArena::Initialize(uint32_t capacityFaces)
+    {
+        Shutdown();
+        if (!GLAD_GL_VERSION_4_4)
+        {
+            spdlog::warn("OpenGL 4.4 is not available: chunk meshes keep one buffer each");
+            return false;
+        }
+
+        GLint maxTexels = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+        capacityFaces = std::min(capacityFaces, static_cast<uint32_t>(std::max(maxTexels, 0)));
+        if (capacityFaces == 0)
+        {
+            return false;
+        }
+
+        // OPTIMIZATION 14: Chunk geometry arena
+        // Immutable storage mapped once for the arena's lifetime: uploads are plain memcpys into the
+        // mapping, and every mesh shares this buffer, its buffer texture and one VAO, so the visible
+        // sections of a layer become one glMultiDrawArraysIndirect with no per-mesh binds.
+        const GLsizeiptr size = static_cast<GLsizeiptr>(capacityFaces) * static_cast<GLsizeiptr>(sizeof(ChunkFace));
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &m_buffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_buffer);
+        glBufferStorage(GL_TEXTURE_BUFFER, size, nullptr, flags);
+        m_mapped = static_cast<ChunkFace*>(glMapBufferRange(GL_TEXTURE_BUFFER, 0, size, flags));
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        if (!m_mapped)
+        {
+            spdlog::error("Failed to map the chunk geometry arena ({} MiB)", size >> 20);
+            Shutdown();
+            return false;
+        }
+
+        glGenTextures(1, &m_faceTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, m_faceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_buffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glGenVertexArrays(1, &m_VAO);
+
+        m_allocator.Reset(capacityFaces);
+        spdlog::info("Chunk geometry arena: {} faces ({} MiB), persistently mapped", capacityFaces, size >> 20);
+        return true;
+    }
+
+    void ChunkGeometryArena::Shutdown()
+    {
+        for (RetiredRanges& retired : m_retired)
+        {
+            glDeleteSync(retired.fence);
+        }
+        m_retired.clear();
+        m_pendingFrees.clear();
+
+        if (m_mapped)
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, m_buffer);
+            glUnmapBuffer(GL_TEXTURE_BUFFER);
+            glBindBuffer(GL_TEXTURE_BUFFER, 0);
+            m_mapped = nullptr;
+        }
+        if (m_VAO != 0)
+        {
+            glDeleteVertexArrays(1, &m_VAO);
+            m_VAO = 0;
+        }
+        if (m_faceTexture != 0)
+        {
+            glDeleteTextures(1, &m_faceTexture);
+            m_faceTexture = 0;
+        }
+        if (m_buffer != 0)
+        {
+            glDeleteBuffers(1, &m_buffer);
+            m_buffer = 0;
+        }
+        m_allocator.Reset(0);
+    }
+
+    uint32_t ChunkGeometryArena::Allocate(uint32_t faceCount)
+    {
+        if (!IsInitialized())
+        {
+            return FreeListAllocator::INVALID_OFFSET;
+        }
+        return m_allocator.Allocate(faceCount);
+    }
+
+    void ChunkGeometryArena::Free(uint32_t offset, uint32_t faceCount)
+    {
+        if (IsInitialized() && offset != FreeListAllocator::INVALID_OFFSET)
+        {
+            m_pendingFrees.emplace_back(offset, faceCount);
+        }
+    }
+
+    void ChunkGeometryArena::EndFrame()
+    {
+        if (!IsInitialized())
+        {
+            return;
+        }
+
+        ReclaimCompleted();
+        if (!m_pendingFrees.empty())
+        {
+            m_retired.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), std::move(m_pendingFrees) });
+            m_pendingFrees.clear();
+        }
+    }
+
+    void ChunkGeometryArena::ReclaimCompleted()
+    {
+        // Fences signal in submission order: stop at the first frame still in flight, without waiting
+        while (!m_retired.empty())
+        {
+            RetiredRanges& oldest = m_retired.front();
+            const GLenum status = glClientWaitSync(oldest.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+            for (const Range& range : oldest.ranges)
+            {
+                m_allocator.Free(range.first, range.second);
+            }
+            glDeleteSync(oldest.fence);
+            m_retired.pop_front();
+        }
+    }
+}
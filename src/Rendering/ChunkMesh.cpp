@@ -3,12 +3,78 @@
  */
 
 #include "Rendering/ChunkMesh.h"
-#include "Rendering/Shader.h"
+#include "Rendering/ChunkGeometryArena.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <utility>
 
 namespace MinecraftClone
 {
-    ChunkMesh::ChunkMesh() : m_VAO(0), m_VBO(0), m_EBO(0), m_isBuilt(false)
+    namespace
+    {
+        // Quad geometry per face direction (0=+Z, 1=-Z, 2=-X, 3=+X, 4=+Y, 5=-Y). A quad spans
+        // origin block + FACE_BASE + u * width * FACE_U + v * height * FACE_V for u, v in [0, 1];
+        // vertices v0..v3 sit at the (u, v) corners FACE_CORNERS lists. Mirrored in the vertex shader.
+        const glm::vec3 FACE_NORMALS[6] = {
+            { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { -1.0f, 0.0f, 0.0f },
+            { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }
+        };
+        const glm::vec3 FACE_BASE[6] = {
+            { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f },
+            { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }
+        };
+        const glm::vec3 FACE_U[6] = {
+            { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+            { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }
+        };
+        const glm::vec3 FACE_V[6] = {
+            { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }
+        };
+        const glm::ivec2 FACE_CORNERS[6][4] = {
+            { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } },
+            { { 1, 0 }, { 0, 0 }, { 0, 1 }, { 1, 1 } },
+            { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } },
+            { { 1, 0 }, { 0, 0 }, { 0, 1 }, { 1, 1 } },
+            { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 1, 0 } },
+            { { 0, 1 }, { 0, 0 }, { 1, 0 }, { 1, 1 } }
+        };
+
+        // Quad corner of each of the six emitted vertices, counted from the diagonal's first corner
+        const int TRIANGLE_CORNERS[6] = { 0, 1, 2, 2, 3, 0 };
+
+        struct DecodedFace
+        {
+            glm::vec3 cell;   // Origin block relative to the mesh origin
+            int direction;
+            float width;
+            float height;
+        };
+
+        inline int GetDirection(const ChunkFace& face)
+        {
+            return static_cast<int>(face.placement >> 16 & 7u);
+        }
+
+        inline DecodedFace Decode(const ChunkFace& face)
+        {
+            DecodedFace decoded;
+            decoded.cell = glm::vec3(static_cast<float>(face.placement & 15u),
+                                     static_cast<float>(face.placement >> 8 & 255u),
+                                     static_cast<float>(face.placement >> 4 & 15u));
+            decoded.direction = GetDirection(face);
+            decoded.width = static_cast<float>((face.placement >> 19 & 15u) + 1u);
+            decoded.height = static_cast<float>((face.placement >> 23 & 255u) + 1u);
+            return decoded;
+        }
+    }
+
+    ChunkMesh::ChunkMesh()
+        : m_directionCounts{}, m_isGrouped{ true, true, true }, m_layerOffsets{}, m_origin(0), m_boundsMin(INT_MAX),
+          m_boundsMax(INT_MIN), m_VAO(0), m_faceBuffer(0),
+          m_faceTexture(0), m_arena(nullptr), m_arenaOffset(0), m_arenaFaceCount(0), m_isBuilt(false)
     {
     }
 
@@ -17,230 +83,505 @@ namespace MinecraftClone
         Shutdown();
     }
 
+    const char* ChunkMesh::GetVertexShaderSource()
+    {
+        // OPTIMIZATION 10: Vertex pulling
+        // No vertex attributes: each face is two 32-bit words in a buffer texture, and every vertex
+        // decodes its face (gl_VertexID / 6) and its corner (gl_VertexID % 6) itself. A face costs
+        // 8 bytes instead of four 36-byte vertices plus six 4-byte indices (168 bytes).
+        // The mesh origin is the only attribute: constant for a single draw, per draw in an indirect batch.
+        return R"(
+#version 330 core
+layout(location = 0) in vec3 chunkOrigin;
+uniform usamplerBuffer faces;
+layout(std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 viewPos;
+};
+
+out vec2 TexCoord;
+out vec3 Normal;
+out vec3 FragPos;
+out float AO;
+flat out uint Tile;
+
+const vec3 FACE_NORMALS[6] = vec3[6](vec3(0, 0, 1), vec3(0, 0, -1), vec3(-1, 0, 0), vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, -1, 0));
+const vec3 FACE_BASE[6] = vec3[6](vec3(0, 0, 1), vec3(0, 0, 0), vec3(0, 0, 0), vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 0));
+const vec3 FACE_U[6] = vec3[6](vec3(1, 0, 0), vec3(1, 0, 0), vec3(0, 0, 1), vec3(0, 0, 1), vec3(1, 0, 0), vec3(1, 0, 0));
+const vec3 FACE_V[6] = vec3[6](vec3(0, 1, 0), vec3(0, 1, 0), vec3(0, 1, 0), vec3(0, 1, 0), vec3(0, 0, 1), vec3(0, 0, 1));
+const ivec2 FACE_CORNERS[24] = ivec2[24](
+    ivec2(0, 0), ivec2(1, 0), ivec2(1, 1), ivec2(0, 1),
+    ivec2(1, 0), ivec2(0, 0), ivec2(0, 1), ivec2(1, 1),
+    ivec2(0, 0), ivec2(1, 0), ivec2(1, 1), ivec2(0, 1),
+    ivec2(1, 0), ivec2(0, 0), ivec2(0, 1), ivec2(1, 1),
+    ivec2(0, 0), ivec2(0, 1), ivec2(1, 1), ivec2(1, 0),
+    ivec2(0, 1), ivec2(0, 0), ivec2(1, 0), ivec2(1, 1));
+const int TRIANGLE_CORNERS[6] = int[6](0, 1, 2, 2, 3, 0);
+
+void main()
+{
+    uvec2 face = texelFetch(faces, gl_VertexID / 6).xy;
+    vec3 cell = vec3(float(face.x & 15u), float((face.x >> 8) & 255u), float((face.x >> 4) & 15u));
+    int direction = int((face.x >> 16) & 7u);
+    float width = float(((face.x >> 19) & 15u) + 1u);
+    float height = float(((face.x >> 23) & 255u) + 1u);
+    uint ao = (face.y >> 16) & 255u;
+
+    // AO of v0..v3; split along the brighter diagonal like the CPU mesher did
+    uint vertexAO[4];
+    for (int i = 0; i < 4; i++)
+    {
+        ivec2 corner = FACE_CORNERS[direction * 4 + i];
+        int aoCorner = corner.y == 0 ? corner.x : 3 - corner.x;
+        vertexAO[i] = (ao >> uint(2 * aoCorner)) & 3u;
+    }
+    int first = (vertexAO[0] + vertexAO[2] < vertexAO[1] + vertexAO[3]) ? 1 : 0;
+    int vertex = (first + TRIANGLE_CORNERS[gl_VertexID % 6]) % 4;
+
+    ivec2 corner = FACE_CORNERS[direction * 4 + vertex];
+    vec3 local = cell + FACE_BASE[direction] + FACE_U[direction] * (width * float(corner.x))
+               + FACE_V[direction] * (height * float(corner.y));
+
+    FragPos = chunkOrigin + local;
+    Normal = FACE_NORMALS[direction];
+    TexCoord = vec2((vertex == 1 || vertex == 2) ? width : 0.0, vertex >= 2 ? height : 0.0);
+    Tile = face.y & 0xFFFFu;
+    AO = float(vertexAO[vertex]) / 3.0;  // Baked per-vertex ambient occlusion, 1 = open
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
+)";
+    }
+
+    void ChunkMesh::BindFrameData(GLuint program)
+    {
+        const GLuint blockIndex = glGetUniformBlockIndex(program, "FrameData");
+        if (blockIndex != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(program, blockIndex, FRAME_DATA_BINDING);
+        }
+    }
+
+    uint8_t ChunkMesh::GetFacingDirections(const glm::vec3& cameraPosition, const glm::vec3& boxMin, const glm::vec3& boxMax)
+    {
+        // A face is front-facing when the camera is on its normal's side of its plane; every plane of
+        // one direction lies inside the box, so a whole direction faces away once the camera is past
+        // the box on the other side
+        uint8_t directions = 0;
+        directions |= (cameraPosition.z > boxMin.z) ? 1u << 0 : 0u;  // +Z
+        directions |= (cameraPosition.z < boxMax.z) ? 1u << 1 : 0u;  // -Z
+        directions |= (cameraPosition.x < boxMax.x) ? 1u << 2 : 0u;  // -X
+        directions |= (cameraPosition.x > boxMin.x) ? 1u << 3 : 0u;  // +X
+        directions |= (cameraPosition.y > boxMin.y) ? 1u << 4 : 0u;  // +Y
+        directions |= (cameraPosition.y < boxMax.y) ? 1u << 5 : 0u;  // -Y
+        return directions;
+    }
+
     void ChunkMesh::Clear()
     {
-        m_vertices.clear();
-        m_indices.clear();
+        for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            m_faces[layer].clear();
+            std::fill(std::begin(m_directionCounts[layer]), std::end(m_directionCounts[layer]), 0u);
+            m_isGrouped[layer] = true;
+        }
+        m_boundsMin = glm::ivec3(INT_MAX);
+        m_boundsMax = glm::ivec3(INT_MIN);
         m_isBuilt = false;
     }
 
-    void ChunkMesh::AddFace(const glm::vec3& position, const glm::vec2& texCoord0, const glm::vec2& texCoord1,
-        const glm::vec2& texCoord2, const glm::vec2& texCoord3, const glm::vec3& normal, int faceIndex)
-    {
-        // Define the 4 vertices of a quad face
-        // Face indices: 0=front, 1=back, 2=left, 3=right, 4=top, 5=bottom
-        glm::vec3 v0, v1, v2, v3;
-
-        switch (faceIndex)
-        {
-            case 0: // Front face (+Z)
-                v0 = position + glm::vec3(0.0f, 0.0f, 1.0f);
-                v1 = position + glm::vec3(1.0f, 0.0f, 1.0f);
-                v2 = position + glm::vec3(1.0f, 1.0f, 1.0f);
-                v3 = position + glm::vec3(0.0f, 1.0f, 1.0f);
-                break;
-            case 1: // Back face (-Z)
-                v0 = position + glm::vec3(1.0f, 0.0f, 0.0f);
-                v1 = position + glm::vec3(0.0f, 0.0f, 0.0f);
-                v2 = position + glm::vec3(0.0f, 1.0f, 0.0f);
-                v3 = position + glm::vec3(1.0f, 1.0f, 0.0f);
-                break;
-            case 2: // Left face (-X)
-                v0 = position + glm::vec3(0.0f, 0.0f, 0.0f);
-                v1 = position + glm::vec3(0.0f, 0.0f, 1.0f);
-                v2 = position + glm::vec3(0.0f, 1.0f, 1.0f);
-                v3 = position + glm::vec3(0.0f, 1.0f, 0.0f);
-                break;
-            case 3: // Right face (+X)
-                v0 = position + glm::vec3(1.0f, 0.0f, 1.0f);
-                v1 = position + glm::vec3(1.0f, 0.0f, 0.0f);
-                v2 = position + glm::vec3(1.0f, 1.0f, 0.0f);
-                v3 = position + glm::vec3(1.0f, 1.0f, 1.0f);
-                break;
-            case 4: // Top face (+Y)
-                v0 = position + glm::vec3(0.0f, 1.0f, 0.0f);
-                v1 = position + glm::vec3(0.0f, 1.0f, 1.0f);
-                v2 = position + glm::vec3(1.0f, 1.0f, 1.0f);
-                v3 = position + glm::vec3(1.0f, 1.0f, 0.0f);
-                break;
-            case 5: // Bottom face (-Y)
-                v0 = position + glm::vec3(0.0f, 0.0f, 1.0f);
-                v1 = position + glm::vec3(0.0f, 0.0f, 0.0f);
-                v2 = position + glm::vec3(1.0f, 0.0f, 0.0f);
-                v3 = position + glm::vec3(1.0f, 0.0f, 1.0f);
-                break;
-            default:
-                return;
+    void ChunkMesh::Reserve(size_t quadCount)
+    {
+        // Most faces are opaque
+        std::vector<ChunkFace>& faces = m_faces[static_cast<size_t>(RenderLayer::Opaque)];
+        faces.reserve(faces.size() + quadCount);
+    }
+
+    void ChunkMesh::CopyGeometry(const ChunkMesh& source)
+    {
+        // Fresh vectors sized exactly; assign() on this mesh's own vectors could keep spare capacity
+        for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            m_faces[layer] = std::vector<ChunkFace>(source.m_faces[layer].begin(), source.m_faces[layer].end());
+            std::copy(std::begin(source.m_directionCounts[layer]), std::end(source.m_directionCounts[layer]),
+                      std::begin(m_directionCounts[layer]));
+            m_isGrouped[layer] = source.m_isGrouped[layer];
         }
+        m_origin = source.m_origin;
+        m_boundsMin = source.m_boundsMin;
+        m_boundsMax = source.m_boundsMax;
+        m_isBuilt = false;
+    }
 
-        unsigned int baseIndex = static_cast<unsigned int>(m_vertices.size());
-
-        m_vertices.push_back({v0, texCoord0, normal});
-        m_vertices.push_back({v1, texCoord1, normal});
-        m_vertices.push_back({v2, texCoord2, normal});
-        m_vertices.push_back({v3, texCoord3, normal});
-
-        // Add indices for two triangles
-        m_indices.push_back(baseIndex + 0);
-        m_indices.push_back(baseIndex + 1);
-        m_indices.push_back(baseIndex + 2);
-        m_indices.push_back(baseIndex + 2);
-        m_indices.push_back(baseIndex + 3);
-        m_indices.push_back(baseIndex + 0);
-    }
-
-    void ChunkMesh::AddQuad(const glm::vec3& position, float width, float height, const glm::vec3& normal, int faceIndex)
-    {
-        // Add a quad of arbitrary size (for greedy meshing)
-        // width and height are in block units (1.0 = 1 block)
-        // Standard UV coordinates (0,0 to width,height for texture tiling)
-        glm::vec2 uv0(0.0f, 0.0f);
-        glm::vec2 uv1(width, 0.0f);
-        glm::vec2 uv2(width, height);
-        glm::vec2 uv3(0.0f, height);
-
-        glm::vec3 v0, v1, v2, v3;
-
-        // Calculate quad vertices based on face direction and size
-        // For each face, we need to map width/height to the correct axes
-        switch (faceIndex)
-        {
-            case 0: // Front face (+Z) - width=X, height=Y
-                v0 = position + glm::vec3(0.0f, 0.0f, 1.0f);
-                v1 = position + glm::vec3(width, 0.0f, 1.0f);
-                v2 = position + glm::vec3(width, height, 1.0f);
-                v3 = position + glm::vec3(0.0f, height, 1.0f);
-                break;
-            case 1: // Back face (-Z) - width=X, height=Y
-                v0 = position + glm::vec3(width, 0.0f, 0.0f);
-                v1 = position + glm::vec3(0.0f, 0.0f, 0.0f);
-                v2 = position + glm::vec3(0.0f, height, 0.0f);
-                v3 = position + glm::vec3(width, height, 0.0f);
-                break;
-            case 2: // Left face (-X) - width=Z, height=Y
-                v0 = position + glm::vec3(0.0f, 0.0f, 0.0f);
-                v1 = position + glm::vec3(0.0f, 0.0f, width);
-                v2 = position + glm::vec3(0.0f, height, width);
-                v3 = position + glm::vec3(0.0f, height, 0.0f);
-                break;
-            case 3: // Right face (+X) - width=Z, height=Y
-                v0 = position + glm::vec3(1.0f, 0.0f, width);
-                v1 = position + glm::vec3(1.0f, 0.0f, 0.0f);
-                v2 = position + glm::vec3(1.0f, height, 0.0f);
-                v3 = position + glm::vec3(1.0f, height, width);
-                break;
-            case 4: // Top face (+Y) - width=X, height=Z
-                v0 = position + glm::vec3(0.0f, 1.0f, 0.0f);
-                v1 = position + glm::vec3(0.0f, 1.0f, height);
-                v2 = position + glm::vec3(width, 1.0f, height);
-                v3 = position + glm::vec3(width, 1.0f, 0.0f);
-                break;
-            case 5: // Bottom face (-Y) - width=X, height=Z
-                v0 = position + glm::vec3(0.0f, 0.0f, height);
-                v1 = position + glm::vec3(0.0f, 0.0f, 0.0f);
-                v2 = position + glm::vec3(width, 0.0f, 0.0f);
-                v3 = position + glm::vec3(width, 0.0f, height);
-                break;
-            default:
-                return;
+    size_t ChunkMesh::GetFaceCount() const
+    {
+        size_t count = 0;
+        for (const auto& faces : m_faces)
+        {
+            count += faces.size();
+        }
+        return count;
+    }
+
+    size_t ChunkMesh::GetFaceCount(RenderLayer layer, uint8_t directions) const
+    {
+        const size_t layerIndex = static_cast<size_t>(layer);
+        if (!IsDrawnByDirection(layerIndex))
+        {
+            return m_faces[layerIndex].size();
+        }
+
+        size_t count = 0;
+        for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+        {
+            count += (directions & (1u << direction)) ? m_directionCounts[layerIndex][direction] : 0u;
+        }
+        return count;
+    }
+
+    void ChunkMesh::AddFace(int x, int y, int z, int faceIndex, uint32_t tile, uint8_t ao, RenderLayer layer)
+    {
+        // A single block face is a 1x1 quad
+        AddQuad(x, y, z, 1, 1, faceIndex, tile, ao, layer);
+    }
+
+    void ChunkMesh::AddQuad(int x, int y, int z, int width, int height, int faceIndex, uint32_t tile, uint8_t ao, RenderLayer layer)
+    {
+        // Add a quad of arbitrary size (for greedy meshing); width and height are in blocks along the
+        // face's u / v axes: +-Z faces width = X, height = Y; +-X faces width = Z, height = Y;
+        // +-Y faces width = X, height = Z
+        if (faceIndex < 0 || faceIndex >= 6 || width < 1 || width > MAX_QUAD_WIDTH || height < 1 || height > MAX_QUAD_HEIGHT)
+        {
+            return;
+        }
+
+        ChunkFace face;
+        face.placement = static_cast<uint32_t>(x & 15) | static_cast<uint32_t>(z & 15) << 4 | static_cast<uint32_t>(y & 255) << 8
+                         | static_cast<uint32_t>(faceIndex) << 16 | static_cast<uint32_t>(width - 1) << 19
+                         | static_cast<uint32_t>(height - 1) << 23;
+        face.material = (tile & 0xFFFFu) | static_cast<uint32_t>(ao) << AO_SHIFT;
+
+        // The meshers emit one direction after another, which keeps each direction contiguous for free
+        const size_t layerIndex = static_cast<size_t>(layer);
+        std::vector<ChunkFace>& faces = m_faces[layerIndex];
+        if (!faces.empty() && GetDirection(faces.back()) > faceIndex)
+        {
+            m_isGrouped[layerIndex] = false;
         }
+        faces.push_back(face);
+        m_directionCounts[layerIndex][faceIndex]++;
+
+        // The blocks the quad lies on: width runs along x except on +-X faces, height along y except on +-Y faces
+        const bool alongZ = (faceIndex == 2 || faceIndex == 3);
+        const bool flat = (faceIndex == 4 || faceIndex == 5);
+        const glm::ivec3 extent(alongZ ? 1 : width, flat ? 1 : height, alongZ ? width : (flat ? height : 1));
+        m_boundsMin = glm::min(m_boundsMin, glm::ivec3(x, y, z));
+        m_boundsMax = glm::max(m_boundsMax, glm::ivec3(x, y, z) + extent);
+    }
 
-        unsigned int baseIndex = static_cast<unsigned int>(m_vertices.size());
+    void ChunkMesh::GroupByDirection(size_t layer)
+    {
+        std::stable_sort(m_faces[layer].begin(), m_faces[layer].end(),
+                         [](const ChunkFace& a, const ChunkFace& b) { return GetDirection(a) < GetDirection(b); });
+        m_isGrouped[layer] = true;
+    }
 
-        m_vertices.push_back({v0, uv0, normal});
-        m_vertices.push_back({v1, uv1, normal});
-        m_vertices.push_back({v2, uv2, normal});
-        m_vertices.push_back({v3, uv3, normal});
+    void ChunkMesh::ExpandVertices(std::vector<Vertex>& vertices, uint8_t directions) const
+    {
+        const glm::vec3 origin(m_origin);
+        for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            const bool byDirection = IsDrawnByDirection(layer);
+            for (const ChunkFace& face : m_faces[layer])
+            {
+                const DecodedFace decoded = Decode(face);
+                const int direction = decoded.direction;
+                if (byDirection && !(directions & (1u << direction)))
+                {
+                    continue;
+                }
+                const uint32_t tile = face.material & 0xFFFFu;
+                const uint32_t ao = face.material >> AO_SHIFT & 0xFFu;
+
+                Vertex corners[4];
+                uint32_t vertexAO[4];
+                for (int i = 0; i < 4; i++)
+                {
+                    const glm::ivec2 corner = FACE_CORNERS[direction][i];
+                    const int aoCorner = corner.y == 0 ? corner.x : 3 - corner.x;
+                    vertexAO[i] = ao >> (2 * aoCorner) & 3u;
+
+                    glm::vec3 local = decoded.cell + FACE_BASE[direction]
+                                      + FACE_U[direction] * (decoded.width * static_cast<float>(corner.x))
+                                      + FACE_V[direction] * (decoded.height * static_cast<float>(corner.y));
+                    glm::vec2 texCoord((i == 1 || i == 2) ? decoded.width : 0.0f, i >= 2 ? decoded.height : 0.0f);
+                    corners[i] = { origin + local, texCoord, FACE_NORMALS[direction], tile | vertexAO[i] << AO_SHIFT };
+                }
+
+                // Two triangles split along v0-v2, or along v1-v3 when that diagonal is brighter: the
+                // darkest corner then stays inside one triangle instead of bleeding along the diagonal
+                const int first = (vertexAO[0] + vertexAO[2] < vertexAO[1] + vertexAO[3]) ? 1 : 0;
+                for (int corner : TRIANGLE_CORNERS)
+                {
+                    vertices.push_back(corners[(first + corner) % 4]);
+                }
+            }
+        }
+    }
 
-        // Add indices for two triangles
-        m_indices.push_back(baseIndex + 0);
-        m_indices.push_back(baseIndex + 1);
-        m_indices.push_back(baseIndex + 2);
-        m_indices.push_back(baseIndex + 2);
-        m_indices.push_back(baseIndex + 3);
-        m_indices.push_back(baseIndex + 0);
+    void ChunkMesh::CopyFacesTo(ChunkFace* destination)
+    {
+        size_t offset = 0;
+        for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            m_layerOffsets[layer] = offset;
+            std::copy(m_faces[layer].begin(), m_faces[layer].end(), destination + offset);
+            offset += m_faces[layer].size();
+        }
     }
 
-    void ChunkMesh::Build()
+    void ChunkMesh::Build(ChunkGeometryArena* arena)
     {
         if (m_isBuilt)
         {
             Shutdown();
         }
 
-        if (m_vertices.empty())
+        const size_t faceCount = GetFaceCount();
+        if (faceCount == 0)
         {
             return;
         }
 
+        // OPTIMIZATION 11: Per-direction face ranges
+        // Opaque and cutout faces are uploaded grouped by direction, so Render can leave out the
+        // directions facing away from the camera as whole ranges instead of leaving every back face
+        // to the rasterizer. Translucent faces stay in back-to-front order.
+        for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            if (!m_isGrouped[layer] && layer != static_cast<size_t>(RenderLayer::Translucent))
+            {
+                GroupByDirection(layer);
+            }
+        }
+
+        // Layers back to back; each is drawn as its own range
+        if (arena)
+        {
+            const uint32_t offset = arena->Allocate(static_cast<uint32_t>(faceCount));
+            if (offset != FreeListAllocator::INVALID_OFFSET)
+            {
+                CopyFacesTo(arena->GetFaces(offset));
+                m_arena = arena;
+                m_arenaOffset = offset;
+                m_arenaFaceCount = static_cast<uint32_t>(faceCount);
+                m_isBuilt = true;
+                return;
+            }
+        }
+
+        // Core profile needs a bound VAO to draw, even one without attributes
         glGenVertexArrays(1, &m_VAO);
-        glGenBuffers(1, &m_VBO);
-        glGenBuffers(1, &m_EBO);
+        glGenBuffers(1, &m_faceBuffer);
+        glGenTextures(1, &m_faceTexture);
 
-        glBindVertexArray(m_VAO);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_faceBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(faceCount * sizeof(ChunkFace)), nullptr, GL_STATIC_DRAW);
+        size_t offset = 0;
+        for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            m_layerOffsets[layer] = offset;
+            if (!m_faces[layer].empty())
+            {
+                glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(offset * sizeof(ChunkFace)),
+                                static_cast<GLsizeiptr>(m_faces[layer].size() * sizeof(ChunkFace)), m_faces[layer].data());
+            }
+            offset += m_faces[layer].size();
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STATIC_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_faceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_faceBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(unsigned int), m_indices.data(), GL_STATIC_DRAW);
+        m_isBuilt = true;
+    }
 
-        // Position attribute
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-        glEnableVertexAttribArray(0);
+    GLsizei ChunkMesh::GetDrawRanges(size_t layer, uint8_t directions, GLint firsts[DIRECTION_COUNT],
+                                     GLsizei counts[DIRECTION_COUNT], size_t& faceCount) const
+    {
+        GLsizei rangeCount = 0;
+        faceCount = 0;
+        if (!IsDrawnByDirection(layer))
+        {
+            firsts[0] = static_cast<GLint>(m_layerOffsets[layer] * 6);
+            counts[0] = static_cast<GLsizei>(m_faces[layer].size() * 6);
+            faceCount = m_faces[layer].size();
+            return m_faces[layer].empty() ? 0 : 1;
+        }
 
-        // Texture coordinate attribute
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
-        glEnableVertexAttribArray(1);
+        size_t first = m_layerOffsets[layer];
+        for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+        {
+            const size_t count = m_directionCounts[layer][direction];
+            if (count != 0 && (directions & (1u << direction)))
+            {
+                if (rangeCount > 0 && static_cast<size_t>(firsts[rangeCount - 1] + counts[rangeCount - 1]) == first * 6)
+                {
+                    counts[rangeCount - 1] += static_cast<GLsizei>(count * 6);
+                }
+                else
+                {
+                    firsts[rangeCount] = static_cast<GLint>(first * 6);
+                    counts[rangeCount] = static_cast<GLsizei>(count * 6);
+                    rangeCount++;
+                }
+                faceCount += count;
+            }
+            first += count;
+        }
+        return rangeCount;
+    }
 
-        // Normal attribute
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-        glEnableVertexAttribArray(2);
+    size_t ChunkMesh::Render(RenderLayer layer, uint8_t directions)
+    {
+        const size_t layerIndex = static_cast<size_t>(layer);
+        if (!m_isBuilt || m_faces[layerIndex].empty())
+        {
+            return 0;
+        }
 
-        glBindVertexArray(0);
+        // Vertex ranges of the requested directions, adjacent ones merged: one multi-draw per layer
+        GLint firsts[DIRECTION_COUNT];
+        GLsizei counts[DIRECTION_COUNT];
+        size_t drawnFaces = 0;
+        const GLsizei rangeCount = GetDrawRanges(layerIndex, directions, firsts, counts, drawnFaces);
+        if (rangeCount == 0)
+        {
+            return 0;
+        }
 
-        m_isBuilt = true;
+        // gl_VertexID counts from first, so arena ranges are just shifted by the mesh's offset
+        if (m_arena)
+        {
+            for (GLsizei i = 0; i < rangeCount; i++)
+            {
+                firsts[i] += static_cast<GLint>(m_arenaOffset * 6);
+            }
+        }
+
+        glVertexAttrib3f(ORIGIN_ATTRIBUTE, static_cast<float>(m_origin.x), static_cast<float>(m_origin.y),
+                         static_cast<float>(m_origin.z));
+
+        glActiveTexture(GL_TEXTURE0 + FACE_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, m_arena ? m_arena->GetFaceTexture() : m_faceTexture);
+        glActiveTexture(GL_TEXTURE0);
+
+        glBindVertexArray(m_arena ? m_arena->GetVertexArray() : m_VAO);
+        glMultiDrawArrays(GL_TRIANGLES, firsts, counts, rangeCount);
+        glBindVertexArray(0);
+        return drawnFaces;
     }
 
-    void ChunkMesh::Render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Shader* shader)
+    size_t ChunkMesh::AppendDraws(RenderLayer layer, uint8_t directions, GLuint drawIndex,
+                                  std::vector<DrawArraysIndirectCommand>& commands) const
     {
-        if (!m_isBuilt || m_VAO == 0)
+        const size_t layerIndex = static_cast<size_t>(layer);
+        if (!m_isBuilt || !m_arena || m_faces[layerIndex].empty())
         {
-            return;
+            return 0;
         }
 
-        shader->Use();
+        GLint firsts[DIRECTION_COUNT];
+        GLsizei counts[DIRECTION_COUNT];
+        size_t drawnFaces = 0;
+        const GLsizei rangeCount = GetDrawRanges(layerIndex, directions, firsts, counts, drawnFaces);
+        for (GLsizei i = 0; i < rangeCount; i++)
+        {
+            commands.push_back({ static_cast<GLuint>(counts[i]), 1u, static_cast<GLuint>(firsts[i]) + m_arenaOffset * 6u,
+                                 drawIndex });
+        }
+        return drawnFaces;
+    }
 
-        // Model matrix (chunk position)
-        glm::mat4 model = glm::mat4(1.0f);
-        shader->SetMat4("model", model);
-        shader->SetMat4("view", viewMatrix);
-        shader->SetMat4("projection", projectionMatrix);
+    void ChunkMesh::SortTranslucent(const glm::vec3& cameraPosition)
+    {
+        std::vector<ChunkFace>& faces = m_faces[static_cast<size_t>(RenderLayer::Translucent)];
+        m_isGrouped[static_cast<size_t>(RenderLayer::Translucent)] = false;
+        if (faces.size() < 2)
+        {
+            return;
+        }
 
-        glBindVertexArray(m_VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        // Farthest quad first, by quad centre
+        const glm::vec3 origin(m_origin);
+        std::vector<std::pair<float, ChunkFace>> order(faces.size());
+        for (size_t i = 0; i < faces.size(); i++)
+        {
+            const DecodedFace decoded = Decode(faces[i]);
+            glm::vec3 centre = origin + decoded.cell + FACE_BASE[decoded.direction]
+                               + (FACE_U[decoded.direction] * decoded.width + FACE_V[decoded.direction] * decoded.height) * 0.5f;
+            glm::vec3 offset = centre - cameraPosition;
+            order[i] = { glm::dot(offset, offset), faces[i] };
+        }
+        std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (size_t i = 0; i < faces.size(); i++)
+        {
+            faces[i] = order[i].second;
+        }
 
-        shader->Unuse();
+        if (m_isBuilt && m_arena)
+        {
+            // The GPU may still be reading this range for the last frames: move the mesh to a fresh
+            // range, and only rewrite it in place if the arena has no room
+            const uint32_t offset = m_arena->Allocate(m_arenaFaceCount);
+            if (offset != FreeListAllocator::INVALID_OFFSET)
+            {
+                CopyFacesTo(m_arena->GetFaces(offset));
+                m_arena->Free(m_arenaOffset, m_arenaFaceCount);
+                m_arenaOffset = offset;
+            }
+            else
+            {
+                std::copy(faces.begin(), faces.end(),
+                          m_arena->GetFaces(m_arenaOffset) + m_layerOffsets[static_cast<size_t>(RenderLayer::Translucent)]);
+            }
+        }
+        else if (m_isBuilt && m_faceBuffer != 0)
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, m_faceBuffer);
+            glBufferSubData(GL_TEXTURE_BUFFER,
+                            static_cast<GLintptr>(m_layerOffsets[static_cast<size_t>(RenderLayer::Translucent)] * sizeof(ChunkFace)),
+                            static_cast<GLsizeiptr>(faces.size() * sizeof(ChunkFace)), faces.data());
+            glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        }
     }
 
     void ChunkMesh::Shutdown()
     {
+        if (m_arena)
+        {
+            m_arena->Free(m_arenaOffset, m_arenaFaceCount);
+            m_arena = nullptr;
+        }
         if (m_VAO != 0)
         {
             glDeleteVertexArrays(1, &m_VAO);
             m_VAO = 0;
         }
-        if (m_VBO != 0)
+        if (m_faceTexture != 0)
         {
-            glDeleteBuffers(1, &m_VBO);
-            m_VBO = 0;
+            glDeleteTextures(1, &m_faceTexture);
+            m_faceTexture = 0;
         }
-        if (m_EBO != 0)
+        if (m_faceBuffer != 0)
         {
-            glDeleteBuffers(1, &m_EBO);
-            m_EBO = 0;
+            glDeleteBuffers(1, &m_faceBuffer);
+            m_faceBuffer = 0;
         }
         m_isBuilt = false;
     }
-}
\ No newline at end of file
+}
@@ -5,8 +5,39 @@
 #include "Rendering/Frustum.h"
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUSTUM_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace MinecraftClone
 {
+    void AABBArray::Clear()
+    {
+        for (std::vector<float>* coordinate : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ })
+        {
+            coordinate->clear();
+        }
+    }
+
+    void AABBArray::Reserve(size_t count)
+    {
+        for (std::vector<float>* coordinate : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ })
+        {
+            coordinate->reserve(count);
+        }
+    }
+
+    void AABBArray::Add(const glm::vec3& min, const glm::vec3& max)
+    {
+        m_minX.push_back(min.x);
+        m_minY.push_back(min.y);
+        m_minZ.push_back(min.z);
+        m_maxX.push_back(max.x);
+        m_maxY.push_back(max.y);
+        m_maxZ.push_back(max.z);
+    }
+
     void Frustum::NormalizePlane(glm::vec4& plane) const
     {
         float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
@@ -98,5 +129,70 @@ namespace MinecraftClone
         // AABB intersects or is inside the frustum
         return true;
     }
-}
 
+    void Frustum::CullAABBs(const AABBArray& boxes, std::vector<uint32_t>& visibleIndices) const
+    {
+        // Each plane's positive vertex takes max or min per axis from the sign of its normal, the
+        // same choice for every box: pick the coordinate arrays once per plane
+        const float* positive[6][3];
+        for (int i = 0; i < 6; i++)
+        {
+            positive[i][0] = (m_planes[i].x >= 0.0f) ? boxes.m_maxX.data() : boxes.m_minX.data();
+            positive[i][1] = (m_planes[i].y >= 0.0f) ? boxes.m_maxY.data() : boxes.m_minY.data();
+            positive[i][2] = (m_planes[i].z >= 0.0f) ? boxes.m_maxZ.data() : boxes.m_minZ.data();
+        }
+
+        const size_t count = boxes.Size();
+        size_t first = 0;
+
+#if defined(FRUSTUM_SSE2)
+        // OPTIMIZATION 18: Batched frustum culling
+        // Four boxes per plane test: the distance of each box's positive vertex is computed for four
+        // boxes at once from the coordinate arrays, and a box stays visible while no plane has all of
+        // it behind. The survivors' indices are written out from the final 4-bit mask.
+        __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+        for (int i = 0; i < 6; i++)
+        {
+            planeX[i] = _mm_set1_ps(m_planes[i].x);
+            planeY[i] = _mm_set1_ps(m_planes[i].y);
+            planeZ[i] = _mm_set1_ps(m_planes[i].z);
+            planeW[i] = _mm_set1_ps(m_planes[i].w);
+        }
+        const __m128 zero = _mm_setzero_ps();
+        for (; first + 4 <= count; first += 4)
+        {
+            __m128 outside = _mm_setzero_ps();
+            for (int i = 0; i < 6; i++)
+            {
+                const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[i], _mm_loadu_ps(positive[i][0] + first)),
+                                                                         _mm_mul_ps(planeY[i], _mm_loadu_ps(positive[i][1] + first))),
+                                                              _mm_mul_ps(planeZ[i], _mm_loadu_ps(positive[i][2] + first))),
+                                                   planeW[i]);
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+            }
+            for (int visible = ~_mm_movemask_ps(outside) & 0xF; visible != 0; visible &= visible - 1)
+            {
+                const int lane = (visible & 1) ? 0 : (visible & 2) ? 1 : (visible & 4) ? 2 : 3;
+                visibleIndices.push_back(static_cast<uint32_t>(first + static_cast<size_t>(lane)));
+            }
+        }
+#endif
+
+        // The remainder (every box without SSE2), one at a time
+        for (size_t index = first; index < count; index++)
+        {
+            bool visible = true;
+            for (int i = 0; i < 6 && visible; i++)
+            {
+                const glm::vec4& plane = m_planes[i];
+                const float distance = plane.x * positive[i][0][index] + plane.y * positive[i][1][index] +
+                                       plane.z * positive[i][2][index] + plane.w;
+                visible = !(distance < 0.0f);
+            }
+            if (visible)
+            {
+                visibleIndices.push_back(static_cast<uint32_t>(index));
+            }
+        }
+    }
+}
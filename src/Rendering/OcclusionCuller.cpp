@@ -0,0 +1,483 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "Rendering/OcclusionCuller.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MinecraftClone
+{
+    namespace
+    {
+        constexpr int MAX_CLIPPED_VERTICES = 8;
+        constexpr float MIN_TRIANGLE_AREA = 1e-6f;
+
+        // Signed distance to the near plane in clip space (inside when >= 0)
+        inline float NearDistance(const glm::vec4& clip)
+        {
+            return clip.z + clip.w;
+        }
+
+        inline int AlignDown4(int value)
+        {
+            return value & ~3;
+        }
+    }
+
+    OcclusionCuller::OcclusionCuller()
+        : m_width(0)
+        , m_height(0)
+        , m_viewProjection(1.0f)
+        , m_cameraPosition(0.0f)
+        , m_nextTile(0)
+        , m_jobGeneration(0)
+        , m_workersBusy(0)
+        , m_shouldStopWorkers(false)
+    {
+    }
+
+    OcclusionCuller::~OcclusionCuller()
+    {
+        Shutdown();
+    }
+
+    void OcclusionCuller::Initialize(int width, int height, int threadCount)
+    {
+        Shutdown();
+        m_width = std::max(4, AlignDown4(width));
+        m_height = std::max(1, height);
+        m_depth.assign(static_cast<size_t>(m_width) * static_cast<size_t>(m_height), 0.0f);
+
+        if (threadCount <= 0)
+        {
+            threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        // The calling thread rasterizes tiles too, so spawn one fewer worker
+        m_shouldStopWorkers = false;
+        for (int i = 1; i < threadCount; i++)
+        {
+            m_workerThreads.emplace_back(&OcclusionCuller::WorkerThreadFunction, this);
+        }
+        spdlog::info("Occlusion culler: {}x{} depth buffer, {} threads", m_width, m_height, threadCount);
+    }
+
+    void OcclusionCuller::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_jobMutex);
+            m_shouldStopWorkers = true;
+        }
+        m_jobCondition.notify_all();
+
+        for (auto& thread : m_workerThreads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        m_workerThreads.clear();
+        m_triangles.clear();
+    }
+
+    void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+    {
+        m_viewProjection = viewProjection;
+        m_cameraPosition = cameraPosition;
+        m_triangles.clear();
+        m_stats = OcclusionStats();
+        std::fill(m_depth.begin(), m_depth.end(), 0.0f);
+    }
+
+    void OcclusionCuller::AddOccluder(const glm::vec3& boxMin, const glm::vec3& boxMax)
+    {
+        // From inside a box every face is a back face and nothing beyond it would survive: skip it
+        if (glm::all(glm::greaterThanEqual(m_cameraPosition, boxMin)) && glm::all(glm::lessThanEqual(m_cameraPosition, boxMax)))
+        {
+            return;
+        }
+        m_stats.occluders++;
+
+        // Corner i has x from bit 0, y from bit 1, z from bit 2
+        glm::vec4 corners[8];
+        float farthest = FLT_MAX;
+        for (int i = 0; i < 8; i++)
+        {
+            const glm::vec3 corner((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z);
+            corners[i] = m_viewProjection * glm::vec4(corner, 1.0f);
+            if (corners[i].w > 0.0f)
+            {
+                farthest = std::min(farthest, 1.0f / corners[i].w);
+            }
+        }
+        if (farthest == FLT_MAX)
+        {
+            return;  // Entirely behind the camera
+        }
+
+        // Faces -X, +X, -Y, +Y, -Z, +Z: their corners in order around the face, and the face across each
+        // edge (from corner k to corner k + 1)
+        static const int FACE_CORNERS[6][4] = {
+            { 0, 2, 6, 4 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 3, 7, 6 }, { 0, 1, 3, 2 }, { 4, 5, 7, 6 }
+        };
+        static const int EDGE_FACES[6][4] = {
+            { 4, 3, 5, 2 }, { 4, 3, 5, 2 }, { 4, 1, 5, 0 }, { 4, 1, 5, 0 }, { 2, 1, 3, 0 }, { 2, 1, 3, 0 }
+        };
+        const bool front[6] = {
+            m_cameraPosition.x < boxMin.x, m_cameraPosition.x > boxMax.x,
+            m_cameraPosition.y < boxMin.y, m_cameraPosition.y > boxMax.y,
+            m_cameraPosition.z < boxMin.z, m_cameraPosition.z > boxMax.z,
+        };
+
+        // The back faces tile the box's outline and lie behind everything in front of them; only the
+        // outline's own edges (shared with a front face) need whole-pixel coverage
+        for (int face = 0; face < 6; face++)
+        {
+            if (front[face])
+            {
+                continue;
+            }
+            glm::vec4 quad[4];
+            bool outline[4];
+            for (int k = 0; k < 4; k++)
+            {
+                quad[k] = corners[FACE_CORNERS[face][k]];
+                outline[k] = front[EDGE_FACES[face][k]];
+            }
+            AddFace(quad, outline, farthest);
+        }
+    }
+
+    void OcclusionCuller::AddFace(const glm::vec4 corners[4], const bool outline[4], float farthest)
+    {
+        // Clip the quad to the near plane (Sutherland-Hodgman against one plane). Edge i runs from
+        // vertex i to vertex i + 1; the one along the near plane is part of the outline.
+        glm::vec4 clipped[MAX_CLIPPED_VERTICES];
+        bool clippedOutline[MAX_CLIPPED_VERTICES];
+        int count = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            const glm::vec4& current = corners[i];
+            const glm::vec4& next = corners[(i + 1) & 3];
+            const float currentDistance = NearDistance(current);
+            const float nextDistance = NearDistance(next);
+            const bool crosses = (currentDistance >= 0.0f) != (nextDistance >= 0.0f);
+            const glm::vec4 crossing = crosses ? current + (next - current) * (currentDistance / (currentDistance - nextDistance)) : current;
+            if (currentDistance >= 0.0f)
+            {
+                clipped[count] = current;
+                clippedOutline[count++] = outline[i];
+                if (crosses)
+                {
+                    clipped[count] = crossing;
+                    clippedOutline[count++] = true;
+                }
+            }
+            else if (crosses)
+            {
+                clipped[count] = crossing;
+                clippedOutline[count++] = outline[i];
+            }
+        }
+        if (count < 3)
+        {
+            return;
+        }
+
+        // Pixel position and 1/w, which is linear across the screen
+        glm::vec3 screen[MAX_CLIPPED_VERTICES];
+        for (int i = 0; i < count; i++)
+        {
+            const float w = std::max(clipped[i].w, 1e-6f);
+            screen[i] = glm::vec3((clipped[i].x / w * 0.5f + 0.5f) * static_cast<float>(m_width),
+                                  (clipped[i].y / w * 0.5f + 0.5f) * static_cast<float>(m_height), 1.0f / w);
+        }
+
+        // Fan from vertex 0: the diagonals are inside the face
+        for (int i = 1; i + 1 < count; i++)
+        {
+            const bool edgeOutline[3] = { i == 1 && clippedOutline[0], clippedOutline[i], i + 2 == count && clippedOutline[count - 1] };
+            AddTriangle(screen[0], screen[i], screen[i + 1], edgeOutline, farthest);
+        }
+    }
+
+    void OcclusionCuller::AddTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const bool outline[3], float farthest)
+    {
+        const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        if (std::abs(area) < MIN_TRIANGLE_AREA)
+        {
+            return;
+        }
+
+        // Counter-clockwise, so the inside is where every edge function is non-negative
+        const bool clockwise = area < 0.0f;
+        const glm::vec3 vertices[3] = { a, clockwise ? c : b, clockwise ? b : c };
+        const bool edgeOutline[3] = { clockwise ? outline[2] : outline[0], outline[1], clockwise ? outline[0] : outline[2] };
+
+        // Pixels whose centres (x + 0.5, y + 0.5) fall within the triangle's bounds
+        const float width = static_cast<float>(m_width);
+        const float height = static_cast<float>(m_height);
+        const float minX = std::clamp(std::min({ a.x, b.x, c.x }) - 0.5f, -1.0f, width);
+        const float maxX = std::clamp(std::max({ a.x, b.x, c.x }) - 0.5f, -1.0f, width);
+        const float minY = std::clamp(std::min({ a.y, b.y, c.y }) - 0.5f, -1.0f, height);
+        const float maxY = std::clamp(std::max({ a.y, b.y, c.y }) - 0.5f, -1.0f, height);
+
+        Triangle triangle;
+        triangle.minX = std::max(0, static_cast<int>(std::ceil(minX)));
+        triangle.maxX = std::min(m_width - 1, static_cast<int>(std::floor(maxX)));
+        triangle.minY = std::max(0, static_cast<int>(std::ceil(minY)));
+        triangle.maxY = std::min(m_height - 1, static_cast<int>(std::floor(maxY)));
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        {
+            return;
+        }
+
+        // Outline edges are moved in by half a pixel each way, so they pass only pixels wholly inside
+        for (int edge = 0; edge < 3; edge++)
+        {
+            const glm::vec3& from = vertices[edge];
+            const glm::vec3& to = vertices[(edge + 1) % 3];
+            triangle.edgeA[edge] = from.y - to.y;
+            triangle.edgeB[edge] = to.x - from.x;
+            triangle.edgeC[edge] = -(triangle.edgeA[edge] * from.x + triangle.edgeB[edge] * from.y);
+            if (edgeOutline[edge])
+            {
+                triangle.edgeC[edge] -= 0.5f * (std::abs(triangle.edgeA[edge]) + std::abs(triangle.edgeB[edge]));
+            }
+        }
+
+        // 1/w as a plane over the screen, taking its farthest (smallest) value within each pixel. Past a
+        // diagonal or an edge shared with another back face the plane only gets farther than the box,
+        // and nothing is farther than the box's farthest corner.
+        triangle.depthA = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+        triangle.depthB = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+        triangle.depthC = a.z - triangle.depthA * a.x - triangle.depthB * a.y -
+                          0.5f * (std::abs(triangle.depthA) + std::abs(triangle.depthB));
+        triangle.minDepth = farthest;
+        m_triangles.push_back(triangle);
+    }
+
+    void OcclusionCuller::Rasterize()
+    {
+        auto start = std::chrono::steady_clock::now();
+        m_stats.triangles = m_triangles.size();
+
+        // OPTIMIZATION 17: Software occlusion culling
+        // The buffer is small (256x128 by default) and occluders are whole runs of opaque layers, so a
+        // frame is a few thousand small triangles; tiles of rows are independent and are shared
+        // out like block tick regions, with the caller taking tiles as well.
+        m_nextTile = 0;
+        if (m_workerThreads.empty() || m_triangles.empty())
+        {
+            RasterizeTiles();
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_jobMutex);
+                m_workersBusy = static_cast<int>(m_workerThreads.size());
+                m_jobGeneration++;
+            }
+            m_jobCondition.notify_all();
+
+            RasterizeTiles();
+
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobDoneCondition.wait(lock, [this] { return m_workersBusy == 0; });
+        }
+
+        m_stats.rasterizeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void OcclusionCuller::RasterizeTiles()
+    {
+        const int tileCount = (m_height + TILE_ROWS - 1) / TILE_ROWS;
+        while (true)
+        {
+            const int tile = m_nextTile.fetch_add(1);
+            if (tile >= tileCount)
+            {
+                break;
+            }
+            RasterizeTile(tile);
+        }
+    }
+
+    void OcclusionCuller::RasterizeTile(int tile)
+    {
+        const int tileMinY = tile * TILE_ROWS;
+        const int tileMaxY = std::min(m_height - 1, tileMinY + TILE_ROWS - 1);
+
+        for (const Triangle& triangle : m_triangles)
+        {
+            const int minY = std::max(triangle.minY, tileMinY);
+            const int maxY = std::min(triangle.maxY, tileMaxY);
+            if (minY > maxY)
+            {
+                continue;
+            }
+
+            // Whole groups of 4 pixels: the edge functions reject the extra ones
+            const int startX = AlignDown4(triangle.minX);
+            for (int y = minY; y <= maxY; y++)
+            {
+                float* row = m_depth.data() + static_cast<size_t>(y) * static_cast<size_t>(m_width);
+                const float centreY = static_cast<float>(y) + 0.5f;
+                const float centreX = static_cast<float>(startX) + 0.5f;
+#if defined(OCCLUSION_SSE2)
+                const __m128 offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 minDepth = _mm_set1_ps(triangle.minDepth);
+                const __m128 depthA = _mm_set1_ps(triangle.depthA);
+                const __m128 depthStep = _mm_mul_ps(depthA, _mm_set1_ps(4.0f));
+                __m128 depth = _mm_add_ps(_mm_set1_ps(triangle.depthA * centreX + triangle.depthB * centreY + triangle.depthC),
+                                          _mm_mul_ps(depthA, offsets));
+                __m128 edges[3];
+                __m128 steps[3];
+                for (int edge = 0; edge < 3; edge++)
+                {
+                    const float rowStart = triangle.edgeA[edge] * centreX + triangle.edgeB[edge] * centreY + triangle.edgeC[edge];
+                    const __m128 a = _mm_set1_ps(triangle.edgeA[edge]);
+                    edges[edge] = _mm_add_ps(_mm_set1_ps(rowStart), _mm_mul_ps(a, offsets));
+                    steps[edge] = _mm_mul_ps(a, _mm_set1_ps(4.0f));
+                }
+                for (int x = startX; x <= triangle.maxX; x += 4)
+                {
+                    const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edges[0], zero), _mm_cmpge_ps(edges[1], zero)),
+                                                     _mm_cmpge_ps(edges[2], zero));
+                    const __m128 current = _mm_loadu_ps(row + x);
+                    const __m128 nearer = _mm_max_ps(current, _mm_max_ps(depth, minDepth));
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+                    for (int edge = 0; edge < 3; edge++)
+                    {
+                        edges[edge] = _mm_add_ps(edges[edge], steps[edge]);
+                    }
+                    depth = _mm_add_ps(depth, depthStep);
+                }
+#else
+                float edges[3];
+                for (int edge = 0; edge < 3; edge++)
+                {
+                    edges[edge] = triangle.edgeA[edge] * centreX + triangle.edgeB[edge] * centreY + triangle.edgeC[edge];
+                }
+                float depth = triangle.depthA * centreX + triangle.depthB * centreY + triangle.depthC;
+                for (int x = startX; x <= triangle.maxX; x++)
+                {
+                    if (edges[0] >= 0.0f && edges[1] >= 0.0f && edges[2] >= 0.0f)
+                    {
+                        row[x] = std::max(row[x], std::max(depth, triangle.minDepth));
+                    }
+                    for (int edge = 0; edge < 3; edge++)
+                    {
+                        edges[edge] += triangle.edgeA[edge];
+                    }
+                    depth += triangle.depthA;
+                }
+#endif
+            }
+        }
+    }
+
+    bool OcclusionCuller::IsVisible(const glm::vec3& boxMin, const glm::vec3& boxMax)
+    {
+        m_stats.tests++;
+
+        glm::vec2 screenMin(FLT_MAX);
+        glm::vec2 screenMax(-FLT_MAX);
+        float nearest = 0.0f;  // Largest 1/w of the corners
+        for (int i = 0; i < 8; i++)
+        {
+            const glm::vec3 corner((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z);
+            const glm::vec4 clip = m_viewProjection * glm::vec4(corner, 1.0f);
+            if (NearDistance(clip) < 0.0f || clip.w <= 0.0f)
+            {
+                return true;
+            }
+            const glm::vec2 screen((clip.x / clip.w * 0.5f + 0.5f) * static_cast<float>(m_width),
+                                   (clip.y / clip.w * 0.5f + 0.5f) * static_cast<float>(m_height));
+            screenMin = glm::min(screenMin, screen);
+            screenMax = glm::max(screenMax, screen);
+            nearest = std::max(nearest, 1.0f / clip.w);
+        }
+
+        // Every pixel the box touches, widened to whole groups of 4
+        const float width = static_cast<float>(m_width);
+        const float height = static_cast<float>(m_height);
+        const int minX = AlignDown4(std::max(0, static_cast<int>(std::floor(std::clamp(screenMin.x, -1.0f, width)))));
+        const int maxX = std::min(m_width - 1, static_cast<int>(std::floor(std::clamp(screenMax.x, -1.0f, width))) | 3);
+        const int minY = std::max(0, static_cast<int>(std::floor(std::clamp(screenMin.y, -1.0f, height))));
+        const int maxY = std::min(m_height - 1, static_cast<int>(std::floor(std::clamp(screenMax.y, -1.0f, height))));
+        if (minX > maxX || minY > maxY)
+        {
+            return true;  // Off screen: left to the frustum
+        }
+
+        for (int y = minY; y <= maxY; y++)
+        {
+            const float* row = m_depth.data() + static_cast<size_t>(y) * static_cast<size_t>(m_width);
+#if defined(OCCLUSION_SSE2)
+            const __m128 boxDepth = _mm_set1_ps(nearest);
+            for (int x = minX; x <= maxX; x += 4)
+            {
+                if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(row + x), boxDepth)) != 0)
+                {
+                    return true;
+                }
+            }
+#else
+            for (int x = minX; x <= maxX; x++)
+            {
+                if (row[x] <= nearest)
+                {
+                    return true;
+                }
+            }
+#endif
+        }
+
+        m_stats.culled++;
+        return false;
+    }
+
+    void OcclusionCuller::WorkerThreadFunction()
+    {
+        uint64_t seenGeneration = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_jobMutex);
+            seenGeneration = m_jobGeneration;  // Initialize may follow earlier frames
+        }
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_jobMutex);
+                m_jobCondition.wait(lock, [this, seenGeneration] {
+                    return m_shouldStopWorkers || m_jobGeneration != seenGeneration;
+                });
+
+                if (m_shouldStopWorkers)
+                {
+                    return;
+                }
+                seenGeneration = m_jobGeneration;
+            }
+
+            RasterizeTiles();
+
+            {
+                std::lock_guard<std::mutex> lock(m_jobMutex);
+                m_workersBusy--;
+            }
+            m_jobDoneCondition.notify_one();
+        }
+    }
+}
@@ -9,7 +9,7 @@
 
 namespace MinecraftClone
 {
-    Texture::Texture() : m_textureID(0), m_width(0), m_height(0), m_channels(0)
+    Texture::Texture() : m_textureID(0), m_target(GL_TEXTURE_2D), m_width(0), m_height(0), m_channels(0), m_layers(0)
     {
     }
 
@@ -59,15 +59,89 @@ namespace MinecraftClone
         return true;
     }
 
+    bool Texture::LoadArrayFromGrid(const std::string& filepath, int columns, int rows)
+    {
+        Shutdown();
+
+        // Flipped like LoadFromFile, so every layer keeps its bottom-left origin
+        stbi_set_flip_vertically_on_load(true);
+
+        int imageWidth = 0;
+        int imageHeight = 0;
+        unsigned char* data = stbi_load(filepath.c_str(), &imageWidth, &imageHeight, &m_channels, 0);
+        if (!data)
+        {
+            spdlog::error("Failed to load texture: {}", filepath);
+            return false;
+        }
+        if (columns <= 0 || rows <= 0 || imageWidth % columns != 0 || imageHeight % rows != 0)
+        {
+            spdlog::error("Texture {} ({}x{}) does not divide into {}x{} tiles", filepath, imageWidth, imageHeight, columns, rows);
+            stbi_image_free(data);
+            m_channels = 0;
+            return false;
+        }
+
+        GLenum format = GL_RGB;
+        GLint internalFormat = GL_RGB8;
+        if (m_channels == 1)
+        {
+            format = GL_RED;
+            internalFormat = GL_R8;
+        }
+        else if (m_channels == 4)
+        {
+            format = GL_RGBA;
+            internalFormat = GL_RGBA8;
+        }
+
+        m_target = GL_TEXTURE_2D_ARRAY;
+        m_width = imageWidth / columns;
+        m_height = imageHeight / rows;
+        m_layers = columns * rows;
+        glGenTextures(1, &m_textureID);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat, m_width, m_height, m_layers, 0, format, GL_UNSIGNED_BYTE, nullptr);
+
+        // Each tile goes straight from the image into its layer: the unpack state walks the tile's
+        // rectangle inside the full image rows (the flipped image has the top row of tiles last)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, imageWidth);
+        for (int layer = 0; layer < m_layers; layer++)
+        {
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, (layer % columns) * m_width);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, (rows - 1 - layer / columns) * m_height);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_width, m_height, 1, format, GL_UNSIGNED_BYTE, data);
+        }
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        // Mip levels are downsampled per layer, so distant faces never average in a neighbouring
+        // tile, and GL_REPEAT wraps inside the layer, so merged quads tile it with no shader math
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        stbi_image_free(data);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        spdlog::info("Loaded texture array: {} ({} layers of {}x{}, {} channels)", filepath, m_layers, m_width, m_height, m_channels);
+        return true;
+    }
+
     void Texture::Bind(GLuint textureUnit) const
     {
         glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, m_textureID);
+        glBindTexture(m_target, m_textureID);
     }
 
     void Texture::Unbind() const
     {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(m_target, 0);
     }
 
     void Texture::Shutdown()
@@ -77,8 +151,10 @@ namespace MinecraftClone
             glDeleteTextures(1, &m_textureID);
             m_textureID = 0;
         }
+        m_target = GL_TEXTURE_2D;
         m_width = 0;
         m_height = 0;
         m_channels = 0;
+        m_layers = 0;
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "World/BlockInteraction.h"
 #include "Networking/NetworkManager.h"
 #include "Physics/PhysicsManager.h"
+#include "World/BlockTickScheduler.h"
 
 namespace MinecraftClone
 {
@@ -15,6 +16,7 @@ namespace MinecraftClone
         , m_chunkManager(nullptr)
         , m_networkManager(nullptr)
         , m_physicsManager(nullptr)
+        , m_blockTickScheduler(nullptr)
         , m_selectedBlockType(BlockType::Stone)
         , m_initialized(false)
     {
@@ -75,6 +77,12 @@ namespace MinecraftClone
         // Mark chunk for mesh update
         MarkChunkForUpdate(blockPos);
 
+        // Wake falling blocks / water around the hole
+        if (m_blockTickScheduler)
+        {
+            m_blockTickScheduler->NotifyBlockChanged(blockPos.x, blockPos.y, blockPos.z);
+        }
+
         // Update physics collision
         if (m_physicsManager)
         {
@@ -118,6 +126,12 @@ namespace MinecraftClone
         // Mark chunk for mesh update
         MarkChunkForUpdate(placePos);
 
+        // Placed sand/gravel/water starts ticking, neighbours may react
+        if (m_blockTickScheduler)
+        {
+            m_blockTickScheduler->NotifyBlockChanged(placePos.x, placePos.y, placePos.z);
+        }
+
         // Update physics collision
         if (m_physicsManager)
         {
@@ -145,28 +159,15 @@ namespace MinecraftClone
             return;
         }
 
-        // Get chunk coordinates
-        auto chunkCoords = World::GetChunkCoords(blockPos.x, blockPos.z);
-
-        // Update the chunk mesh
-        Chunk* chunk = m_world->GetChunk(chunkCoords.first, chunkCoords.second);
-        if (chunk)
+        // Rebuild only the edited section and the sections across any face the block touches,
+        // on the worker threads when available so the edit never stalls the frame
+        if (m_chunkManager)
         {
-            m_chunkRenderer->UpdateChunk(chunk, chunkCoords.first, chunkCoords.second, m_world);
-
-            // Also update adjacent chunks if block is on chunk border
-            // Check all 6 directions
-            int offsets[6][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {0, 0}, {0, 0}};
-            for (int i = 0; i < 6; i++)
-            {
-                int adjChunkX = chunkCoords.first + offsets[i][0];
-                int adjChunkZ = chunkCoords.second + offsets[i][1];
-                Chunk* adjChunk = m_world->GetChunk(adjChunkX, adjChunkZ);
-                if (adjChunk)
-                {
-                    m_chunkRenderer->UpdateChunk(adjChunk, adjChunkX, adjChunkZ, m_world);
-                }
-            }
+            m_chunkManager->RequestBlockRemesh(blockPos.x, blockPos.y, blockPos.z);
+        }
+        else
+        {
+            m_chunkRenderer->UpdateBlock(blockPos.x, blockPos.y, blockPos.z, m_world);
         }
     }
 }
\ No newline at end of file
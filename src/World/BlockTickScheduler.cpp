@@ -0,0 +1,645 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "World/BlockTickScheduler.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+
+namespace MinecraftClone
+{
+    namespace
+    {
+        int ChunkIndex(int x, int y, int z)
+        {
+            return y * (CHUNK_SIZE_X * CHUNK_SIZE_Z) + z * CHUNK_SIZE_X + x;
+        }
+
+        // Slot in the 3x3 neighbourhood (0..2) for a region-local coordinate in [-1, 16]
+        int NeighbourSlot(int coord, int size)
+        {
+            return coord < 0 ? 0 : (coord >= size ? 2 : 1);
+        }
+
+        const int HORIZONTAL_OFFSETS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+        // A block's chunk, plus the chunks across any face border it lies on
+        void AddChunkAndBorderNeighbours(std::vector<std::pair<int, int>>& chunks, int chunkX, int chunkZ, int localX, int localZ)
+        {
+            chunks.emplace_back(chunkX, chunkZ);
+            if (localX == 0) chunks.emplace_back(chunkX - 1, chunkZ);
+            if (localX == CHUNK_SIZE_X - 1) chunks.emplace_back(chunkX + 1, chunkZ);
+            if (localZ == 0) chunks.emplace_back(chunkX, chunkZ - 1);
+            if (localZ == CHUNK_SIZE_Z - 1) chunks.emplace_back(chunkX, chunkZ + 1);
+        }
+    }
+
+    BlockTickScheduler::BlockTickScheduler()
+        : m_world(nullptr)
+        , m_currentTick(0)
+        , m_accumulator(0.0f)
+        , m_initialized(false)
+        , m_jobRegions(nullptr)
+        , m_nextRegion(0)
+        , m_jobGeneration(0)
+        , m_workersBusy(0)
+        , m_shouldStopWorkers(false)
+    {
+    }
+
+    BlockTickScheduler::~BlockTickScheduler()
+    {
+        Shutdown();
+    }
+
+    void BlockTickScheduler::Initialize(World* world, int threadCount)
+    {
+        m_world = world;
+
+        if (threadCount <= 0)
+        {
+            threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        // The calling thread processes regions too, so spawn one fewer worker
+        m_shouldStopWorkers = false;
+        for (int i = 1; i < threadCount; i++)
+        {
+            m_workerThreads.emplace_back(&BlockTickScheduler::WorkerThreadFunction, this);
+        }
+
+        m_initialized = true;
+        spdlog::info("BlockTickScheduler initialized: {} ticks/sec, {} threads", TICKS_PER_SECOND, threadCount);
+    }
+
+    void BlockTickScheduler::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_jobMutex);
+            m_shouldStopWorkers = true;
+        }
+        m_jobCondition.notify_all();
+
+        for (auto& thread : m_workerThreads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        m_workerThreads.clear();
+
+        m_states.clear();
+        m_changedBlocks.clear();
+        m_collisionChunks.clear();
+        m_terrainPending.clear();
+        m_initialized = false;
+    }
+
+    void BlockTickScheduler::Update(float deltaTime)
+    {
+        if (!m_initialized)
+        {
+            return;
+        }
+
+        const float tickInterval = 1.0f / static_cast<float>(TICKS_PER_SECOND);
+        m_accumulator += deltaTime;
+
+        int ticksRun = 0;
+        while (m_accumulator >= tickInterval && ticksRun < MAX_TICKS_PER_UPDATE)
+        {
+            Tick();
+            m_accumulator -= tickInterval;
+            ticksRun++;
+        }
+
+        // Drop the backlog instead of spiralling after a long stall
+        if (ticksRun == MAX_TICKS_PER_UPDATE && m_accumulator >= tickInterval)
+        {
+            m_accumulator = 0.0f;
+        }
+    }
+
+    void BlockTickScheduler::Tick()
+    {
+        if (!m_initialized || !m_world)
+        {
+            return;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        m_currentTick++;
+
+        // Chunks with at least one due tick
+        std::vector<std::pair<int, int>> dueChunks;
+        for (const auto& [coord, state] : m_states)
+        {
+            if (!state.queue.empty() && state.queue.top().tick <= m_currentTick && m_terrainPending.count(coord) == 0)
+            {
+                dueChunks.push_back(coord);
+            }
+        }
+
+        size_t processed = 0;
+        std::vector<TickRegion> regions;
+        for (int phase = 0; phase < 9; phase++)
+        {
+            regions.clear();
+            for (const auto& coord : dueChunks)
+            {
+                int colourX = ((coord.first % 3) + 3) % 3;
+                int colourZ = ((coord.second % 3) + 3) % 3;
+                if (colourX * 3 + colourZ != phase)
+                {
+                    continue;
+                }
+
+                Chunk* centre = m_world->GetChunk(coord.first, coord.second);
+                if (!centre)
+                {
+                    // Chunk went away without UnloadChunk; its ticks cannot run
+                    m_states.erase(coord);
+                    continue;
+                }
+
+                // Resolve the neighbourhood here so workers never touch the maps
+                TickRegion region;
+                region.chunkX = coord.first;
+                region.chunkZ = coord.second;
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    for (int dz = -1; dz <= 1; dz++)
+                    {
+                        auto neighbour = std::make_pair(coord.first + dx, coord.second + dz);
+                        Chunk* chunk = m_terrainPending.count(neighbour) == 0 ? m_world->GetChunk(neighbour.first, neighbour.second) : nullptr;
+                        region.chunks[dx + 1][dz + 1] = chunk;
+                        if (chunk)
+                        {
+                            region.states[dx + 1][dz + 1] = &m_states[neighbour];
+                        }
+                    }
+                }
+                regions.push_back(std::move(region));
+            }
+
+            RunPhase(regions);
+
+            for (const auto& region : regions)
+            {
+                processed += region.processed;
+                m_changedBlocks.insert(m_changedBlocks.end(), region.changedBlocks.begin(), region.changedBlocks.end());
+                m_collisionChunks.insert(region.collisionChunks.begin(), region.collisionChunks.end());
+            }
+        }
+
+        // Forget chunks with nothing left to simulate
+        for (auto it = m_states.begin(); it != m_states.end();)
+        {
+            if (it->second.queue.empty() && it->second.waterLevels.empty())
+            {
+                it = m_states.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        m_stats.lastTickMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        m_stats.processedLastTick = processed;
+        m_stats.regionsLastTick = dueChunks.size();
+    }
+
+    void BlockTickScheduler::RunPhase(std::vector<TickRegion>& regions)
+    {
+        if (regions.empty())
+        {
+            return;
+        }
+
+        if (m_workerThreads.empty() || regions.size() < 2)
+        {
+            for (auto& region : regions)
+            {
+                ProcessRegion(region);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_jobMutex);
+            m_jobRegions = &regions;
+            m_nextRegion = 0;
+            m_workersBusy = static_cast<int>(m_workerThreads.size());
+            m_jobGeneration++;
+        }
+        m_jobCondition.notify_all();
+
+        // Main thread takes regions as well
+        while (true)
+        {
+            size_t index = m_nextRegion.fetch_add(1);
+            if (index >= regions.size())
+            {
+                break;
+            }
+            ProcessRegion(regions[index]);
+        }
+
+        std::unique_lock<std::mutex> lock(m_jobMutex);
+        m_jobDoneCondition.wait(lock, [this] { return m_workersBusy == 0; });
+        m_jobRegions = nullptr;
+    }
+
+    void BlockTickScheduler::WorkerThreadFunction()
+    {
+        uint64_t seenGeneration = 0;
+        while (true)
+        {
+            std::vector<TickRegion>* regions = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_jobMutex);
+                m_jobCondition.wait(lock, [this, seenGeneration] {
+                    return m_shouldStopWorkers || m_jobGeneration != seenGeneration;
+                });
+
+                if (m_shouldStopWorkers)
+                {
+                    return;
+                }
+                seenGeneration = m_jobGeneration;
+                regions = m_jobRegions;
+            }
+
+            while (true)
+            {
+                size_t index = m_nextRegion.fetch_add(1);
+                if (index >= regions->size())
+                {
+                    break;
+                }
+                ProcessRegion((*regions)[index]);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_jobMutex);
+                m_workersBusy--;
+            }
+            m_jobDoneCondition.notify_one();
+        }
+    }
+
+    void BlockTickScheduler::ProcessRegion(TickRegion& region)
+    {
+        ChunkTickState& state = *region.states[1][1];
+
+        // New ticks are always scheduled at least one tick ahead, so this terminates
+        while (!state.queue.empty() && state.queue.top().tick <= m_currentTick)
+        {
+            ScheduledTick scheduled = state.queue.top();
+            state.queue.pop();
+
+            int index = scheduled.index;
+            state.scheduled[index / CHUNK_SECTION_VOLUME].erase(static_cast<uint16_t>(index % CHUNK_SECTION_VOLUME));
+
+            int y = index / (CHUNK_SIZE_X * CHUNK_SIZE_Z);
+            int z = (index / CHUNK_SIZE_X) % CHUNK_SIZE_Z;
+            int x = index % CHUNK_SIZE_X;
+            UpdateBlock(region, x, y, z);
+            region.processed++;
+        }
+    }
+
+    void BlockTickScheduler::UpdateBlock(TickRegion& region, int x, int y, int z)
+    {
+        BlockType type = GetType(region, x, y, z);
+
+        if (type == BlockType::Sand || type == BlockType::Gravel)
+        {
+            // Fall one block per tick step while there is air below
+            if (y > 0 && GetType(region, x, y - 1, z) == BlockType::Air)
+            {
+                SetType(region, x, y - 1, z, type);
+                SetType(region, x, y, z, BlockType::Air);
+                NotifyNeighboursInRegion(region, x, y, z);
+                NotifyNeighboursInRegion(region, x, y - 1, z);
+            }
+            return;
+        }
+
+        if (type != BlockType::Water)
+        {
+            return;
+        }
+
+        uint8_t level = GetWaterLevel(region, x, y, z);
+
+        // Flowing water needs water above it or a neighbour closer to a source
+        if (level > 0)
+        {
+            bool fed = GetType(region, x, y + 1, z) == BlockType::Water;
+            for (int i = 0; i < 4 && !fed; i++)
+            {
+                int nx = x + HORIZONTAL_OFFSETS[i][0];
+                int nz = z + HORIZONTAL_OFFSETS[i][1];
+                fed = GetType(region, nx, y, nz) == BlockType::Water && GetWaterLevel(region, nx, y, nz) < level;
+            }
+
+            if (!fed)
+            {
+                SetType(region, x, y, z, BlockType::Air);
+                SetWaterLevel(region, x, y, z, 0);
+                NotifyNeighboursInRegion(region, x, y, z);
+                return;
+            }
+        }
+
+        // Fall first, spread sideways only when resting on something solid
+        BlockType below = (y > 0) ? GetType(region, x, y - 1, z) : BlockType::Bedrock;
+        if (below == BlockType::Air)
+        {
+            SetType(region, x, y - 1, z, BlockType::Water);
+            SetWaterLevel(region, x, y - 1, z, 1);
+            ScheduleInRegion(region, x, y - 1, z);
+            return;
+        }
+
+        if (below == BlockType::Water || level >= MAX_WATER_LEVEL)
+        {
+            return;
+        }
+
+        uint8_t spreadLevel = static_cast<uint8_t>(level + 1);
+        for (int i = 0; i < 4; i++)
+        {
+            int nx = x + HORIZONTAL_OFFSETS[i][0];
+            int nz = z + HORIZONTAL_OFFSETS[i][1];
+            BlockType neighbour = GetType(region, nx, y, nz);
+
+            if (neighbour == BlockType::Air)
+            {
+                SetType(region, nx, y, nz, BlockType::Water);
+                SetWaterLevel(region, nx, y, nz, spreadLevel);
+                ScheduleInRegion(region, nx, y, nz);
+            }
+            else if (neighbour == BlockType::Water && GetWaterLevel(region, nx, y, nz) > spreadLevel)
+            {
+                SetWaterLevel(region, nx, y, nz, spreadLevel);
+                ScheduleInRegion(region, nx, y, nz);
+            }
+        }
+    }
+
+    BlockType BlockTickScheduler::GetType(TickRegion& region, int x, int y, int z) const
+    {
+        if (y < 0)
+        {
+            return BlockType::Bedrock;
+        }
+        if (y >= CHUNK_SIZE_Y)
+        {
+            return BlockType::Air;
+        }
+
+        int slotX = NeighbourSlot(x, CHUNK_SIZE_X);
+        int slotZ = NeighbourSlot(z, CHUNK_SIZE_Z);
+        Chunk* chunk = region.chunks[slotX][slotZ];
+        if (!chunk)
+        {
+            return BlockType::Bedrock;  // Unloaded neighbours act as solid walls
+        }
+
+        return chunk->GetBlock(x - (slotX - 1) * CHUNK_SIZE_X, y, z - (slotZ - 1) * CHUNK_SIZE_Z).GetType();
+    }
+
+    void BlockTickScheduler::SetType(TickRegion& region, int x, int y, int z, BlockType type)
+    {
+        int slotX = NeighbourSlot(x, CHUNK_SIZE_X);
+        int slotZ = NeighbourSlot(z, CHUNK_SIZE_Z);
+        Chunk* chunk = region.chunks[slotX][slotZ];
+        if (!chunk || y < 0 || y >= CHUNK_SIZE_Y)
+        {
+            return;
+        }
+
+        int localX = x - (slotX - 1) * CHUNK_SIZE_X;
+        int localZ = z - (slotZ - 1) * CHUNK_SIZE_Z;
+        bool solidChanged = BlockRegistry::IsSolid(chunk->GetBlock(localX, y, localZ).GetType()) != BlockRegistry::IsSolid(type);
+        chunk->SetBlock(localX, y, localZ, type);
+
+        // Border blocks also change the neighbouring chunk's collision, which has faces against it
+        region.changedBlocks.emplace_back(region.chunkX * CHUNK_SIZE_X + x, y, region.chunkZ * CHUNK_SIZE_Z + z);
+        if (solidChanged)
+        {
+            AddChunkAndBorderNeighbours(region.collisionChunks, region.chunkX + slotX - 1, region.chunkZ + slotZ - 1, localX, localZ);
+        }
+    }
+
+    uint8_t BlockTickScheduler::GetWaterLevel(TickRegion& region, int x, int y, int z) const
+    {
+        int slotX = NeighbourSlot(x, CHUNK_SIZE_X);
+        int slotZ = NeighbourSlot(z, CHUNK_SIZE_Z);
+        ChunkTickState* state = region.states[slotX][slotZ];
+        if (!state)
+        {
+            return 0;
+        }
+
+        auto it = state->waterLevels.find(ChunkIndex(x - (slotX - 1) * CHUNK_SIZE_X, y, z - (slotZ - 1) * CHUNK_SIZE_Z));
+        return it != state->waterLevels.end() ? it->second : 0;
+    }
+
+    void BlockTickScheduler::SetWaterLevel(TickRegion& region, int x, int y, int z, uint8_t level)
+    {
+        int slotX = NeighbourSlot(x, CHUNK_SIZE_X);
+        int slotZ = NeighbourSlot(z, CHUNK_SIZE_Z);
+        ChunkTickState* state = region.states[slotX][slotZ];
+        if (!state)
+        {
+            return;
+        }
+
+        int index = ChunkIndex(x - (slotX - 1) * CHUNK_SIZE_X, y, z - (slotZ - 1) * CHUNK_SIZE_Z);
+        if (level == 0)
+        {
+            state->waterLevels.erase(index);
+        }
+        else
+        {
+            state->waterLevels[index] = level;
+        }
+    }
+
+    void BlockTickScheduler::ScheduleInRegion(TickRegion& region, int x, int y, int z)
+    {
+        if (y < 0 || y >= CHUNK_SIZE_Y)
+        {
+            return;
+        }
+
+        BlockType type = GetType(region, x, y, z);
+        if (!IsTickable(type))
+        {
+            return;
+        }
+
+        int slotX = NeighbourSlot(x, CHUNK_SIZE_X);
+        int slotZ = NeighbourSlot(z, CHUNK_SIZE_Z);
+        ChunkTickState* state = region.states[slotX][slotZ];
+        if (!state)
+        {
+            return;
+        }
+
+        int index = ChunkIndex(x - (slotX - 1) * CHUNK_SIZE_X, y, z - (slotZ - 1) * CHUNK_SIZE_Z);
+        Schedule(*state, index, m_currentTick + GetTickDelay(type));
+    }
+
+    void BlockTickScheduler::NotifyNeighboursInRegion(TickRegion& region, int x, int y, int z)
+    {
+        ScheduleInRegion(region, x, y, z);
+        ScheduleInRegion(region, x, y + 1, z);
+        ScheduleInRegion(region, x, y - 1, z);
+        for (int i = 0; i < 4; i++)
+        {
+            ScheduleInRegion(region, x + HORIZONTAL_OFFSETS[i][0], y, z + HORIZONTAL_OFFSETS[i][1]);
+        }
+    }
+
+    bool BlockTickScheduler::IsTickable(BlockType type)
+    {
+        return type == BlockType::Sand || type == BlockType::Gravel || type == BlockType::Water;
+    }
+
+    int BlockTickScheduler::GetTickDelay(BlockType type)
+    {
+        return type == BlockType::Water ? WATER_DELAY : FALL_DELAY;
+    }
+
+    void BlockTickScheduler::Schedule(ChunkTickState& state, int index, uint64_t tick)
+    {
+        // One pending tick per block; the section set makes the check O(1)
+        uint16_t sectionIndex = static_cast<uint16_t>(index % CHUNK_SECTION_VOLUME);
+        if (!state.scheduled[index / CHUNK_SECTION_VOLUME].insert(sectionIndex).second)
+        {
+            return;
+        }
+
+        state.queue.push(ScheduledTick{tick, state.nextSequence++, index});
+    }
+
+    void BlockTickScheduler::ScheduleTick(int worldX, int worldY, int worldZ, int delayTicks)
+    {
+        if (!m_world || worldY < 0 || worldY >= CHUNK_SIZE_Y)
+        {
+            return;
+        }
+
+        auto chunkCoords = World::GetChunkCoords(worldX, worldZ);
+        if (!m_world->GetChunk(chunkCoords.first, chunkCoords.second))
+        {
+            return;
+        }
+
+        glm::ivec3 local = Chunk::WorldToLocal(worldX, worldY, worldZ);
+        Schedule(m_states[chunkCoords], ChunkIndex(local.x, local.y, local.z),
+                 m_currentTick + static_cast<uint64_t>(std::max(1, delayTicks)));
+    }
+
+    void BlockTickScheduler::NotifyBlockChanged(int worldX, int worldY, int worldZ)
+    {
+        if (!m_world || worldY < 0 || worldY >= CHUNK_SIZE_Y)
+        {
+            return;
+        }
+
+        // An edited block is never flowing water: either something else, or a freshly placed source
+        auto chunkCoords = World::GetChunkCoords(worldX, worldZ);
+        auto stateIt = m_states.find(chunkCoords);
+        if (stateIt != m_states.end())
+        {
+            glm::ivec3 local = Chunk::WorldToLocal(worldX, worldY, worldZ);
+            stateIt->second.waterLevels.erase(ChunkIndex(local.x, local.y, local.z));
+        }
+
+        const int offsets[7][3] = {{0, 0, 0}, {0, 1, 0}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 0, -1}, {0, 0, 1}};
+        for (const auto& offset : offsets)
+        {
+            int x = worldX + offset[0];
+            int y = worldY + offset[1];
+            int z = worldZ + offset[2];
+            if (y < 0 || y >= CHUNK_SIZE_Y)
+            {
+                continue;
+            }
+
+            BlockType type = static_cast<const World*>(m_world)->GetBlock(x, y, z).GetType();
+            if (IsTickable(type))
+            {
+                ScheduleTick(x, y, z, GetTickDelay(type));
+            }
+        }
+    }
+
+    void BlockTickScheduler::UnloadChunk(int chunkX, int chunkZ)
+    {
+        // Pending ticks and flowing water levels are not persisted
+        auto coord = std::make_pair(chunkX, chunkZ);
+        m_states.erase(coord);
+        m_collisionChunks.erase(coord);
+        m_terrainPending.erase(coord);
+        m_changedBlocks.erase(std::remove_if(m_changedBlocks.begin(), m_changedBlocks.end(),
+                                             [&coord](const glm::ivec3& block) { return World::GetChunkCoords(block.x, block.z) == coord; }),
+                              m_changedBlocks.end());
+    }
+
+    void BlockTickScheduler::SetTerrainPending(int chunkX, int chunkZ, bool pending)
+    {
+        if (pending)
+        {
+            m_terrainPending.insert(std::make_pair(chunkX, chunkZ));
+        }
+        else
+        {
+            m_terrainPending.erase(std::make_pair(chunkX, chunkZ));
+        }
+    }
+
+    void BlockTickScheduler::TakeChangedBlocks(std::vector<glm::ivec3>& changedBlocks)
+    {
+        changedBlocks.swap(m_changedBlocks);
+        m_changedBlocks.clear();
+    }
+
+    void BlockTickScheduler::TakeCollisionChangedChunks(std::vector<std::pair<int, int>>& collisionChunks)
+    {
+        collisionChunks.assign(m_collisionChunks.begin(), m_collisionChunks.end());
+        m_collisionChunks.clear();
+    }
+
+    size_t BlockTickScheduler::GetActiveBlockCount() const
+    {
+        size_t count = 0;
+        for (const auto& [coord, state] : m_states)
+        {
+            count += state.queue.size();
+        }
+        return count;
+    }
+
+    size_t BlockTickScheduler::GetActiveChunkCount() const
+    {
+        size_t count = 0;
+        for (const auto& [coord, state] : m_states)
+        {
+            if (!state.queue.empty())
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+}
@@ -23,7 +23,8 @@ namespace MinecraftClone
             false,  // isLiquid
             false,  // isOpaque
             0.0f,   // hardness
-            0.0f    // resistance
+            0.0f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Grass
@@ -33,7 +34,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             0.6f,   // hardness
-            0.6f    // resistance
+            0.6f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Dirt
@@ -43,7 +45,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             0.5f,   // hardness
-            0.5f    // resistance
+            0.5f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Stone
@@ -53,7 +56,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             1.5f,   // hardness
-            6.0f    // resistance
+            6.0f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Cobblestone
@@ -63,7 +67,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             2.0f,   // hardness
-            6.0f    // resistance
+            6.0f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Sand
@@ -73,7 +78,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             0.5f,   // hardness
-            0.5f    // resistance
+            0.5f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Gravel
@@ -83,7 +89,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             0.6f,   // hardness
-            0.6f    // resistance
+            0.6f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Wood
@@ -93,7 +100,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             2.0f,   // hardness
-            3.0f    // resistance
+            3.0f,   // resistance
+            RenderLayer::Opaque  // renderLayer
         };
 
         // Leaves
@@ -103,7 +111,8 @@ namespace MinecraftClone
             false,  // isLiquid
             false,  // isOpaque
             0.2f,   // hardness
-            0.2f    // resistance
+            0.2f,   // resistance
+            RenderLayer::Cutout  // renderLayer
         };
 
         // Water
@@ -113,7 +122,8 @@ namespace MinecraftClone
             true,   // isLiquid
             false,  // isOpaque
             0.0f,   // hardness (can't break water)
-            0.0f    // resistance
+            0.0f,   // resistance
+            RenderLayer::Translucent  // renderLayer
         };
 
         // Glass
@@ -123,7 +133,8 @@ namespace MinecraftClone
             false,  // isLiquid
             false,  // isOpaque
             0.3f,   // hardness
-            0.3f    // resistance
+            0.3f,   // resistance
+            RenderLayer::Translucent  // renderLayer
         };
 
         // Bedrock
@@ -133,7 +144,8 @@ namespace MinecraftClone
             false,  // isLiquid
             true,   // isOpaque
             -1.0f,  // hardness (unbreakable)
-            -1.0f   // resistance (unbreakable)
+            -1.0f,  // resistance (unbreakable)
+            RenderLayer::Opaque  // renderLayer
         };
 
         s_initialized = true;
@@ -167,4 +179,14 @@ namespace MinecraftClone
     {
         return GetProperties(type).isOpaque;
     }
+
+    bool BlockRegistry::IsOccluder(BlockType type)
+    {
+        return type != BlockType::Air && !IsTransparent(type);
+    }
+
+    RenderLayer BlockRegistry::GetRenderLayer(BlockType type)
+    {
+        return GetProperties(type).renderLayer;
+    }
 }
\ No newline at end of file
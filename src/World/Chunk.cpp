@@ -66,6 +66,37 @@ namespace MinecraftClone
         }
     }
 
+    void Chunk::SetSectionTypes(int sectionY, const BlockType* types)
+    {
+        if (sectionY < 0 || sectionY >= CHUNK_SECTION_COUNT || !types)
+        {
+            return;
+        }
+
+        // Sections are contiguous in y-major storage, so this is a straight copy of the type bytes
+        Block* blocks = m_blocks.data() + sectionY * CHUNK_SECTION_VOLUME;
+        for (int i = 0; i < CHUNK_SECTION_VOLUME; i++)
+        {
+            blocks[i].SetType(types[i]);
+        }
+        m_needsMeshUpdate = true;
+    }
+
+    void Chunk::FillSection(int sectionY, BlockType type)
+    {
+        if (sectionY < 0 || sectionY >= CHUNK_SECTION_COUNT)
+        {
+            return;
+        }
+
+        Block* blocks = m_blocks.data() + sectionY * CHUNK_SECTION_VOLUME;
+        for (int i = 0; i < CHUNK_SECTION_VOLUME; i++)
+        {
+            blocks[i].SetType(type);
+        }
+        m_needsMeshUpdate = true;
+    }
+
     void Chunk::SetChunkPosition(int chunkX, int chunkZ)
     {
         m_chunkX = chunkX;
@@ -110,4 +141,28 @@ namespace MinecraftClone
         }
         return true;
     }
+
+    void Chunk::CalculateSkyLight()
+    {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++)
+        {
+            for (int x = 0; x < CHUNK_SIZE_X; x++)
+            {
+                int light = 15;
+                for (int y = CHUNK_SIZE_Y - 1; y >= 0; y--)
+                {
+                    Block& block = m_blocks[GetIndex(x, y, z)];
+                    if (block.IsOpaque())
+                    {
+                        light = 0;
+                    }
+                    else if (!block.IsAir() && light > 0)
+                    {
+                        light--;  // Water, leaves and glass let some light through
+                    }
+                    block.SetSkyLight(static_cast<uint8_t>(light));
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -5,9 +5,12 @@
 #include "World/ChunkManager.h"
 #include "Physics/PhysicsManager.h"
 #include "World/ChunkMeshGenerator.h"
+#include "World/WorldStorage.h"
+#include "World/BlockTickScheduler.h"
 #include <spdlog/spdlog.h>
 #include <chrono>
 #include <algorithm>
+#include <bitset>
 
 namespace MinecraftClone
 {
@@ -16,6 +19,10 @@ namespace MinecraftClone
         , m_terrainGenerator(nullptr)
         , m_chunkRenderer(nullptr)
         , m_physicsManager(nullptr)
+        , m_worldStorage(nullptr)
+        , m_blockTickScheduler(nullptr)
+        , m_loadedChunkCount(0)
+        , m_pendingPhysicsCount(0)
         , m_currentChunk(0, 0)
         , m_lastUpdateChunk(INT_MAX, INT_MAX)
         , m_renderDistance(8)  // Default render distance
@@ -23,6 +30,11 @@ namespace MinecraftClone
         , m_initialized(false)
         , m_lastUpdateTime(0.0f)
         , m_shouldStopWorkers(false)
+        , m_remeshTasksInFlight(0)
+        , m_remeshCenter(0, 0)
+        , m_lastRemeshLatencyMs(0.0)
+        , m_borderRefreshCount(0)
+        , m_borderRefreshSections(0)
     {
     }
 
@@ -93,66 +105,33 @@ namespace MinecraftClone
         int centerChunkX = chunkCoords.first;
         int centerChunkZ = chunkCoords.second;
 
-        // Determine which chunks should be loaded
-        std::set<std::pair<int, int>> chunksToLoad;
-        for (int chunkX = centerChunkX - m_renderDistance; chunkX <= centerChunkX + m_renderDistance; chunkX++)
-        {
-            for (int chunkZ = centerChunkZ - m_renderDistance; chunkZ <= centerChunkZ + m_renderDistance; chunkZ++)
+        // OPTIMIZATION 19: Ring-buffer chunk grid
+        // Chunk state lives in a toroidal array around the player's chunk instead of a tree: moving
+        // the window unloads exactly the chunks it leaves (beyond the load distance), and the chunks
+        // to load are found by walking square rings outward, so they are queued nearest first
+        // without sorting and each "already known" check is one slot lookup.
+        const int windowRadius = std::max(m_renderDistance, m_loadDistance);
+        m_chunks.SetWindow(centerChunkX, centerChunkZ, windowRadius, [this](int chunkX, int chunkZ, ChunkSlot& slot) {
+            UnloadChunk(chunkX, chunkZ, slot);  // Queued chunks are skipped when the queue reaches them
+        });
+        m_chunkRenderer->SetChunkWindow(centerChunkX, centerChunkZ, windowRadius);
+
+        ChunkGrid<ChunkSlot>::ForEachInRings(centerChunkX, centerChunkZ, m_renderDistance, [this](int chunkX, int chunkZ) {
+            if (!m_chunks.Find(chunkX, chunkZ))
             {
-                if (ShouldLoadChunk(chunkX, chunkZ, centerChunkX, centerChunkZ))
-                {
-                    chunksToLoad.insert(std::make_pair(chunkX, chunkZ));
-                }
+                m_chunks.Insert(chunkX, chunkZ)->state = ChunkState::Queued;
+                m_chunksToLoad.push_back(std::make_pair(chunkX, chunkZ));
             }
-        }
-
-        // Queue new chunks for loading (prioritize chunks closer to player)
-        std::vector<std::pair<int, int>> chunksToQueue;
-        for (const auto& chunkCoord : chunksToLoad)
-        {
-            // Check if already loaded or already queued
-            bool alreadyLoaded = m_loadedChunks.find(chunkCoord) != m_loadedChunks.end();
-            bool alreadyQueued = std::find(m_chunksToLoad.begin(), m_chunksToLoad.end(), chunkCoord) != m_chunksToLoad.end();
-            
-            if (!alreadyLoaded && !alreadyQueued)
-            {
-                chunksToQueue.push_back(chunkCoord);
-            }
-        }
-        
-        // Sort by distance from center (closer chunks first)
-        std::sort(chunksToQueue.begin(), chunksToQueue.end(), 
-            [centerChunkX, centerChunkZ](const std::pair<int, int>& a, const std::pair<int, int>& b) {
-                int distA = std::max(std::abs(a.first - centerChunkX), std::abs(a.second - centerChunkZ));
-                int distB = std::max(std::abs(b.first - centerChunkX), std::abs(b.second - centerChunkZ));
-                return distA < distB;
-            });
-        
-        // Add to queue in priority order
-        m_chunksToLoad.insert(m_chunksToLoad.end(), chunksToQueue.begin(), chunksToQueue.end());
-
-        // Unload chunks that are too far away
-        std::vector<std::pair<int, int>> chunksToUnload;
-        for (const auto& chunkCoord : m_loadedChunks)
-        {
-            if (ShouldUnloadChunk(chunkCoord.first, chunkCoord.second, centerChunkX, centerChunkZ))
-            {
-                chunksToUnload.push_back(chunkCoord);
-            }
-        }
-
-        for (const auto& chunkCoord : chunksToUnload)
-        {
-            UnloadChunk(chunkCoord.first, chunkCoord.second);
-        }
+            return true;
+        });
 
         // Only log when chunk count changes significantly
         static size_t lastChunkCount = 0;
-        if (std::abs(static_cast<int>(m_loadedChunks.size()) - static_cast<int>(lastChunkCount)) > 5)
+        if (std::abs(static_cast<int>(m_loadedChunkCount) - static_cast<int>(lastChunkCount)) > 5)
         {
             spdlog::info("ChunkManager: Loaded {} chunks, current chunk: ({}, {})",
-                         m_loadedChunks.size(), centerChunkX, centerChunkZ);
-            lastChunkCount = m_loadedChunks.size();
+                         m_loadedChunkCount, centerChunkX, centerChunkZ);
+            lastChunkCount = m_loadedChunkCount;
         }
     }
 
@@ -173,10 +152,15 @@ namespace MinecraftClone
                 break;
             }
             
-            // Process from front of queue (highest priority)
+            // Process from front of queue (highest priority); chunks the window left since are gone
             auto chunkCoord = m_chunksToLoad.front();
-            LoadChunk(chunkCoord.first, chunkCoord.second, false);  // Don't add physics immediately
             m_chunksToLoad.erase(m_chunksToLoad.begin());
+            const ChunkSlot* slot = m_chunks.Find(chunkCoord.first, chunkCoord.second);
+            if (!slot || slot->state != ChunkState::Queued)
+            {
+                continue;
+            }
+            LoadChunk(chunkCoord.first, chunkCoord.second, false);  // Don't add physics immediately
             chunksLoadedThisFrame++;
         }
         
@@ -187,19 +171,30 @@ namespace MinecraftClone
     void ChunkManager::ProcessPhysicsQueue()
     {
         // Process physics collision for only 1 chunk per frame (very expensive)
-        if (!m_chunksPendingPhysics.empty() && m_physicsManager)
+        // (the nearest to the player first)
+        if (m_pendingPhysicsCount > 0 && m_physicsManager)
         {
-            auto it = m_chunksPendingPhysics.begin();
-            int chunkX = it->first;
-            int chunkZ = it->second;
-            
-            Chunk* chunk = m_world->GetChunk(chunkX, chunkZ);
-            if (chunk)
-            {
-                m_physicsManager->AddChunkCollision(chunk, chunkX, chunkZ, m_world);
-            }
-            
-            m_chunksPendingPhysics.erase(it);
+            m_chunks.ForEachNearestFirst([this](int chunkX, int chunkZ, ChunkSlot& slot) {
+                if (!slot.physicsPending)
+                {
+                    return true;
+                }
+
+                Chunk* chunk = m_world->GetChunk(chunkX, chunkZ);
+                if (chunk && slot.rebuildCollision)
+                {
+                    m_physicsManager->UpdateChunkCollision(chunk, chunkX, chunkZ, m_world);
+                }
+                else if (chunk)
+                {
+                    m_physicsManager->AddChunkCollision(chunk, chunkX, chunkZ, m_world);
+                }
+
+                slot.physicsPending = false;
+                slot.rebuildCollision = false;
+                m_pendingPhysicsCount--;
+                return false;
+            });
         }
     }
 
@@ -223,23 +218,271 @@ namespace MinecraftClone
         
         {
             std::lock_guard<std::mutex> lock(m_generationQueueMutex);
-            m_generationQueue.push(ChunkGenerationTask(chunkX, chunkZ, needsTerrain));
+            m_generationQueue.push_back(ChunkGenerationTask(chunkX, chunkZ, needsTerrain));
+            if (needsTerrain)
+            {
+                m_generatedChunks.erase(std::make_pair(chunkX, chunkZ));
+            }
         }
         m_generationCondition.notify_one();
 
+        // Block ticks keep out of the chunk until a worker has finished writing its terrain
+        if (needsTerrain && m_blockTickScheduler)
+        {
+            m_blockTickScheduler->SetTerrainPending(chunkX, chunkZ, true);
+        }
+
         // Mark as loaded (will be finalized when mesh is ready)
-        m_loadedChunks.insert(std::make_pair(chunkX, chunkZ));
+        ChunkSlot* slot = m_chunks.Insert(chunkX, chunkZ);
+        if (!slot)
+        {
+            return;  // LoadChunk is only called for chunks in the window
+        }
+        if (slot->state != ChunkState::Loaded)
+        {
+            slot->state = ChunkState::Loaded;
+            m_loadedChunkCount++;
+        }
         
         // Add physics collision to pending queue (will be processed when mesh is ready)
-        if (m_physicsManager && !addPhysicsImmediately)
+        if (m_physicsManager && !addPhysicsImmediately && !slot->physicsPending)
+        {
+            slot->physicsPending = true;
+            m_pendingPhysicsCount++;
+        }
+    }
+
+    void ChunkManager::RemeshAllChunks()
+    {
+        // Every loaded chunk through the remesh queue (terrain is already present), so the full
+        // remeshes merge with and are ordered against any edit remeshes of the same chunks
+        m_chunks.ForEach([this](int chunkX, int chunkZ, const ChunkSlot& slot) {
+            if (slot.state == ChunkState::Loaded)
+            {
+                QueueRemesh(chunkX, chunkZ, ChunkMeshGenerator::ALL_SECTIONS, false);
+            }
+        });
+    }
+
+    void ChunkManager::RequestRemesh(int chunkX, int chunkZ, uint32_t sectionMask)
+    {
+        QueueRemesh(chunkX, chunkZ, sectionMask, true);
+    }
+
+    void ChunkManager::QueueRemesh(int chunkX, int chunkZ, uint32_t sectionMask, bool isEdit)
+    {
+        sectionMask &= ChunkMeshGenerator::ALL_SECTIONS;
+        if (sectionMask == 0)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_generationQueueMutex);
+            auto inserted = m_pendingRemeshes.try_emplace(std::make_pair(chunkX, chunkZ));
+            PendingRemesh& pending = inserted.first->second;
+            if (inserted.second)
+            {
+                pending.requestTime = std::chrono::steady_clock::now();
+            }
+            pending.sectionMask |= sectionMask;
+            pending.isEdit = pending.isEdit || isEdit;
+            m_remeshCenter = m_currentChunk;
+        }
+        m_generationCondition.notify_one();
+    }
+
+    void ChunkManager::RequestBlockRemesh(int worldX, int worldY, int worldZ)
+    {
+        SectionRemesh updates[ChunkMeshGenerator::MAX_AFFECTED_CHUNKS];
+        int updateCount = ChunkMeshGenerator::GetSectionsAffectedByBlock(worldX, worldY, worldZ, updates);
+        for (int i = 0; i < updateCount; i++)
+        {
+            RequestRemesh(updates[i].chunkX, updates[i].chunkZ, updates[i].sectionMask);
+        }
+    }
+
+    void ChunkManager::RequestChunkRemesh(int chunkX, int chunkZ)
+    {
+        QueueRemesh(chunkX, chunkZ, ChunkMeshGenerator::ALL_SECTIONS, false);
+    }
+
+    void ChunkManager::RequestCollisionRebuild(int chunkX, int chunkZ)
+    {
+        // A chunk still waiting for its first collision will read the current blocks anyway
+        ChunkSlot* slot = m_chunks.Find(chunkX, chunkZ);
+        if (!m_physicsManager || !slot || slot->state != ChunkState::Loaded || slot->physicsPending)
+        {
+            return;
+        }
+
+        slot->physicsPending = true;
+        slot->rebuildCollision = true;
+        m_pendingPhysicsCount++;
+    }
+
+    size_t ChunkManager::GetPendingRemeshCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_generationQueueMutex);
+        return m_pendingRemeshes.size() + m_remeshTasksInFlight;
+    }
+
+    bool ChunkManager::TakeRemeshTask(ChunkGenerationTask& task)
+    {
+        // Nearest pending chunk that no other worker is meshing
+        auto best = m_pendingRemeshes.end();
+        int bestDistance = INT_MAX;
+        for (auto it = m_pendingRemeshes.begin(); it != m_pendingRemeshes.end(); ++it)
+        {
+            if (m_remeshesInFlight.count(it->first) != 0)
+            {
+                continue;
+            }
+
+            int distance = GetChunkDistance(it->first.first, it->first.second, m_remeshCenter.first, m_remeshCenter.second);
+            if (distance < bestDistance)
+            {
+                best = it;
+                bestDistance = distance;
+            }
+        }
+
+        if (best == m_pendingRemeshes.end())
+        {
+            return false;
+        }
+
+        task = ChunkGenerationTask(best->first.first, best->first.second, false);
+        task.sectionMask = best->second.sectionMask;
+        task.isRemesh = true;
+        task.isEdit = best->second.isEdit;
+        task.requestTime = best->second.requestTime;
+
+        m_remeshesInFlight.insert(best->first);
+        m_remeshTasksInFlight++;
+        m_pendingRemeshes.erase(best);
+        return true;
+    }
+
+    bool ChunkManager::TakeGenerationTask(ChunkGenerationTask& task)
+    {
+        // Oldest task whose chunk no other worker is meshing
+        for (auto it = m_generationQueue.begin(); it != m_generationQueue.end(); ++it)
+        {
+            auto coord = std::make_pair(it->chunkX, it->chunkZ);
+            if (m_remeshesInFlight.count(coord) == 0)
+            {
+                task = *it;
+                m_generationQueue.erase(it);
+                m_remeshesInFlight.insert(coord);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint16_t ChunkManager::GetMissingNeighbors(int chunkX, int chunkZ) const
+    {
+        uint16_t missing = 0;
+        for (int dz = -1; dz <= 1; dz++)
         {
-            m_chunksPendingPhysics.insert(std::make_pair(chunkX, chunkZ));
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                if ((dx != 0 || dz != 0) && m_generatedChunks.count(std::make_pair(chunkX + dx, chunkZ + dz)) == 0)
+                {
+                    missing |= NeighborBit(dx, dz);
+                }
+            }
+        }
+        return missing;
+    }
+
+    void ChunkManager::TrackMissingNeighbors(int chunkX, int chunkZ, uint16_t missingNeighbors)
+    {
+        // Neighbours that arrived while this mesh was being built are refreshed right away; the rest
+        // wait in m_missingNeighbors for RefreshNeighborBorders
+        uint16_t arrived = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_generationQueueMutex);
+            for (int dz = -1; dz <= 1; dz++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    if ((missingNeighbors & NeighborBit(dx, dz)) != 0
+                        && m_generatedChunks.count(std::make_pair(chunkX + dx, chunkZ + dz)) != 0)
+                    {
+                        arrived |= NeighborBit(dx, dz);
+                    }
+                }
+            }
+        }
+
+        if ((missingNeighbors & ~arrived) != 0)
+        {
+            m_missingNeighbors[std::make_pair(chunkX, chunkZ)] |= static_cast<uint16_t>(missingNeighbors & ~arrived);
+        }
+        for (int dz = -1; dz <= 1; dz++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                if ((arrived & NeighborBit(dx, dz)) != 0)
+                {
+                    RequestBorderRefresh(chunkX, chunkZ, dx, dz);
+                }
+            }
+        }
+    }
+
+    void ChunkManager::RefreshNeighborBorders(int chunkX, int chunkZ)
+    {
+        // Every chunk around this one that was meshed without it
+        for (int dz = -1; dz <= 1; dz++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                if (dx == 0 && dz == 0)
+                {
+                    continue;
+                }
+
+                auto it = m_missingNeighbors.find(std::make_pair(chunkX + dx, chunkZ + dz));
+                const uint16_t bit = NeighborBit(-dx, -dz);
+                if (it == m_missingNeighbors.end() || (it->second & bit) == 0)
+                {
+                    continue;
+                }
+
+                it->second = static_cast<uint16_t>(it->second & ~bit);
+                if (it->second == 0)
+                {
+                    m_missingNeighbors.erase(it);
+                }
+                RequestBorderRefresh(chunkX + dx, chunkZ + dz, -dx, -dz);
+            }
         }
     }
 
-    void ChunkManager::UnloadChunk(int chunkX, int chunkZ)
+    void ChunkManager::RequestBorderRefresh(int chunkX, int chunkZ, int dx, int dz)
     {
-        if (!m_world || !m_chunkRenderer)
+        // Only the sections with blocks along that border; they merge with any other pending remesh
+        Chunk* chunk = m_world->GetChunk(chunkX, chunkZ);
+        if (!chunk)
+        {
+            return;
+        }
+
+        uint32_t sections = ChunkMeshGenerator::GetBorderSections(*chunk, dx, dz);
+        if (sections != 0)
+        {
+            QueueRemesh(chunkX, chunkZ, sections, false);
+            m_borderRefreshCount++;
+            m_borderRefreshSections += std::bitset<CHUNK_SECTION_COUNT>(sections).count();
+        }
+    }
+
+    void ChunkManager::UnloadChunk(int chunkX, int chunkZ, ChunkSlot& slot)
+    {
+        if (!m_world || !m_chunkRenderer || slot.state != ChunkState::Loaded)
         {
             return;
         }
@@ -251,7 +494,18 @@ namespace MinecraftClone
         }
 
         // Remove from physics pending queue if present
-        m_chunksPendingPhysics.erase(std::make_pair(chunkX, chunkZ));
+        if (slot.physicsPending)
+        {
+            slot.physicsPending = false;
+            slot.rebuildCollision = false;
+            m_pendingPhysicsCount--;
+        }
+
+        // Drop pending block ticks
+        if (m_blockTickScheduler)
+        {
+            m_blockTickScheduler->UnloadChunk(chunkX, chunkZ);
+        }
 
         // Unload from renderer
         m_chunkRenderer->UnloadChunk(chunkX, chunkZ);
@@ -259,20 +513,13 @@ namespace MinecraftClone
         // Unload from world
         m_world->UnloadChunk(chunkX, chunkZ);
 
-        // Remove from loaded set
-        m_loadedChunks.erase(std::make_pair(chunkX, chunkZ));
-    }
-
-    bool ChunkManager::ShouldLoadChunk(int chunkX, int chunkZ, int centerChunkX, int centerChunkZ) const
-    {
-        int distance = GetChunkDistance(chunkX, chunkZ, centerChunkX, centerChunkZ);
-        return distance <= m_renderDistance;
-    }
-
-    bool ChunkManager::ShouldUnloadChunk(int chunkX, int chunkZ, int centerChunkX, int centerChunkZ) const
-    {
-        int distance = GetChunkDistance(chunkX, chunkZ, centerChunkX, centerChunkZ);
-        return distance > m_loadDistance;
+        slot.state = ChunkState::Queued;
+        m_loadedChunkCount--;
+        m_missingNeighbors.erase(std::make_pair(chunkX, chunkZ));
+        {
+            std::lock_guard<std::mutex> lock(m_generationQueueMutex);
+            m_generatedChunks.erase(std::make_pair(chunkX, chunkZ));
+        }
     }
 
     int ChunkManager::GetChunkDistance(int chunkX1, int chunkZ1, int chunkX2, int chunkZ2) const
@@ -299,15 +546,17 @@ namespace MinecraftClone
         m_workerThreads.clear();
 
         // Unload all chunks
-        std::vector<std::pair<int, int>> chunksToUnload(m_loadedChunks.begin(), m_loadedChunks.end());
-        for (const auto& chunkCoord : chunksToUnload)
-        {
-            UnloadChunk(chunkCoord.first, chunkCoord.second);
-        }
+        m_chunks.ForEach([this](int chunkX, int chunkZ, ChunkSlot& slot) { UnloadChunk(chunkX, chunkZ, slot); });
 
-        m_loadedChunks.clear();
+        m_chunks.Clear();
+        m_loadedChunkCount = 0;
+        m_pendingPhysicsCount = 0;
         m_chunksToLoad.clear();
-        m_chunksPendingPhysics.clear();
+        m_pendingRemeshes.clear();
+        m_remeshesInFlight.clear();
+        m_remeshTasksInFlight = 0;
+        m_generatedChunks.clear();
+        m_missingNeighbors.clear();
         m_initialized = false;
 
         spdlog::info("ChunkManager shut down");
@@ -324,15 +573,11 @@ namespace MinecraftClone
             {
                 std::unique_lock<std::mutex> lock(m_generationQueueMutex);
                 m_generationCondition.wait(lock, [this] { 
-                    return !m_generationQueue.empty() || m_shouldStopWorkers; 
+                    return HasRunnableRemesh() || HasRunnableGenerationTask() || m_shouldStopWorkers; 
                 });
 
-                if (!m_generationQueue.empty())
-                {
-                    task = m_generationQueue.front();
-                    m_generationQueue.pop();
-                    hasTask = true;
-                }
+                // Edits first: the player is waiting to see them
+                hasTask = TakeRemeshTask(task) || TakeGenerationTask(task);
             }
 
             if (!hasTask)
@@ -344,26 +589,94 @@ namespace MinecraftClone
             Chunk* chunk = m_world->GetChunk(task.chunkX, task.chunkZ);
             if (!chunk)
             {
+                FinishChunkTask(task);
                 continue;
             }
 
             // Generate terrain if needed (this is thread-safe as long as TerrainGenerator doesn't modify shared state)
+            // Pre-generated chunks on disk are loaded instead of paying the generation cost live
             if (task.needsTerrain && m_terrainGenerator)
             {
-                m_terrainGenerator->GenerateChunk(chunk, task.chunkX, task.chunkZ, m_world);
+                bool loadedFromDisk = m_worldStorage && m_worldStorage->LoadChunk(*chunk, task.chunkX, task.chunkZ);
+                if (!loadedFromDisk)
+                {
+                    m_terrainGenerator->GenerateChunk(chunk, task.chunkX, task.chunkZ, m_world);
+                }
+            }
+
+            // A generation task's terrain is complete from here on; note which neighbours this mesh is built without
+            // (before meshing, so a neighbour finishing meanwhile is refreshed rather than assumed)
+            bool terrainArrived = false;
+            uint16_t missingNeighbors = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_generationQueueMutex);
+                terrainArrived = !task.isRemesh && m_generatedChunks.insert(std::make_pair(task.chunkX, task.chunkZ)).second;
+                missingNeighbors = GetMissingNeighbors(task.chunkX, task.chunkZ);
             }
 
             // Generate mesh (this is thread-safe - ChunkMeshGenerator doesn't modify shared state)
-            // Note: GenerateMesh creates the mesh data but doesn't call Build() yet
-            auto mesh = ChunkMeshGenerator::GenerateMesh(chunk, task.chunkX, task.chunkZ, m_world);
+            // Note: section meshing creates the mesh data but doesn't call Build()
+            auto meshes = ChunkMeshGenerator::GenerateSectionMeshes(chunk, task.chunkX, task.chunkZ, m_world,
+                                                                    task.sectionMask,
+                                                                    ChunkMeshGenerator::GetMeshingMode());
+            if (ChunkMeshGenerator::IsLodEnabled())
+            {
+                ChunkMeshGenerator::GenerateLodMeshes(chunk, task.chunkX, task.chunkZ, m_world, meshes);
+            }
             
             // Don't call Build() here - that needs to happen on main thread for OpenGL context
-            // Queue completed mesh for main thread to process
+            // Queue completed meshes for main thread to process
             {
+                CompletedChunkMesh completed(task.chunkX, task.chunkZ, std::move(meshes));
+                completed.isEdit = task.isEdit;
+                completed.terrainArrived = terrainArrived;
+                completed.missingNeighbors = missingNeighbors;
+                completed.requestTime = task.requestTime;
+
                 std::lock_guard<std::mutex> lock(m_completedMeshesMutex);
-                m_completedMeshes.push(CompletedChunkMesh(task.chunkX, task.chunkZ, std::move(mesh)));
+                m_completedMeshes.push(std::move(completed));
+            }
+
+            // Only after the result is queued may another worker mesh this chunk
+            FinishChunkTask(task);
+        }
+    }
+
+    bool ChunkManager::HasRunnableRemesh() const
+    {
+        for (const auto& [coord, pending] : m_pendingRemeshes)
+        {
+            if (m_remeshesInFlight.count(coord) == 0)
+            {
+                return true;
             }
         }
+        return false;
+    }
+
+    bool ChunkManager::HasRunnableGenerationTask() const
+    {
+        for (const ChunkGenerationTask& task : m_generationQueue)
+        {
+            if (m_remeshesInFlight.count(std::make_pair(task.chunkX, task.chunkZ)) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ChunkManager::FinishChunkTask(const ChunkGenerationTask& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_generationQueueMutex);
+            m_remeshesInFlight.erase(std::make_pair(task.chunkX, task.chunkZ));
+            if (task.isRemesh)
+            {
+                m_remeshTasksInFlight--;
+            }
+        }
+        m_generationCondition.notify_all();
     }
 
     void ChunkManager::ProcessCompletedMeshes()
@@ -380,32 +693,59 @@ namespace MinecraftClone
         while (!meshesToProcess.empty())
         {
             auto& completed = meshesToProcess.front();
+
+            // The chunk may have been unloaded while its mesh was being built
+            if (!m_world->GetChunk(completed.chunkX, completed.chunkZ))
+            {
+                meshesToProcess.pop();
+                continue;
+            }
             
-            // Build mesh on main thread (OpenGL context required)
-            if (completed.mesh)
+            // Upload on main thread (OpenGL context required)
+            // Store meshes directly in renderer (bypass UpdateChunk which would regenerate);
+            // every section of the chunk swaps in at once, so a frame never mixes old and new sections
+            if (m_chunkRenderer)
+            {
+                m_chunkRenderer->SetSectionMeshes(completed.chunkX, completed.chunkZ, std::move(completed.meshes));
+            }
+
+            if (completed.isEdit)
+            {
+                auto now = std::chrono::steady_clock::now();
+                m_lastRemeshLatencyMs = std::chrono::duration<double, std::milli>(now - completed.requestTime).count();
+            }
+
+            // OPTIMIZATION 12: Neighbour-arrival border refresh
+            // Chunks are meshed as soon as their own terrain exists, so borders toward neighbours still
+            // being generated are meshed against air and keep wall faces that will be hidden. Each
+            // such neighbour is remembered, and when its terrain arrives only the sections along the
+            // shared border are remeshed.
+            if (completed.terrainArrived)
             {
-                completed.mesh->Build();
-                
-                // Store mesh directly in renderer (bypass UpdateChunk which would regenerate)
-                if (m_chunkRenderer)
+                RefreshNeighborBorders(completed.chunkX, completed.chunkZ);
+                if (m_blockTickScheduler)
                 {
-                    // Store the pre-built mesh in renderer (mesh is already built on main thread)
-                    m_chunkRenderer->SetChunkMesh(completed.chunkX, completed.chunkZ, std::move(completed.mesh));
+                    m_blockTickScheduler->SetTerrainPending(completed.chunkX, completed.chunkZ, false);
                 }
-                
-                // Add physics collision if pending
-                if (m_physicsManager)
+            }
+            if (completed.missingNeighbors != 0)
+            {
+                TrackMissingNeighbors(completed.chunkX, completed.chunkZ, completed.missingNeighbors);
+            }
+            
+            // Add physics collision if pending (first collision only; rebuilds wait their turn in the queue)
+            if (m_physicsManager)
+            {
+                ChunkSlot* slot = m_chunks.Find(completed.chunkX, completed.chunkZ);
+                if (slot && slot->physicsPending && !slot->rebuildCollision)
                 {
-                    auto it = m_chunksPendingPhysics.find(std::make_pair(completed.chunkX, completed.chunkZ));
-                    if (it != m_chunksPendingPhysics.end())
+                    Chunk* chunk = m_world->GetChunk(completed.chunkX, completed.chunkZ);
+                    if (chunk)
                     {
-                        Chunk* chunk = m_world->GetChunk(completed.chunkX, completed.chunkZ);
-                        if (chunk)
-                        {
-                            m_physicsManager->AddChunkCollision(chunk, completed.chunkX, completed.chunkZ, m_world);
-                        }
-                        m_chunksPendingPhysics.erase(it);
+                        m_physicsManager->AddChunkCollision(chunk, completed.chunkX, completed.chunkZ, m_world);
                     }
+                    slot->physicsPending = false;
+                    m_pendingPhysicsCount--;
                 }
             }
 
@@ -7,9 +7,185 @@
 #include "World/World.h"
 #include "World/BlockType.h"
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHUNK_MESH_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace MinecraftClone
 {
+    std::atomic<MeshingMode> ChunkMeshGenerator::s_meshingMode{MeshingMode::Greedy};
+    std::atomic<bool> ChunkMeshGenerator::s_bitmaskCulling{true};
+    std::atomic<bool> ChunkMeshGenerator::s_ambientOcclusion{true};
+    std::atomic<bool> ChunkMeshGenerator::s_scratchReuse{true};
+    std::atomic<bool> ChunkMeshGenerator::s_lodEnabled{false};
+
+    // Bit x of rows[face][y][z] is set when block (x, y, z) is not air and its face is visible.
+    // Only the layers the masks were built for are valid.
+    struct ChunkMeshGenerator::FaceMasks
+    {
+        uint16_t rows[6][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+    };
+
+    // Everything one meshing call needs besides its result. Vectors keep their capacity between
+    // calls, so after the first few jobs a worker meshes without touching the allocator.
+    struct ChunkMeshGenerator::MeshScratch
+    {
+        ChunkMeshInput input;
+        FaceMasks masks;
+        std::vector<uint16_t> occupancy;   // Greedy slices: [slice][v], bit u
+        std::vector<uint16_t> keys;        // Greedy merge keys: [slice][v][u]
+        ChunkMesh mesh;                    // Staging mesh, copied out right-sized
+    };
+
+    namespace
+    {
+        // Neighbour offset per face: 0=front(+Z), 1=back(-Z), 2=left(-X), 3=right(+X), 4=top(+Y), 5=bottom(-Y)
+        const int FACE_OFFSETS[6][3] = {
+            { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+        };
+
+        // Set bits over count consecutive 16-bit rows, four rows per 64-bit SWAR popcount (std::bitset's
+        // count is a library call per row on x86-64 builds without POPCNT)
+        inline size_t CountBits(const uint16_t* rows, size_t count)
+        {
+            size_t total = 0;
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                uint64_t word;
+                std::memcpy(&word, rows + i, sizeof(word));
+                word = word - ((word >> 1) & 0x5555555555555555ull);
+                word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+                word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+                total += static_cast<size_t>((word * 0x0101010101010101ull) >> 56);
+            }
+            for (; i < count; i++)
+            {
+                total += std::bitset<16>(rows[i]).count();
+            }
+            return total;
+        }
+
+        inline int CountTrailingZeros(uint32_t value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctz(value);
+#endif
+        }
+
+        // Mesh bucket per block type
+        struct RenderLayerTable
+        {
+            RenderLayer layers[256] = {};
+
+            RenderLayerTable()
+            {
+                for (size_t type = 1; type < static_cast<size_t>(BlockType::Count); type++)
+                {
+                    layers[type] = BlockRegistry::GetRenderLayer(static_cast<BlockType>(type));
+                }
+            }
+
+            RenderLayer operator()(BlockType type) const { return layers[static_cast<uint8_t>(type)]; }
+        };
+
+        // A face is visible unless its neighbour occludes it or is the same (transparent) block type,
+        // so water and glass volumes only mesh their outer surface
+        inline bool IsFaceVisible(const OccluderTable& occluder, BlockType block, BlockType neighbor)
+        {
+            return !occluder(neighbor) && neighbor != block;
+        }
+
+        // Padded-volume index offsets of each face's normal and of its quad's u / v (AddQuad width / height) axes
+        struct FaceAxes
+        {
+            int normal;
+            int u;
+            int v;
+        };
+
+        constexpr int PADDED_STEP_X = 1;
+        constexpr int PADDED_STEP_Z = ChunkMeshInput::SIZE_X;
+        constexpr int PADDED_STEP_Y = ChunkMeshInput::SIZE_X * ChunkMeshInput::SIZE_Z;
+
+        const FaceAxes FACE_AXES[6] = {
+            {  PADDED_STEP_Z, PADDED_STEP_X, PADDED_STEP_Y },
+            { -PADDED_STEP_Z, PADDED_STEP_X, PADDED_STEP_Y },
+            { -PADDED_STEP_X, PADDED_STEP_Z, PADDED_STEP_Y },
+            {  PADDED_STEP_X, PADDED_STEP_Z, PADDED_STEP_Y },
+            {  PADDED_STEP_Y, PADDED_STEP_X, PADDED_STEP_Z },
+            { -PADDED_STEP_Y, PADDED_STEP_X, PADDED_STEP_Z }
+        };
+
+        // Classic 3-neighbour voxel AO for the four corners of one block face: each corner looks at the
+        // two side cells and the diagonal cell in the layer the face looks into. Packed 2 bits per corner
+        // in ChunkMesh's (u, v) corner order, 3 = open.
+        inline uint8_t ComputeFaceAO(const BlockType* types, const OccluderTable& occluder, int blockIndex, int face)
+        {
+            const FaceAxes& axes = FACE_AXES[face];
+            const BlockType* cell = types + blockIndex + axes.normal;
+            auto solid = [cell, &occluder](int offset) { return occluder(cell[offset]) ? 1 : 0; };
+            auto corner = [](int side1, int side2, int diagonal) {
+                return static_cast<uint8_t>((side1 & side2) ? 0 : 3 - (side1 + side2 + diagonal));
+            };
+
+            const int uMinus = solid(-axes.u);
+            const int uPlus = solid(axes.u);
+            const int vMinus = solid(-axes.v);
+            const int vPlus = solid(axes.v);
+            return static_cast<uint8_t>(corner(uMinus, vMinus, solid(-axes.u - axes.v))
+                                        | corner(uPlus, vMinus, solid(axes.u - axes.v)) << 2
+                                        | corner(uPlus, vPlus, solid(axes.u + axes.v)) << 4
+                                        | corner(uMinus, vPlus, solid(-axes.u + axes.v)) << 6);
+        }
+
+        // A quad with the same AO at all four corners looks the same however far it is stretched
+        inline bool IsUniformAO(uint8_t ao)
+        {
+            return ao == static_cast<uint8_t>((ao & 3u) * 0x55u);
+        }
+
+        // Texture layers looked up once per (block type, face) per mesh instead of once per face
+        class TileCache
+        {
+        public:
+            TileCache()
+            {
+                for (auto& faces : m_tiles)
+                {
+                    for (uint32_t& tile : faces)
+                    {
+                        tile = UNRESOLVED;
+                    }
+                }
+            }
+
+            uint32_t Get(BlockType type, int faceIndex)
+            {
+                uint32_t& tile = m_tiles[static_cast<size_t>(type)][faceIndex];
+                if (tile == UNRESOLVED)
+                {
+                    tile = static_cast<uint32_t>(BlockTextureRegistry::GetTextureLayer(type, static_cast<BlockFace>(faceIndex)));
+                }
+                return tile;
+            }
+
+        private:
+            static constexpr uint32_t UNRESOLVED = 0xFFFFFFFFu;
+            uint32_t m_tiles[static_cast<size_t>(BlockType::Count)][6];
+        };
+    }
+
     glm::vec3 ChunkMeshGenerator::GetBlockColor(BlockType type)
     {
         switch (type)
@@ -41,300 +217,673 @@ namespace MinecraftClone
         }
     }
 
-    bool ChunkMeshGenerator::ShouldRenderFace(Chunk* chunk, int x, int y, int z, int faceIndex, World* world, int chunkX, int chunkZ, Chunk* neighborChunks[4])
+    void ChunkMeshGenerator::BuildFaceMasks(const ChunkMeshInput& input, int yBegin, int yEnd, FaceMasks& masks)
+    {
+        if (IsBitmaskCulling())
+        {
+            BuildFaceMasksBitwise(input, yBegin, yEnd, masks);
+        }
+        else
+        {
+            BuildFaceMasksReference(input, yBegin, yEnd, masks);
+        }
+    }
+
+    void ChunkMeshGenerator::BuildFaceMasksReference(const ChunkMeshInput& input, int yBegin, int yEnd, FaceMasks& masks)
     {
-        // Face directions: 0=front(+Z), 1=back(-Z), 2=left(-X), 3=right(+X), 4=top(+Y), 5=bottom(-Y)
-        int neighborX = x;
-        int neighborY = y;
-        int neighborZ = z;
-        int neighborChunkX = chunkX;
-        int neighborChunkZ = chunkZ;
-
-        switch (faceIndex)
-        {
-            case 0: // Front (+Z)
-                neighborZ++;
-                if (neighborZ >= CHUNK_SIZE_Z)
+        // One padded-volume lookup per block face
+        const OccluderTable occluder;
+
+        for (int y = yBegin; y < yEnd; y++)
+        {
+            for (int face = 0; face < 6; face++)
+            {
+                std::memset(masks.rows[face][y], 0, sizeof(masks.rows[face][y]));
+            }
+        }
+
+        for (int y = yBegin; y < yEnd; y++)
+        {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
                 {
-                    neighborZ = 0;
-                    neighborChunkZ++;
+                    const BlockType block = input.Get(x, y, z);
+                    if (block == BlockType::Air)
+                    {
+                        continue;
+                    }
+
+                    for (int face = 0; face < 6; face++)
+                    {
+                        const int* offset = FACE_OFFSETS[face];
+                        if (IsFaceVisible(occluder, block, input.Get(x + offset[0], y + offset[1], z + offset[2])))
+                        {
+                            masks.rows[face][y][z] |= static_cast<uint16_t>(1u << x);
+                        }
+                    }
                 }
-                break;
-            case 1: // Back (-Z)
-                neighborZ--;
-                if (neighborZ < 0)
+            }
+        }
+    }
+
+    void ChunkMeshGenerator::BuildFaceMasksBitwise(const ChunkMeshInput& input, int yBegin, int yEnd, FaceMasks& masks)
+    {
+        // OPTIMIZATION 21: Bitmask face culling
+        // Build one 16-bit "not air" row and one 18-bit occluder row (not air, not transparent) per
+        // (y, z) of the padded input, then a face is visible where the block is set and the
+        // neighbour occluder bit is clear: whole rows are culled with a shift, an AND and a NOT
+        // instead of 16 x 6 neighbour lookups. The padding makes every row branch-free. Rows holding
+        // transparent blocks then drop faces shared by two blocks of the same type with a scalar pass.
+        const OccluderTable occluder;
+        const BlockType* types = input.GetData();
+
+        static constexpr int SIZE_X = ChunkMeshInput::SIZE_X;
+        static constexpr int SIZE_Z = ChunkMeshInput::SIZE_Z;
+
+        // Occluder rows for padded layers [yBegin - 1, yEnd]: bit x + 1 = block x
+        uint32_t occluderRows[ChunkMeshInput::SIZE_Y][SIZE_Z];
+        uint16_t solidRows[CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+        uint16_t transparentRows[CHUNK_SIZE_Y][CHUNK_SIZE_Z];  // Not air and not an occluder
+
+#ifdef CHUNK_MESH_SSE2
+        // Interior 16 bytes of a row at once: compare against air and each transparent type
+        __m128i transparentTypes[static_cast<size_t>(BlockType::Count)];
+        int transparentTypeCount = 0;
+        for (size_t type = 1; type < static_cast<size_t>(BlockType::Count); type++)
+        {
+            if (!occluder(static_cast<BlockType>(type)))
+            {
+                transparentTypes[transparentTypeCount++] = _mm_set1_epi8(static_cast<char>(type));
+            }
+        }
+        const __m128i zero = _mm_setzero_si128();
+#endif
+
+        for (int y = yBegin - 1; y <= yEnd && y < CHUNK_SIZE_Y + 1; y++)
+        {
+            for (int z = -1; z <= CHUNK_SIZE_Z; z++)
+            {
+                const BlockType* row = types + ChunkMeshInput::Index(-1, y, z);
+
+#ifdef CHUNK_MESH_SSE2
+                __m128i interior = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 1));
+                __m128i air = _mm_cmpeq_epi8(interior, zero);
+                __m128i clear = air;
+                for (int t = 0; t < transparentTypeCount; t++)
                 {
-                    neighborZ = CHUNK_SIZE_Z - 1;
-                    neighborChunkZ--;
+                    clear = _mm_or_si128(clear, _mm_cmpeq_epi8(interior, transparentTypes[t]));
                 }
-                break;
-            case 2: // Left (-X)
-                neighborX--;
-                if (neighborX < 0)
+                uint32_t solidBits = ~static_cast<uint32_t>(_mm_movemask_epi8(air)) & 0xFFFFu;
+                uint32_t occluderBits = (~static_cast<uint32_t>(_mm_movemask_epi8(clear)) & 0xFFFFu) << 1;
+#else
+                uint32_t solidBits = 0;
+                uint32_t occluderBits = 0;
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
                 {
-                    neighborX = CHUNK_SIZE_X - 1;
-                    neighborChunkX--;
+                    solidBits |= static_cast<uint32_t>(row[x + 1] != BlockType::Air) << x;
+                    occluderBits |= static_cast<uint32_t>(occluder(row[x + 1])) << (x + 1);
                 }
-                break;
-            case 3: // Right (+X)
-                neighborX++;
-                if (neighborX >= CHUNK_SIZE_X)
+#endif
+                occluderBits |= static_cast<uint32_t>(occluder(row[0]));
+                occluderBits |= static_cast<uint32_t>(occluder(row[SIZE_X - 1])) << (SIZE_X - 1);
+                occluderRows[y + 1][z + 1] = occluderBits;
+
+                if (y >= yBegin && y < yEnd && z >= 0 && z < CHUNK_SIZE_Z)
                 {
-                    neighborX = 0;
-                    neighborChunkX++;
+                    solidRows[y][z] = static_cast<uint16_t>(solidBits);
+                    transparentRows[y][z] = static_cast<uint16_t>(solidBits & ~(occluderBits >> 1));
                 }
-                break;
-            case 4: // Top (+Y)
-                neighborY++;
-                if (neighborY >= CHUNK_SIZE_Y)
+            }
+        }
+
+        for (int y = yBegin; y < yEnd; y++)
+        {
+            const uint32_t* layer = occluderRows[y + 1];
+            const uint32_t* above = occluderRows[y + 2];
+            const uint32_t* below = occluderRows[y];
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                uint32_t bits = solidRows[y][z];
+                uint32_t row = layer[z + 1];
+
+                masks.rows[0][y][z] = static_cast<uint16_t>(bits & ~(layer[z + 2] >> 1));   // Front (+Z)
+                masks.rows[1][y][z] = static_cast<uint16_t>(bits & ~(layer[z] >> 1));       // Back (-Z)
+                masks.rows[2][y][z] = static_cast<uint16_t>(bits & ~row);                   // Left (-X)
+                masks.rows[3][y][z] = static_cast<uint16_t>(bits & ~(row >> 2));            // Right (+X)
+                masks.rows[4][y][z] = static_cast<uint16_t>(bits & ~(above[z + 1] >> 1));   // Top (+Y)
+                masks.rows[5][y][z] = static_cast<uint16_t>(bits & ~(below[z + 1] >> 1));   // Bottom (-Y)
+
+                const uint32_t transparent = transparentRows[y][z];
+                if (transparent == 0)
                 {
-                    return true; // Always render top face if at world height limit
+                    continue;
                 }
-                break;
-            case 5: // Bottom (-Y)
-                neighborY--;
-                if (neighborY < 0)
+
+                const int rowIndex = ChunkMeshInput::Index(0, y, z);
+#ifdef CHUNK_MESH_SSE2
+                // The row against its 16 neighbours in each direction at once
+                const __m128i blocks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + rowIndex));
+                for (int face = 0; face < 6; face++)
                 {
-                    return true; // Always render bottom face if at world bottom
+                    const __m128i neighbors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + rowIndex + FACE_AXES[face].normal));
+                    const uint32_t same = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(blocks, neighbors)));
+                    masks.rows[face][y][z] = static_cast<uint16_t>(masks.rows[face][y][z] & ~(same & transparent));
                 }
-                break;
+#else
+                for (int face = 0; face < 6; face++)
+                {
+                    const int neighborOffset = FACE_AXES[face].normal;
+                    for (uint32_t rest = masks.rows[face][y][z] & transparent; rest != 0; rest &= rest - 1)
+                    {
+                        const int x = CountTrailingZeros(rest);
+                        if (types[rowIndex + x + neighborOffset] == types[rowIndex + x])
+                        {
+                            masks.rows[face][y][z] = static_cast<uint16_t>(masks.rows[face][y][z] & ~(1u << x));
+                        }
+                    }
+                }
+#endif
+            }
+        }
+    }
+
+    void ChunkMeshGenerator::AddFace(ChunkMesh* mesh, const glm::ivec3& localPosition, BlockType blockType, int faceIndex)
+    {
+        // Texture layer for this block type and face; the shader samples it at the face's 0..1 UVs
+        BlockFace face = static_cast<BlockFace>(faceIndex);
+        uint32_t tile = static_cast<uint32_t>(BlockTextureRegistry::GetTextureLayer(blockType, face));
+
+        mesh->AddFace(localPosition.x, localPosition.y, localPosition.z, faceIndex, tile, ChunkMesh::AO_OPEN,
+                      BlockRegistry::GetRenderLayer(blockType));
+    }
+
+    std::unique_ptr<ChunkMesh> ChunkMeshGenerator::GenerateMesh(Chunk* chunk, int chunkX, int chunkZ, World* world)
+    {
+        return GenerateMesh(chunk, chunkX, chunkZ, world, GetMeshingMode());
+    }
+
+    std::unique_ptr<ChunkMesh> ChunkMeshGenerator::GenerateMesh(Chunk* chunk, int chunkX, int chunkZ, World* world, MeshingMode mode)
+    {
+        if (!chunk || !world || chunk->IsEmpty())
+        {
+            return std::make_unique<ChunkMesh>();
         }
 
-        // Check if neighbor is in different chunk
-        if (neighborChunkX != chunkX || neighborChunkZ != chunkZ)
+        // OPTIMIZATION 4: Gather the chunk and its neighbours once into a padded volume
+        // so meshing never crosses a chunk boundary
+        const Chunk* neighbors[3][3];
+        for (int dz = -1; dz <= 1; dz++)
         {
-            // Determine which neighbor chunk array index to use
-            int neighborIdx = -1;
-            if (neighborChunkZ == chunkZ + 1) neighborIdx = 0;  // Front
-            else if (neighborChunkZ == chunkZ - 1) neighborIdx = 1;  // Back
-            else if (neighborChunkX == chunkX - 1) neighborIdx = 2;  // Left
-            else if (neighborChunkX == chunkX + 1) neighborIdx = 3;  // Right
-            
-            if (neighborIdx >= 0 && neighborIdx < 4 && neighborChunks[neighborIdx])
+            for (int dx = -1; dx <= 1; dx++)
             {
-                // Use cached neighbor chunk
-                const Block& neighborBlock = neighborChunks[neighborIdx]->GetBlock(neighborX, neighborY, neighborZ);
-                return neighborBlock.IsAir() || neighborBlock.IsTransparent();
+                neighbors[dz + 1][dx + 1] = (dx == 0 && dz == 0) ? nullptr : world->GetChunk(chunkX + dx, chunkZ + dz);
             }
-            else
+        }
+
+        std::unique_ptr<MeshScratch> ownedScratch;
+        MeshScratch& scratch = AcquireScratch(ownedScratch);
+        scratch.input.Assemble(*chunk, neighbors, IsLodEnabled());
+        return GenerateMesh(scratch.input, chunkX, chunkZ, mode);
+    }
+
+    std::unique_ptr<ChunkMesh> ChunkMeshGenerator::GenerateLodMesh(Chunk* chunk, int chunkX, int chunkZ, World* world, int level)
+    {
+        // OPTIMIZATION 13: Downsampled LOD meshes
+        // Far away a block covers less than a pixel, so distant chunks are drawn from a copy
+        // downsampled to 2x2x2 or 4x4x4-block cells (majority vote per cell). The cells are written
+        // back at block resolution and meshed greedily like any chunk: a cell's faces merge into
+        // scale-aligned quads, roughly a quarter (2x) or a sixteenth (4x) of the full mesh.
+        if (!chunk || !world || chunk->IsEmpty() || level < 0 || level >= ChunkMeshInput::LOD_LEVEL_COUNT)
+        {
+            return nullptr;
+        }
+
+        const Chunk* neighbors[3][3];
+        for (int dz = -1; dz <= 1; dz++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
             {
-                // Neighbor chunk not available, conservatively render the face
-                return true;
+                neighbors[dz + 1][dx + 1] = (dx == 0 && dz == 0) ? nullptr : world->GetChunk(chunkX + dx, chunkZ + dz);
             }
         }
-        else
+
+        std::unique_ptr<MeshScratch> ownedScratch;
+        MeshScratch& scratch = AcquireScratch(ownedScratch);
+        scratch.input.AssembleDownsampled(*chunk, neighbors, ChunkMeshInput::GetLodScale(level));
+        const int topY = scratch.input.GetTopY();
+        if (topY == 0)
         {
-            // Neighbor is in same chunk
-            const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-            return neighborBlock.IsAir() || neighborBlock.IsTransparent();
+            return nullptr;
         }
+
+        BuildFaceMasks(scratch.input, 0, topY, scratch.masks);
+        // No ambient occlusion: invisible at this distance, and it would split the merged quads
+        return MeshLayers(scratch, scratch.input, chunkX, chunkZ, 0, topY, MeshingMode::Greedy, false);
     }
 
-    void ChunkMeshGenerator::AddFace(ChunkMesh* mesh, const glm::vec3& position, BlockType blockType, int faceIndex)
+    void ChunkMeshGenerator::GenerateLodMeshes(Chunk* chunk, int chunkX, int chunkZ, World* world, ChunkSectionMeshes& meshes)
     {
-        // Get UV coordinates from texture atlas based on block type and face
-        BlockFace face = static_cast<BlockFace>(faceIndex);
-        AtlasUV atlasUV = BlockTextureRegistry::GetAtlasUV(blockType, face);
-        
-        // Map atlas UV to face corners
-        glm::vec2 uv0(atlasUV.min.x, atlasUV.min.y);
-        glm::vec2 uv1(atlasUV.max.x, atlasUV.min.y);
-        glm::vec2 uv2(atlasUV.max.x, atlasUV.max.y);
-        glm::vec2 uv3(atlasUV.min.x, atlasUV.max.y);
-
-        glm::vec3 normals[] = {
-            glm::vec3(0.0f, 0.0f, 1.0f),   // Front
-            glm::vec3(0.0f, 0.0f, -1.0f),  // Back
-            glm::vec3(-1.0f, 0.0f, 0.0f),  // Left
-            glm::vec3(1.0f, 0.0f, 0.0f),   // Right
-            glm::vec3(0.0f, 1.0f, 0.0f),   // Top
-            glm::vec3(0.0f, -1.0f, 0.0f)   // Bottom
-        };
+        for (int level = 0; level < ChunkMeshInput::LOD_LEVEL_COUNT; level++)
+        {
+            meshes.lods[level] = GenerateLodMesh(chunk, chunkX, chunkZ, world, level);
+        }
+        meshes.hasLods = true;
+    }
+
+    std::unique_ptr<ChunkMesh> ChunkMeshGenerator::GenerateMesh(const ChunkMeshInput& input, int chunkX, int chunkZ, MeshingMode mode)
+    {
+        if (input.GetTopY() == 0)
+        {
+            return std::make_unique<ChunkMesh>();
+        }
 
-        mesh->AddFace(position, uv0, uv1, uv2, uv3, normals[faceIndex], faceIndex);
+        // Visible faces for the whole chunk first; both meshing modes only walk the set bits
+        std::unique_ptr<MeshScratch> ownedScratch;
+        MeshScratch& scratch = AcquireScratch(ownedScratch);
+        BuildFaceMasks(input, 0, input.GetTopY(), scratch.masks);
+        auto mesh = MeshLayers(scratch, input, chunkX, chunkZ, 0, input.GetTopY(), mode, IsAmbientOcclusion());
+        return mesh ? std::move(mesh) : std::make_unique<ChunkMesh>();
     }
 
-    std::unique_ptr<ChunkMesh> ChunkMeshGenerator::GenerateMesh(Chunk* chunk, int chunkX, int chunkZ, World* world)
+    size_t ChunkMeshGenerator::CullFaces(const ChunkMeshInput& input)
+    {
+        std::unique_ptr<MeshScratch> ownedScratch;
+        MeshScratch& scratch = AcquireScratch(ownedScratch);
+        const int topY = input.GetTopY();
+        BuildFaceMasks(input, 0, topY, scratch.masks);
+
+        size_t faceCount = 0;
+        for (int face = 0; face < 6; face++)
+        {
+            faceCount += CountBits(scratch.masks.rows[face][0], static_cast<size_t>(topY) * CHUNK_SIZE_Z);
+        }
+        return faceCount;
+    }
+
+    ChunkMeshGenerator::MeshScratch& ChunkMeshGenerator::AcquireScratch(std::unique_ptr<MeshScratch>& owned)
+    {
+        // OPTIMIZATION 9: Per-thread scratch arenas
+        // The padded input, face masks, greedy slices and the staging mesh live in one block per
+        // thread that is allocated on first use and reused by every later job on that thread. The
+        // staging mesh grows to the largest section seen and stays there; each result is copied
+        // out once, exactly sized, instead of growing its own vectors face by face.
+        if (!IsScratchReuse())
+        {
+            owned = std::make_unique<MeshScratch>();
+            return *owned;
+        }
+
+        thread_local std::unique_ptr<MeshScratch> threadScratch;
+        if (!threadScratch)
+        {
+            threadScratch = std::make_unique<MeshScratch>();
+        }
+        return *threadScratch;
+    }
+
+    std::unique_ptr<ChunkMesh> ChunkMeshGenerator::MeshLayers(MeshScratch& scratch, const ChunkMeshInput& input, int chunkX, int chunkZ,
+                                                              int yBegin, int yEnd, MeshingMode mode, bool ambientOcclusion)
     {
+        if (!IsScratchReuse())
+        {
+            auto mesh = std::make_unique<ChunkMesh>();
+            GenerateFaces(mesh.get(), input, chunkX, chunkZ, scratch.masks, yBegin, yEnd, mode, ambientOcclusion, scratch);
+            return mesh->IsEmpty() ? nullptr : std::move(mesh);
+        }
+
+        scratch.mesh.Clear();
+        GenerateFaces(&scratch.mesh, input, chunkX, chunkZ, scratch.masks, yBegin, yEnd, mode, ambientOcclusion, scratch);
+        if (scratch.mesh.IsEmpty())
+        {
+            return nullptr;
+        }
+
         auto mesh = std::make_unique<ChunkMesh>();
+        mesh->CopyGeometry(scratch.mesh);
+        return mesh;
+    }
 
+    ChunkSectionMeshes ChunkMeshGenerator::GenerateSectionMeshes(Chunk* chunk, int chunkX, int chunkZ, World* world,
+                                                                 uint32_t sectionMask, MeshingMode mode)
+    {
+        ChunkSectionMeshes result;
+        result.sectionMask = sectionMask & ALL_SECTIONS;
         if (!chunk || !world || chunk->IsEmpty())
         {
-            return mesh;
+            return result;
         }
 
-        // OPTIMIZATION 4: Cache neighbor block states to reduce redundant world lookups
-        // Pre-compute neighbor chunks for boundary checks
-        Chunk* neighborChunks[4] = { nullptr, nullptr, nullptr, nullptr }; // Front, Back, Left, Right
-        neighborChunks[0] = world->GetChunk(chunkX, chunkZ + 1);     // Front (+Z)
-        neighborChunks[1] = world->GetChunk(chunkX, chunkZ - 1);     // Back (-Z)
-        neighborChunks[2] = world->GetChunk(chunkX - 1, chunkZ);     // Left (-X)
-        neighborChunks[3] = world->GetChunk(chunkX + 1, chunkZ);     // Right (+X)
+        std::unique_ptr<MeshScratch> ownedScratch;
+        MeshScratch& scratch = AcquireScratch(ownedScratch);
+        if (!scratch.input.Assemble(world, chunkX, chunkZ, IsLodEnabled()))
+        {
+            return result;
+        }
+        return GenerateSectionMeshes(scratch.input, chunkX, chunkZ, sectionMask, mode);
+    }
 
-        for (int y = 0; y < CHUNK_SIZE_Y; y++)
+    ChunkSectionMeshes ChunkMeshGenerator::GenerateSectionMeshes(const ChunkMeshInput& input, int chunkX, int chunkZ,
+                                                                 uint32_t sectionMask, MeshingMode mode)
+    {
+        // OPTIMIZATION 7: Section-granular meshes
+        // Each 16-block section gets its own mesh, so an edit rebuilds and re-uploads one section
+        // (plus the sections across a face it touches) instead of the whole 16x256x16 column.
+        // Masks are built once for the span of requested sections below the top layer; sections
+        // above it are reported empty. Greedy quads never cross a section boundary.
+        ChunkSectionMeshes result;
+        result.sectionMask = sectionMask & ALL_SECTIONS;
+
+        const int topY = input.GetTopY();
+        const int topSection = (topY + CHUNK_SECTION_SIZE - 1) / CHUNK_SECTION_SIZE;
+        const uint32_t meshedSections = result.sectionMask & ((1u << topSection) - 1u);
+        if (meshedSections == 0)
         {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            return result;
+        }
+
+        int firstSection = CountTrailingZeros(meshedSections);
+        int lastSection = firstSection;
+        for (uint32_t rest = meshedSections; rest != 0; rest &= rest - 1)
+        {
+            lastSection = CountTrailingZeros(rest);
+        }
+
+        std::unique_ptr<MeshScratch> ownedScratch;
+        MeshScratch& scratch = AcquireScratch(ownedScratch);
+        BuildFaceMasks(input, firstSection * CHUNK_SECTION_SIZE,
+                       std::min(topY, (lastSection + 1) * CHUNK_SECTION_SIZE), scratch.masks);
+
+        const bool ambientOcclusion = IsAmbientOcclusion();
+        for (uint32_t rest = meshedSections; rest != 0; rest &= rest - 1)
+        {
+            int section = CountTrailingZeros(rest);
+            int yBegin = section * CHUNK_SECTION_SIZE;
+            int yEnd = std::min(topY, yBegin + CHUNK_SECTION_SIZE);
+            result.sections[section] = MeshLayers(scratch, input, chunkX, chunkZ, yBegin, yEnd, mode, ambientOcclusion);
+            result.visibility[section] = SectionVisibility::Compute(input, section);
+        }
+
+        return result;
+    }
+
+    int ChunkMeshGenerator::GetSectionsAffectedByBlock(int worldX, int worldY, int worldZ, SectionRemesh out[MAX_AFFECTED_CHUNKS])
+    {
+        if (worldY < 0 || worldY >= CHUNK_SIZE_Y)
+        {
+            return 0;
+        }
+
+        auto chunkCoords = World::GetChunkCoords(worldX, worldZ);
+        glm::ivec3 local = World::GetLocalCoords(worldX, worldY, worldZ);
+        const int section = worldY / CHUNK_SECTION_SIZE;
+        const int layer = worldY % CHUNK_SECTION_SIZE;
+
+        // Faces of the blocks within one block of the change (culling uses the six face neighbours,
+        // ambient occlusion also the edge and corner neighbours)
+        uint32_t sections = 1u << section;
+        if (layer == 0 && section > 0)
+        {
+            sections |= 1u << (section - 1);
+        }
+        if (layer == CHUNK_SECTION_SIZE - 1 && section < CHUNK_SECTION_COUNT - 1)
+        {
+            sections |= 1u << (section + 1);
+        }
+
+        const int dx = (local.x == 0) ? -1 : (local.x == CHUNK_SIZE_X - 1 ? 1 : 0);
+        const int dz = (local.z == 0) ? -1 : (local.z == CHUNK_SIZE_Z - 1 ? 1 : 0);
+
+        int count = 0;
+        out[count++] = { chunkCoords.first, chunkCoords.second, sections };
+        if (dx != 0)             out[count++] = { chunkCoords.first + dx, chunkCoords.second, sections };
+        if (dz != 0)             out[count++] = { chunkCoords.first, chunkCoords.second + dz, sections };
+        if (dx != 0 && dz != 0)  out[count++] = { chunkCoords.first + dx, chunkCoords.second + dz, sections };
+        return count;
+    }
+
+    uint32_t ChunkMeshGenerator::GetBorderSections(const Chunk& chunk, int dx, int dz)
+    {
+        // The border columns: one row of x or z for a side, a single column for a corner
+        const int xBegin = (dx < 0) ? 0 : (dx > 0 ? CHUNK_SIZE_X - 1 : 0);
+        const int xEnd = (dx < 0) ? 1 : CHUNK_SIZE_X;
+        const int zBegin = (dz < 0) ? 0 : (dz > 0 ? CHUNK_SIZE_Z - 1 : 0);
+        const int zEnd = (dz < 0) ? 1 : CHUNK_SIZE_Z;
+
+        const Block* blocks = chunk.GetBlockData();
+        uint32_t sections = 0;
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+        {
+            bool occupied = false;
+            for (int y = section * CHUNK_SECTION_SIZE; y < (section + 1) * CHUNK_SECTION_SIZE && !occupied; y++)
             {
-                for (int x = 0; x < CHUNK_SIZE_X; x++)
+                for (int z = zBegin; z < zEnd && !occupied; z++)
                 {
-                    const Block& block = chunk->GetBlock(x, y, z);
+                    for (int x = xBegin; x < xEnd; x++)
+                    {
+                        if (!blocks[y * CHUNK_SIZE_X * CHUNK_SIZE_Z + z * CHUNK_SIZE_X + x].IsAir())
+                        {
+                            occupied = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            sections |= occupied ? 1u << section : 0u;
+        }
+        return sections;
+    }
+
+    void ChunkMeshGenerator::GenerateFaces(ChunkMesh* mesh, const ChunkMeshInput& input, int chunkX, int chunkZ,
+                                           const FaceMasks& masks, int yBegin, int yEnd, MeshingMode mode, bool ambientOcclusion,
+                                           MeshScratch& scratch)
+    {
+        // Faces are stored relative to the chunk's corner; the shader adds it back per draw
+        mesh->SetOrigin(glm::ivec3(chunkX * CHUNK_SIZE_X, 0, chunkZ * CHUNK_SIZE_Z));
+
+        if (mode == MeshingMode::Greedy)
+        {
+            GenerateGreedyFaces(mesh, input, masks, yBegin, yEnd, ambientOcclusion, scratch);
+        }
+        else
+        {
+            GenerateNaiveFaces(mesh, input, masks, yBegin, yEnd, ambientOcclusion);
+        }
+    }
 
-                    if (block.IsAir())
+    void ChunkMeshGenerator::GenerateNaiveFaces(ChunkMesh* mesh, const ChunkMeshInput& input, const FaceMasks& masks,
+                                                int yBegin, int yEnd, bool ambientOcclusion)
+    {
+        const BlockType* types = input.GetData();
+        const OccluderTable occluder;
+        const RenderLayerTable renderLayers;
+        TileCache tiles;
+
+        // One quad per set bit; reserve up front
+        size_t faceCount = 0;
+        for (int face = 0; face < 6; face++)
+        {
+            faceCount += CountBits(masks.rows[face][yBegin], static_cast<size_t>(yEnd - yBegin) * CHUNK_SIZE_Z);
+        }
+        mesh->Reserve(faceCount);
+
+        // Direction by direction, so each direction's faces end up contiguous in the mesh
+        for (int face = 0; face < 6; face++)
+        {
+            for (int y = yBegin; y < yEnd; y++)
+            {
+                for (int z = 0; z < CHUNK_SIZE_Z; z++)
+                {
+                    // Iterate only the visible faces of this row
+                    uint32_t bits = masks.rows[face][y][z];
+                    while (bits != 0)
+                    {
+                        int x = CountTrailingZeros(bits);
+                        bits &= bits - 1;
+
+                        const int blockIndex = ChunkMeshInput::Index(x, y, z);
+                        uint8_t ao = ambientOcclusion ? ComputeFaceAO(types, occluder, blockIndex, face) : ChunkMesh::AO_OPEN;
+                        const BlockType type = types[blockIndex];
+                        mesh->AddFace(x, y, z, face, tiles.Get(type, face), ao, renderLayers(type));
+                    }
+                }
+            }
+        }
+    }
+
+    void ChunkMeshGenerator::GenerateGreedyFaces(ChunkMesh* mesh, const ChunkMeshInput& input, const FaceMasks& masks,
+                                                 int yBegin, int yEnd, bool ambientOcclusion, MeshScratch& scratch)
+    {
+        // OPTIMIZATION 5: Greedy meshing
+        // For each face direction, sweep slices perpendicular to the face normal and merge visible
+        // faces of the same block type into maximal rectangles (grow along u first, then extend
+        // along v while the whole span matches). Each slice row is a 16-bit occupancy mask, so empty
+        // cells are skipped with a bit scan; block types are only read where a bit is set.
+        // Texture coordinates are in block units so each merged quad repeats its atlas tile.
+        // With ambient occlusion the merge key is (block type, corner AO), and only faces whose
+        // four corners share one AO level merge, so a merged quad shades exactly like its faces.
+        const BlockType* types = input.GetData();
+        const int height = yEnd - yBegin;
+
+        if (height <= 0)
+        {
+            return;
+        }
+
+        // u always spans 16 cells (x or z); v is y - yBegin (side faces) or z (top / bottom)
+        static constexpr int U_SIZE = 16;
+        static_assert(CHUNK_SIZE_X == U_SIZE && CHUNK_SIZE_Z == U_SIZE, "Greedy rows assume 16-wide chunks");
+
+        std::vector<uint16_t>& occupancy = scratch.occupancy;   // [slice][v], bit u
+        std::vector<uint16_t>& keys = scratch.keys;             // [slice][v][u] block type | corner AO << 8, valid where the bit is set
+        const OccluderTable occluder;
+        const RenderLayerTable renderLayers;
+        TileCache tiles;
+
+        // Merge key of a visible face: its block type and packed corner AO
+        auto faceKey = [&](int blockIndex, int face) {
+            uint8_t ao = ambientOcclusion ? ComputeFaceAO(types, occluder, blockIndex, face) : ChunkMesh::AO_OPEN;
+            return static_cast<uint16_t>(static_cast<uint8_t>(types[blockIndex]) | ao << 8);
+        };
+
+        for (int face = 0; face < 6; face++)
+        {
+            // Slice axis and the (u, v) axes of the mask; matches AddQuad's width/height axes
+            // Z faces: u = x, v = y   X faces: u = z, v = y   Y faces: u = x, v = z
+            const bool yFace = face >= 4;
+            const int sliceCount = yFace ? height : U_SIZE;
+            const int vSize = yFace ? CHUNK_SIZE_Z : height;
+
+            occupancy.assign(static_cast<size_t>(sliceCount) * vSize, 0);
+            keys.resize(static_cast<size_t>(sliceCount) * vSize * U_SIZE);
+
+            // Scatter the visible face bits into the slices (layer = y - yBegin)
+            for (int layer = 0; layer < height; layer++)
+            {
+                const int y = yBegin + layer;
+                for (int z = 0; z < CHUNK_SIZE_Z; z++)
+                {
+                    uint32_t bits = masks.rows[face][y][z];
+                    if (bits == 0)
                     {
                         continue;
                     }
 
-                    // OPTIMIZATION: Skip fully enclosed blocks (underground optimization)
-                    // Check if all 6 neighbors are solid blocks - if so, skip this block entirely
-                    bool fullyEnclosed = true;
-                    for (int face = 0; face < 6; face++)
+                    const int rowIndex = ChunkMeshInput::Index(0, y, z);
+                    if (face <= 1)
                     {
-                        if (ShouldRenderFace(chunk, x, y, z, face, world, chunkX, chunkZ, neighborChunks))
+                        // slice = z, v = y, u = x: the row is already in u order
+                        size_t cell = static_cast<size_t>(z) * vSize + layer;
+                        occupancy[cell] = static_cast<uint16_t>(bits);
+                        for (uint32_t rest = bits; rest != 0; rest &= rest - 1)
                         {
-                            fullyEnclosed = false;
-                            break;
+                            int x = CountTrailingZeros(rest);
+                            keys[cell * U_SIZE + x] = faceKey(rowIndex + x, face);
                         }
                     }
-                    
-                    if (fullyEnclosed)
+                    else if (face <= 3)
                     {
-                        continue; // Skip this block - it's completely surrounded
+                        // slice = x, v = y, u = z: transpose
+                        for (uint32_t rest = bits; rest != 0; rest &= rest - 1)
+                        {
+                            int x = CountTrailingZeros(rest);
+                            size_t cell = static_cast<size_t>(x) * vSize + layer;
+                            occupancy[cell] |= static_cast<uint16_t>(1u << z);
+                            keys[cell * U_SIZE + z] = faceKey(rowIndex + x, face);
+                        }
                     }
+                    else
+                    {
+                        // slice = y, v = z, u = x
+                        size_t cell = static_cast<size_t>(layer) * vSize + z;
+                        occupancy[cell] = static_cast<uint16_t>(bits);
+                        for (uint32_t rest = bits; rest != 0; rest &= rest - 1)
+                        {
+                            int x = CountTrailingZeros(rest);
+                            keys[cell * U_SIZE + x] = faceKey(rowIndex + x, face);
+                        }
+                    }
+                }
+            }
 
-                    glm::vec3 blockPos = glm::vec3(
-                        static_cast<float>(chunkX * CHUNK_SIZE_X + x),
-                        static_cast<float>(y),
-                        static_cast<float>(chunkZ * CHUNK_SIZE_Z + z)
-                    );
+            for (int slice = 0; slice < sliceCount; slice++)
+            {
+                uint16_t* sliceRows = occupancy.data() + static_cast<size_t>(slice) * vSize;
+                const uint16_t* sliceKeys = keys.data() + static_cast<size_t>(slice) * vSize * U_SIZE;
 
-                    // Generate visible faces
-                    for (int face = 0; face < 6; face++)
+                for (int v = 0; v < vSize; v++)
+                {
+                    while (sliceRows[v] != 0)
                     {
-                        bool shouldRender = false;
-                        int neighborX = x;
-                        int neighborY = y;
-                        int neighborZ = z;
+                        int u = CountTrailingZeros(sliceRows[v]);
+                        const uint16_t* rowKeys = sliceKeys + v * U_SIZE;
+                        const uint16_t key = rowKeys[u];
+                        const uint8_t ao = static_cast<uint8_t>(key >> 8);
+                        const bool mergeable = IsUniformAO(ao);
 
-                        switch (face)
+                        int width = 1;
+                        while (mergeable && u + width < U_SIZE && (sliceRows[v] >> (u + width) & 1u) && rowKeys[u + width] == key)
                         {
-                            case 0: // Front (+Z)
-                                neighborZ++;
-                                if (neighborZ >= CHUNK_SIZE_Z)
-                                {
-                                    // Check neighbor chunk - assume air if not available (conservative)
-                                    if (neighborChunks[0])
-                                    {
-                                        const Block& neighborBlock = neighborChunks[0]->GetBlock(x, y, 0);
-                                        shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                    }
-                                    else
-                                    {
-                                        // No neighbor chunk loaded, assume air (conservative for rendering)
-                                        shouldRender = true;
-                                    }
-                                }
-                                else
-                                {
-                                    const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-                                    shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                }
-                                break;
-                            case 1: // Back (-Z)
-                                neighborZ--;
-                                if (neighborZ < 0)
-                                {
-                                    if (neighborChunks[1])
-                                    {
-                                        const Block& neighborBlock = neighborChunks[1]->GetBlock(x, y, CHUNK_SIZE_Z - 1);
-                                        shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                    }
-                                    else
-                                    {
-                                        shouldRender = true;
-                                    }
-                                }
-                                else
-                                {
-                                    const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-                                    shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                }
-                                break;
-                            case 2: // Left (-X)
-                                neighborX--;
-                                if (neighborX < 0)
-                                {
-                                    if (neighborChunks[2])
-                                    {
-                                        const Block& neighborBlock = neighborChunks[2]->GetBlock(CHUNK_SIZE_X - 1, y, z);
-                                        shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                    }
-                                    else
-                                    {
-                                        shouldRender = true;
-                                    }
-                                }
-                                else
-                                {
-                                    const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-                                    shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                }
-                                break;
-                            case 3: // Right (+X)
-                                neighborX++;
-                                if (neighborX >= CHUNK_SIZE_X)
-                                {
-                                    if (neighborChunks[3])
-                                    {
-                                        const Block& neighborBlock = neighborChunks[3]->GetBlock(0, y, z);
-                                        shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                    }
-                                    else
-                                    {
-                                        shouldRender = true;
-                                    }
-                                }
-                                else
-                                {
-                                    const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-                                    shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                }
-                                break;
-                            case 4: // Top (+Y)
-                                neighborY++;
-                                if (neighborY >= CHUNK_SIZE_Y)
-                                {
-                                    shouldRender = true; // Always render top face at world height limit
-                                }
-                                else
-                                {
-                                    const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-                                    shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
-                                }
-                                break;
-                            case 5: // Bottom (-Y)
-                                neighborY--;
-                                if (neighborY < 0)
-                                {
-                                    shouldRender = true; // Always render bottom face at world bottom
-                                }
-                                else
+                            width++;
+                        }
+                        const uint32_t span = ((1u << width) - 1u) << u;
+
+                        int quadHeight = 1;
+                        while (mergeable && v + quadHeight < vSize && (sliceRows[v + quadHeight] & span) == span)
+                        {
+                            const uint16_t* nextKeys = sliceKeys + (v + quadHeight) * U_SIZE;
+                            bool sameType = true;
+                            for (int k = 0; k < width; k++)
+                            {
+                                if (nextKeys[u + k] != key)
                                 {
-                                    const Block& neighborBlock = chunk->GetBlock(neighborX, neighborY, neighborZ);
-                                    shouldRender = neighborBlock.IsAir() || neighborBlock.IsTransparent();
+                                    sameType = false;
+                                    break;
                                 }
+                            }
+                            if (!sameType)
+                            {
                                 break;
+                            }
+                            quadHeight++;
                         }
 
-                        if (shouldRender)
+                        // Clear the merged cells
+                        for (int dv = 0; dv < quadHeight; dv++)
                         {
-                            AddFace(mesh.get(), blockPos, block.GetType(), face);
+                            sliceRows[v + dv] = static_cast<uint16_t>(sliceRows[v + dv] & ~span);
                         }
+
+                        int x, y, z;
+                        if (face <= 1) { x = u; y = yBegin + v; z = slice; }
+                        else if (face <= 3) { x = slice; y = yBegin + v; z = u; }
+                        else { x = u; y = yBegin + slice; z = v; }
+
+                        const BlockType type = static_cast<BlockType>(key & 0xFFu);
+                        mesh->AddQuad(x, y, z, width, quadHeight, face, tiles.Get(type, face), ao, renderLayers(type));
                     }
                 }
             }
         }
-
-        mesh->Build();
-        return mesh;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,362 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "World/ChunkMeshInput.h"
+#include "World/World.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHUNK_MESH_INPUT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MinecraftClone
+{
+    ChunkMeshInput::ChunkMeshInput() : m_types(VOLUME, BlockType::Air), m_topY(0)
+    {
+    }
+
+    void ChunkMeshInput::Clear()
+    {
+        std::fill(m_types.begin(), m_types.end(), BlockType::Air);
+        m_topY = 0;
+    }
+
+    void ChunkMeshInput::Set(int x, int y, int z, BlockType type)
+    {
+        m_types[Index(x, y, z)] = type;
+
+        // Keep the top bound conservative: setting air never lowers it
+        bool inCentre = x >= 0 && x < CHUNK_SIZE_X && z >= 0 && z < CHUNK_SIZE_Z && y >= 0 && y < CHUNK_SIZE_Y;
+        if (inCentre && type != BlockType::Air)
+        {
+            m_topY = std::max(m_topY, y + 1);
+        }
+    }
+
+    BlockType ChunkMeshInput::GetCellType(const Chunk& chunk, int cellX, int cellY, int cellZ, int scale)
+    {
+        // A cell holds at most 64 blocks of a handful of types: count them in a short list
+        BlockType types[64];
+        int counts[64];
+        int distinct = 0;
+        int solid = 0;
+
+        const Block* blocks = chunk.GetBlockData();
+        for (int y = cellY * scale; y < (cellY + 1) * scale; y++)
+        {
+            for (int z = cellZ * scale; z < (cellZ + 1) * scale; z++)
+            {
+                const Block* row = blocks + y * CHUNK_SIZE_X * CHUNK_SIZE_Z + z * CHUNK_SIZE_X;
+                for (int x = cellX * scale; x < (cellX + 1) * scale; x++)
+                {
+                    BlockType type = row[x].GetType();
+                    if (type == BlockType::Air)
+                    {
+                        continue;
+                    }
+
+                    solid++;
+                    int i = 0;
+                    while (i < distinct && types[i] != type)
+                    {
+                        i++;
+                    }
+                    if (i == distinct)
+                    {
+                        types[distinct] = type;
+                        counts[distinct++] = 0;
+                    }
+                    counts[i]++;
+                }
+            }
+        }
+
+        if (solid * 2 < scale * scale * scale)
+        {
+            return BlockType::Air;
+        }
+        int best = 0;
+        for (int i = 1; i < distinct; i++)
+        {
+            best = (counts[i] > counts[best]) ? i : best;
+        }
+        return types[best];
+    }
+
+    void ChunkMeshInput::Assemble(const Chunk& chunk, const Chunk* const neighbors[3][3], bool lodSkirts)
+    {
+        static constexpr int LAYER = CHUNK_SIZE_X * CHUNK_SIZE_Z;
+        static constexpr int PADDED_LAYER = SIZE_X * SIZE_Z;
+
+        BlockType* types = m_types.data();
+
+        // Below and above the world
+        std::fill(types, types + PADDED_LAYER, BlockType::Air);
+        std::fill(types + (SIZE_Y - 1) * PADDED_LAYER, types + VOLUME, BlockType::Air);
+
+        // Centre chunk
+        const Block* blocks = chunk.GetBlockData();
+        m_topY = 0;
+
+#ifdef CHUNK_MESH_INPUT_SSE2
+        // Blocks are {type, light, sky}: mask the type bytes of a 16-block (48-byte) row so all-air
+        // rows (most of the chunk above the surface) are detected without a strided copy
+        static_assert(sizeof(Block) == 3, "Row test assumes 3-byte blocks");
+        alignas(16) uint8_t typeBytePattern[48] = {};
+        for (int i = 0; i < 48; i += 3)
+        {
+            typeBytePattern[i] = 0xFF;
+        }
+        const __m128i typeMask0 = _mm_load_si128(reinterpret_cast<const __m128i*>(typeBytePattern));
+        const __m128i typeMask1 = _mm_load_si128(reinterpret_cast<const __m128i*>(typeBytePattern + 16));
+        const __m128i typeMask2 = _mm_load_si128(reinterpret_cast<const __m128i*>(typeBytePattern + 32));
+        const __m128i zero = _mm_setzero_si128();
+#endif
+
+        for (int y = 0; y < CHUNK_SIZE_Y; y++)
+        {
+            bool layerHasBlocks = false;
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                const Block* src = blocks + y * LAYER + z * CHUNK_SIZE_X;
+                BlockType* dst = types + Index(0, y, z);
+
+#ifdef CHUNK_MESH_INPUT_SSE2
+                const __m128i* row = reinterpret_cast<const __m128i*>(src);
+                __m128i rowTypes = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_loadu_si128(row), typeMask0),
+                                                             _mm_and_si128(_mm_loadu_si128(row + 1), typeMask1)),
+                                                _mm_and_si128(_mm_loadu_si128(row + 2), typeMask2));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(rowTypes, zero)) == 0xFFFF)
+                {
+                    std::memset(dst, 0, CHUNK_SIZE_X);
+                    continue;
+                }
+#endif
+
+                uint8_t any = 0;
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
+                {
+                    BlockType type = src[x].GetType();
+                    dst[x] = type;
+                    any |= static_cast<uint8_t>(type);
+                }
+                layerHasBlocks |= (any != 0);
+            }
+            if (layerHasBlocks)
+            {
+                m_topY = y + 1;
+            }
+        }
+
+        AssembleBorder(neighbors);
+        if (lodSkirts)
+        {
+            ApplyLodSkirts(neighbors);
+        }
+    }
+
+    void ChunkMeshInput::AssembleDownsampled(const Chunk& chunk, const Chunk* const neighbors[3][3], int scale)
+    {
+        static constexpr int PADDED_LAYER = SIZE_X * SIZE_Z;
+
+        BlockType* types = m_types.data();
+        std::fill(types, types + PADDED_LAYER, BlockType::Air);
+        std::fill(types + (SIZE_Y - 1) * PADDED_LAYER, types + VOLUME, BlockType::Air);
+
+        // Every block of a cell takes the cell's type
+        m_topY = 0;
+        for (int cellY = 0; cellY < CHUNK_SIZE_Y / scale; cellY++)
+        {
+            bool cellLayerHasBlocks = false;
+            for (int cellZ = 0; cellZ < CHUNK_SIZE_Z / scale; cellZ++)
+            {
+                for (int cellX = 0; cellX < CHUNK_SIZE_X / scale; cellX++)
+                {
+                    const BlockType type = GetCellType(chunk, cellX, cellY, cellZ, scale);
+                    cellLayerHasBlocks |= (type != BlockType::Air);
+                    for (int y = cellY * scale; y < (cellY + 1) * scale; y++)
+                    {
+                        for (int z = cellZ * scale; z < (cellZ + 1) * scale; z++)
+                        {
+                            std::fill_n(types + Index(cellX * scale, y, z), scale, type);
+                        }
+                    }
+                }
+            }
+            if (cellLayerHasBlocks)
+            {
+                m_topY = (cellY + 1) * scale;
+            }
+        }
+
+        AssembleBorder(neighbors);
+        ApplyLodSkirts(neighbors);
+    }
+
+    void ChunkMeshInput::AssembleBorder(const Chunk* const neighbors[3][3])
+    {
+        static constexpr int LAYER = CHUNK_SIZE_X * CHUNK_SIZE_Z;
+
+        BlockType* types = m_types.data();
+
+        // Border columns and rows from the neighbours (air where a neighbour is missing)
+        auto neighborType = [](const Chunk* neighbor, const Block* data, int x, int y, int z) {
+            return neighbor ? data[y * LAYER + z * CHUNK_SIZE_X + x].GetType() : BlockType::Air;
+        };
+
+        const Chunk* back = neighbors[0][1];
+        const Chunk* front = neighbors[2][1];
+        const Chunk* left = neighbors[1][0];
+        const Chunk* right = neighbors[1][2];
+        const Block* backData = back ? back->GetBlockData() : nullptr;
+        const Block* frontData = front ? front->GetBlockData() : nullptr;
+        const Block* leftData = left ? left->GetBlockData() : nullptr;
+        const Block* rightData = right ? right->GetBlockData() : nullptr;
+
+        const Chunk* corners[4] = { neighbors[0][0], neighbors[0][2], neighbors[2][0], neighbors[2][2] };
+        const int cornerX[4] = { -1, CHUNK_SIZE_X, -1, CHUNK_SIZE_X };
+        const int cornerZ[4] = { -1, -1, CHUNK_SIZE_Z, CHUNK_SIZE_Z };
+
+        // Meshing never looks at the border above the centre's top layer + 1; leave it air
+        const int borderTop = std::min(m_topY + 1, CHUNK_SIZE_Y);
+        for (int y = borderTop; y < CHUNK_SIZE_Y; y++)
+        {
+            std::memset(types + Index(-1, y, -1), 0, SIZE_X);
+            std::memset(types + Index(-1, y, CHUNK_SIZE_Z), 0, SIZE_X);
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                types[Index(-1, y, z)] = BlockType::Air;
+                types[Index(CHUNK_SIZE_X, y, z)] = BlockType::Air;
+            }
+        }
+
+        for (int y = 0; y < borderTop; y++)
+        {
+            for (int i = 0; i < CHUNK_SIZE_X; i++)
+            {
+                types[Index(i, y, -1)] = neighborType(back, backData, i, y, CHUNK_SIZE_Z - 1);
+                types[Index(i, y, CHUNK_SIZE_Z)] = neighborType(front, frontData, i, y, 0);
+                types[Index(-1, y, i)] = neighborType(left, leftData, CHUNK_SIZE_X - 1, y, i);
+                types[Index(CHUNK_SIZE_X, y, i)] = neighborType(right, rightData, 0, y, i);
+            }
+
+            for (int c = 0; c < 4; c++)
+            {
+                // Wrap the padded coordinate into the diagonal neighbour
+                int localX = (cornerX[c] + CHUNK_SIZE_X) % CHUNK_SIZE_X;
+                int localZ = (cornerZ[c] + CHUNK_SIZE_Z) % CHUNK_SIZE_Z;
+                types[Index(cornerX[c], y, cornerZ[c])] = corners[c]
+                    ? corners[c]->GetBlockData()[y * LAYER + localZ * CHUNK_SIZE_X + localX].GetType()
+                    : BlockType::Air;
+            }
+        }
+    }
+
+    void ChunkMeshInput::ApplyLodSkirts(const Chunk* const neighbors[3][3])
+    {
+        // Drop border blocks that a 2x or 4x cell of the neighbour rounds to air. Cells are looked up
+        // once per side and level: the border touches 8 x 128 cells at 2x and 4 x 64 at 4x.
+        const int borderTop = std::min(m_topY + 1, CHUNK_SIZE_Y);
+        BlockType* types = m_types.data();
+
+        // Side neighbours by offset
+        struct Side
+        {
+            int dx;
+            int dz;
+        };
+        const Side sides[4] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+        for (const Side& side : sides)
+        {
+            const Chunk* neighbor = neighbors[side.dz + 1][side.dx + 1];
+            if (!neighbor)
+            {
+                continue;
+            }
+
+            int8_t solid[LOD_LEVEL_COUNT][CHUNK_SIZE_Y / 2][CHUNK_SIZE_X / 2];
+            std::memset(solid, -1, sizeof(solid));
+            for (int y = 0; y < borderTop; y++)
+            {
+                for (int i = 0; i < CHUNK_SIZE_X; i++)
+                {
+                    // Padded position of the border block and the same block in the neighbour
+                    const int paddedX = (side.dx == 0) ? i : (side.dx < 0 ? -1 : CHUNK_SIZE_X);
+                    const int paddedZ = (side.dz == 0) ? i : (side.dz < 0 ? -1 : CHUNK_SIZE_Z);
+                    BlockType& type = types[Index(paddedX, y, paddedZ)];
+                    if (type == BlockType::Air)
+                    {
+                        continue;
+                    }
+
+                    const int localX = (paddedX + CHUNK_SIZE_X) % CHUNK_SIZE_X;
+                    const int localZ = (paddedZ + CHUNK_SIZE_Z) % CHUNK_SIZE_Z;
+                    for (int level = 0; level < LOD_LEVEL_COUNT && type != BlockType::Air; level++)
+                    {
+                        const int scale = GetLodScale(level);
+                        int8_t& cached = solid[level][y / scale][i / scale];
+                        if (cached < 0)
+                        {
+                            cached = GetCellType(*neighbor, localX / scale, y / scale, localZ / scale, scale) != BlockType::Air;
+                        }
+                        type = cached ? type : BlockType::Air;
+                    }
+                }
+            }
+        }
+
+        // Corner columns only feed ambient occlusion, but follow the same rule
+        for (int dz = -1; dz <= 1; dz += 2)
+        {
+            for (int dx = -1; dx <= 1; dx += 2)
+            {
+                const Chunk* neighbor = neighbors[dz + 1][dx + 1];
+                if (!neighbor)
+                {
+                    continue;
+                }
+
+                const int paddedX = dx < 0 ? -1 : CHUNK_SIZE_X;
+                const int paddedZ = dz < 0 ? -1 : CHUNK_SIZE_Z;
+                const int localX = (paddedX + CHUNK_SIZE_X) % CHUNK_SIZE_X;
+                const int localZ = (paddedZ + CHUNK_SIZE_Z) % CHUNK_SIZE_Z;
+                for (int y = 0; y < borderTop; y++)
+                {
+                    BlockType& type = types[Index(paddedX, y, paddedZ)];
+                    for (int level = 0; level < LOD_LEVEL_COUNT && type != BlockType::Air; level++)
+                    {
+                        const int scale = GetLodScale(level);
+                        if (GetCellType(*neighbor, localX / scale, y / scale, localZ / scale, scale) == BlockType::Air)
+                        {
+                            type = BlockType::Air;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    bool ChunkMeshInput::Assemble(World* world, int chunkX, int chunkZ, bool lodSkirts)
+    {
+        Chunk* chunk = world ? world->GetChunk(chunkX, chunkZ) : nullptr;
+        if (!chunk)
+        {
+            return false;
+        }
+
+        const Chunk* neighbors[3][3];
+        for (int dz = -1; dz <= 1; dz++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                neighbors[dz + 1][dx + 1] = (dx == 0 && dz == 0) ? nullptr : world->GetChunk(chunkX + dx, chunkZ + dz);
+            }
+        }
+
+        Assemble(*chunk, neighbors, lodSkirts);
+        return true;
+    }
+}
@@ -8,11 +8,21 @@
 #include "Rendering/BlockTextureRegistry.h"
 #include "Rendering/Frustum.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cfloat>
 #include <set>
+#include <thread>
 
 namespace MinecraftClone
 {
     ChunkRenderer::ChunkRenderer()
+        : m_frameDataBuffer(0), m_alphaCutoffLocation(-1), m_layerAlphaLocation(-1),
+          m_chunks(DEFAULT_CHUNK_WINDOW_RADIUS), m_lodDistances{ 8.0f * CHUNK_SIZE_X, 16.0f * CHUNK_SIZE_X }, m_caveCulling(true), m_lastCaveCulled(0),
+          m_occlusionCulling(true), m_cullListsDirty(true), m_batchVAO(0), m_originBuffer(0), m_indirectBuffer(0),
+          m_multiDrawCalls(0), m_indirectCommands(0), m_sortCameraPosition(0.0f), m_sortCameraSection(0), m_hasSortCamera(false)
     {
     }
 
@@ -23,29 +33,6 @@ namespace MinecraftClone
 
     bool ChunkRenderer::Initialize()
     {
-        const std::string vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in vec3 aNormal;
-
-out vec2 TexCoord;
-out vec3 Normal;
-out vec3 FragPos;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
-    TexCoord = aTexCoord;
-    gl_Position = projection * view * vec4(FragPos, 1.0);
-}
-)";
-
         const std::string fragmentShaderSource = R"(
 #version 330 core
 out vec4 FragColorOut;
@@ -53,78 +40,286 @@ out vec4 FragColorOut;
 in vec2 TexCoord;
 in vec3 Normal;
 in vec3 FragPos;
+in float AO;
+flat in uint Tile;
 
-uniform sampler2D blockTexture;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 viewPos;
+uniform sampler2DArray blockTextures;  // One layer per block texture
+layout(std140) uniform FrameData  // Same block as the vertex shader's (struct FrameData)
+{
+    mat4 view;
+    mat4 projection;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 viewPos;
+};
+uniform float alphaCutoff;  // Cutout layer: texels below this alpha are discarded
+uniform float layerAlpha;   // Translucent layer: opacity applied on top of the texture's
 
 void main()
 {
-    vec4 texColor = texture(blockTexture, TexCoord);
+    // TexCoord is in block units: the layer's GL_REPEAT tiles it across merged quads
+    vec4 texColor = texture(blockTextures, vec3(TexCoord, float(Tile)));
+    if (texColor.a < alphaCutoff)
+    {
+        discard;
+    }
 
     // Ambient
     float ambientStrength = 0.3;
-    vec3 ambient = ambientStrength * lightColor;
+    vec3 ambient = ambientStrength * lightColor.rgb;
 
     // Diffuse
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
+    vec3 lightDir = normalize(lightPos.xyz - FragPos);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
+    vec3 diffuse = diff * lightColor.rgb;
 
     // Specular
     float specularStrength = 0.1;
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
+    vec3 specular = specularStrength * spec * lightColor.rgb;
 
-    vec3 result = (ambient + diffuse + specular) * texColor.rgb;
-    FragColorOut = vec4(result, texColor.a);
+    // Occluded corners keep half their light
+    float occlusion = mix(0.5, 1.0, AO);
+    vec3 result = (ambient + diffuse) * occlusion * texColor.rgb + specular * texColor.rgb;
+    FragColorOut = vec4(result, texColor.a * layerAlpha);
 }
 )";
 
         m_shader = std::make_unique<Shader>();
-        if (!m_shader->LoadFromSource(vertexShaderSource, fragmentShaderSource))
+        if (!m_shader->LoadFromSource(ChunkMesh::GetVertexShaderSource(), fragmentShaderSource))
         {
             spdlog::error("Failed to create chunk shader!");
             return false;
         }
 
+        // Per-frame values go through one uniform buffer; the samplers never change, and the two
+        // per-layer uniforms are set through locations looked up once
+        ChunkMesh::BindFrameData(m_shader->GetID());
+        glGenBuffers(1, &m_frameDataBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_frameDataBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        m_shader->Use();
+        m_shader->SetInt("blockTextures", 0);
+        m_shader->SetInt("faces", ChunkMesh::FACE_TEXTURE_UNIT);
+        m_shader->Unuse();
+        m_alphaCutoffLocation = glGetUniformLocation(m_shader->GetID(), "alphaCutoff");
+        m_layerAlphaLocation = glGetUniformLocation(m_shader->GetID(), "layerAlpha");
+
+        // Half the cores at most 4: the chunk workers run alongside
+        const unsigned int occlusionThreads = std::min(4u, std::max(1u, std::thread::hardware_concurrency() / 2));
+        m_occlusionCuller.Initialize(OcclusionCuller::DEFAULT_WIDTH, OcclusionCuller::DEFAULT_HEIGHT, static_cast<int>(occlusionThreads));
+
+        // Without the arena every mesh keeps its own buffer and is drawn on its own
+        if (m_arena.Initialize(ARENA_CAPACITY_FACES))
+        {
+            glGenVertexArrays(1, &m_batchVAO);
+            glGenBuffers(1, &m_originBuffer);
+            glGenBuffers(1, &m_indirectBuffer);
+
+            // Instanced with divisor 1: each indirect draw has one instance, so it reads entry baseInstance
+            glBindVertexArray(m_batchVAO);
+            glBindBuffer(GL_ARRAY_BUFFER, m_originBuffer);
+            glEnableVertexAttribArray(ChunkMesh::ORIGIN_ATTRIBUTE);
+            glVertexAttribPointer(ChunkMesh::ORIGIN_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+            glVertexAttribDivisor(ChunkMesh::ORIGIN_ATTRIBUTE, 1);
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
         // Initialize texture registry
         BlockTextureRegistry::Initialize();
 
-        // Load texture atlas
+        // OPTIMIZATION 20: Block texture array
+        // The atlas's tiles become the layers of one array texture, each with its own mip chain, so
+        // distant faces never blend in a neighbouring tile and merged quads repeat their texture
+        // through GL_REPEAT instead of wrapping inside the atlas in the shader.
         std::string atlasPath = "assets/textures/block_atlas.png";
-        m_atlasTexture = std::make_unique<Texture>();
-        if (!m_atlasTexture->LoadFromFile(atlasPath))
+        m_blockTextures = std::make_unique<Texture>();
+        if (!m_blockTextures->LoadArrayFromGrid(atlasPath, BlockTextureRegistry::ATLAS_SIZE, BlockTextureRegistry::ATLAS_SIZE))
         {
-            spdlog::error("Failed to load texture atlas: {}", atlasPath);
+            spdlog::error("Failed to load block textures: {}", atlasPath);
             return false;
         }
 
-        spdlog::info("Loaded texture atlas: {}", atlasPath);
-
         return true;
     }
 
     void ChunkRenderer::UpdateChunk(Chunk* chunk, int chunkX, int chunkZ, World* world)
     {
-        if (!chunk)
+        UpdateSections(chunk, chunkX, chunkZ, world, ChunkMeshGenerator::ALL_SECTIONS);
+    }
+
+    void ChunkRenderer::UpdateSections(Chunk* chunk, int chunkX, int chunkZ, World* world, uint32_t sectionMask)
+    {
+        if (!chunk || sectionMask == 0)
+        {
+            return;
+        }
+
+        ChunkSectionMeshes meshes = ChunkMeshGenerator::GenerateSectionMeshes(chunk, chunkX, chunkZ, world, sectionMask,
+                                                                              ChunkMeshGenerator::GetMeshingMode());
+        if (ChunkMeshGenerator::IsLodEnabled())
+        {
+            ChunkMeshGenerator::GenerateLodMeshes(chunk, chunkX, chunkZ, world, meshes);
+        }
+        SetSectionMeshes(chunkX, chunkZ, std::move(meshes));
+    }
+
+    void ChunkRenderer::UpdateBlock(int worldX, int worldY, int worldZ, World* world)
+    {
+        if (!world)
+        {
+            return;
+        }
+
+        SectionRemesh updates[ChunkMeshGenerator::MAX_AFFECTED_CHUNKS];
+        int updateCount = ChunkMeshGenerator::GetSectionsAffectedByBlock(worldX, worldY, worldZ, updates);
+
+        for (int i = 0; i < updateCount; i++)
+        {
+            Chunk* chunk = world->GetChunk(updates[i].chunkX, updates[i].chunkZ);
+            if (chunk)
+            {
+                UpdateSections(chunk, updates[i].chunkX, updates[i].chunkZ, world, updates[i].sectionMask);
+            }
+        }
+    }
+
+    void ChunkRenderer::SetSectionMeshes(int chunkX, int chunkZ, ChunkSectionMeshes meshes)
+    {
+        ChunkSlot* slot = m_chunks.Insert(chunkX, chunkZ);
+        if (!slot)
+        {
+            return;  // Outside the chunk window: the chunk is being unloaded
+        }
+        m_cullListsDirty = true;
+        SectionMeshArray& sections = slot->sections;
+        SectionVisibilityArray& visibility = slot->visibility;
+
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+        {
+            if ((meshes.sectionMask >> section & 1u) == 0)
+            {
+                continue;
+            }
+            visibility[section] = meshes.visibility[section];
+
+            std::unique_ptr<ChunkMesh>& mesh = meshes.sections[section];
+            if (mesh)
+            {
+                // Upload translucent quads already in the order the current camera needs
+                if (m_hasSortCamera && mesh->HasLayer(RenderLayer::Translucent))
+                {
+                    mesh->SortTranslucent(m_sortCameraPosition);
+                }
+                mesh->Build(&m_arena);
+            }
+            sections[section] = std::move(mesh);
+        }
+
+        // Every remesh while LOD meshing is on carries the LOD meshes; one without them means it is off
+        slot->hasLods = meshes.hasLods;
+        LodMeshArray& lods = slot->lods;
+        if (!meshes.hasLods)
         {
+            lods = LodMeshArray();
             return;
         }
+        for (int level = 0; level < ChunkMeshInput::LOD_LEVEL_COUNT; level++)
+        {
+            std::unique_ptr<ChunkMesh>& mesh = meshes.lods[level];
+            if (mesh)
+            {
+                if (m_hasSortCamera && mesh->HasLayer(RenderLayer::Translucent))
+                {
+                    mesh->SortTranslucent(m_sortCameraPosition);
+                }
+                mesh->Build(&m_arena);
+            }
+            lods[level] = std::move(mesh);
+        }
+    }
 
-        auto key = std::make_pair(chunkX, chunkZ);
-        auto mesh = ChunkMeshGenerator::GenerateMesh(chunk, chunkX, chunkZ, world);
-        m_chunkMeshes[key] = std::move(mesh);
+    void ChunkRenderer::AddOccluders()
+    {
+        m_occluderBoxes.clear();
+        m_chunks.ForEach([this](int chunkX, int chunkZ, const ChunkSlot& slot) {
+            const float minX = static_cast<float>(chunkX * CHUNK_SIZE_X);
+            const float minZ = static_cast<float>(chunkZ * CHUNK_SIZE_Z);
+            if (m_frustum.IsAABBVisible(glm::vec3(minX, 0.0f, minZ), glm::vec3(minX + CHUNK_SIZE_X, CHUNK_SIZE_Y, minZ + CHUNK_SIZE_Z)))
+            {
+                GetChunkOccluders(chunkX, chunkZ, slot.visibility.data(), m_occluderBoxes);
+            }
+        });
+        for (const OccluderBox& box : m_occluderBoxes)
+        {
+            m_occlusionCuller.AddOccluder(box.min, box.max);
+        }
     }
 
-    void ChunkRenderer::SetChunkMesh(int chunkX, int chunkZ, std::unique_ptr<ChunkMesh> mesh)
+    void ChunkRenderer::RebuildCullLists()
     {
-        auto key = std::make_pair(chunkX, chunkZ);
-        m_chunkMeshes[key] = std::move(mesh);
+        m_chunkBounds.Clear();
+        m_cullChunks.clear();
+        m_sectionBounds.Clear();
+        m_cullSections.clear();
+
+        m_chunks.ForEach([this](int chunkX, int chunkZ, ChunkSlot& slot) {
+            const SectionMeshArray& sections = slot.sections;
+            const LodMeshArray* lods = slot.hasLods ? &slot.lods : nullptr;
+            const uint32_t chunkIndex = static_cast<uint32_t>(m_cullChunks.size());
+            glm::vec3 chunkMin(FLT_MAX);
+            glm::vec3 chunkMax(-FLT_MAX);
+            int sectionCount = 0;
+
+            for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+            {
+                ChunkMesh* mesh = sections[section].get();
+                if (mesh && !mesh->IsEmpty())
+                {
+                    m_sectionBounds.Add(mesh->GetBoundsMin(), mesh->GetBoundsMax());
+                    m_cullSections.push_back({ mesh, chunkIndex, section });
+                    chunkMin = glm::min(chunkMin, mesh->GetBoundsMin());
+                    chunkMax = glm::max(chunkMax, mesh->GetBoundsMax());
+                    sectionCount++;
+                }
+            }
+            for (int level = 0; lods && level < ChunkMeshInput::LOD_LEVEL_COUNT; level++)
+            {
+                const ChunkMesh* mesh = (*lods)[level].get();
+                if (mesh && !mesh->IsEmpty())
+                {
+                    chunkMin = glm::min(chunkMin, mesh->GetBoundsMin());
+                    chunkMax = glm::max(chunkMax, mesh->GetBoundsMax());
+                }
+            }
+
+            // Nothing to draw at any level
+            if (chunkMin.x > chunkMax.x)
+            {
+                return;
+            }
+            m_chunkBounds.Add(chunkMin, chunkMax);
+            m_cullChunks.push_back({ std::make_pair(chunkX, chunkZ), lods, sectionCount });
+        });
+        m_cullListsDirty = false;
+    }
+
+    int ChunkRenderer::SelectLodLevel(float distance) const
+    {
+        for (int level = ChunkMeshInput::LOD_LEVEL_COUNT - 1; level >= 0; level--)
+        {
+            if (distance >= m_lodDistances[level])
+            {
+                return level;
+            }
+        }
+        return -1;
     }
 
     void ChunkRenderer::RenderChunks(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix)
@@ -133,111 +328,474 @@ void main()
         {
             return;
         }
+        const auto cpuStart = std::chrono::steady_clock::now();
 
         // Extract frustum planes from view-projection matrix for culling
         glm::mat4 viewProjection = projectionMatrix * viewMatrix;
         m_frustum.ExtractPlanes(viewProjection);
 
-        m_shader->Use();
+        const glm::vec3 cameraPosition = glm::vec3(glm::inverse(viewMatrix)[3]);
 
-        // Bind texture atlas
-        if (m_atlasTexture)
+        // Back-to-front order inside translucent sections only changes meaningfully when the camera
+        // moves into another section, so re-sort then rather than every frame
+        const glm::ivec3 cameraSection(static_cast<int>(std::floor(cameraPosition.x / CHUNK_SIZE_X)),
+                                       static_cast<int>(std::floor(cameraPosition.y / CHUNK_SECTION_SIZE)),
+                                       static_cast<int>(std::floor(cameraPosition.z / CHUNK_SIZE_Z)));
+        if (!m_hasSortCamera || cameraSection != m_sortCameraSection)
         {
-            m_atlasTexture->Bind(0);
+            m_hasSortCamera = true;
+            m_sortCameraSection = cameraSection;
+            m_sortCameraPosition = cameraPosition;
+            SortTranslucentSections(cameraPosition);
         }
-        m_shader->SetInt("blockTexture", 0);
-
-        // Set up lighting (simple directional light)
-        glm::vec3 lightPos = glm::vec3(100.0f, 100.0f, 100.0f);
-        glm::vec3 lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
-        glm::vec3 viewPos = glm::vec3(0.0f, 0.0f, 0.0f); // Will be set from camera
 
-        m_shader->SetVec3("lightPos", lightPos);
-        m_shader->SetVec3("lightColor", lightColor);
-        m_shader->SetVec3("viewPos", viewPos);
+        int sectionsRendered = 0;
+        int sectionsCulled = 0;
+        int sectionsCaveCulled = 0;
+        int lodChunksRendered = 0;
+        const bool lodEnabled = ChunkMeshGenerator::IsLodEnabled();
+        m_visibleSections.clear();
+
+        // OPTIMIZATION 16: Cave culling
+        // Walk the sections' face connectivity outward from the camera's section, inside the frustum;
+        // a section the walk cannot reach is hidden behind opaque blocks and is not drawn, which
+        // underground leaves little more than the cave the camera is in. Chunks not meshed yet count as open.
+        bool caveCulled = false;
+        if (m_caveCulling)
+        {
+            int radius = 0;
+            m_chunks.ForEach([&radius, &cameraSection](int chunkX, int chunkZ, const ChunkSlot&) {
+                radius = std::max(radius, std::max(std::abs(chunkX - cameraSection.x), std::abs(chunkZ - cameraSection.z)));
+            });
+            caveCulled = m_visibilityGraph.Traverse(cameraPosition, radius,
+                [this](int chunkX, int section, int chunkZ) -> const SectionVisibility* {
+                    const ChunkSlot* slot = m_chunks.Find(chunkX, chunkZ);
+                    return slot ? &slot->visibility[section] : nullptr;
+                },
+                [this](int chunkX, int section, int chunkZ) {
+                    const glm::vec3 sectionMin(static_cast<float>(chunkX * CHUNK_SIZE_X), static_cast<float>(section * CHUNK_SECTION_SIZE),
+                                               static_cast<float>(chunkZ * CHUNK_SIZE_Z));
+                    return m_frustum.IsAABBVisible(sectionMin, sectionMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z));
+                });
+        }
 
-        int chunksRendered = 0;
-        int chunksCulled = 0;
+        // Hills and mountains: sections behind the fully opaque layers of nearer chunks fail the depth test
+        float occlusionMs = 0.0f;
+        if (m_occlusionCulling)
+        {
+            m_occlusionCuller.BeginFrame(viewProjection, cameraPosition);
+            AddOccluders();
+            m_occlusionCuller.Rasterize();
+            occlusionMs = static_cast<float>(m_occlusionCuller.GetStats().rasterizeMs);
+        }
+        int sectionsOccluded = 0;
 
-        for (auto& [coord, mesh] : m_chunkMeshes)
+        // Frustum culling in two batches over the packed mesh bounds: chunks first (a distant one in
+        // the frustum draws its LOD mesh instead of its sections), then every section
+        if (m_cullListsDirty)
         {
-            if (mesh && !mesh->IsEmpty())
+            RebuildCullLists();
+        }
+        m_chunkDrawsLod.assign(m_cullChunks.size(), 0);
+        int lodSections = 0;
+        if (lodEnabled)
+        {
+            m_frustumVisible.clear();
+            m_frustum.CullAABBs(m_chunkBounds, m_frustumVisible);
+            for (uint32_t index : m_frustumVisible)
             {
-                // Calculate chunk bounding box in world space
-                int chunkX = coord.first;
-                int chunkZ = coord.second;
-                
-                // Chunk spans from (chunkX * 16, 0, chunkZ * 16) to ((chunkX + 1) * 16, 256, (chunkZ + 1) * 16)
-                glm::vec3 chunkMin(
-                    static_cast<float>(chunkX * CHUNK_SIZE_X),
-                    0.0f,
-                    static_cast<float>(chunkZ * CHUNK_SIZE_Z)
-                );
-                glm::vec3 chunkMax(
-                    static_cast<float>((chunkX + 1) * CHUNK_SIZE_X),
-                    static_cast<float>(CHUNK_SIZE_Y),
-                    static_cast<float>((chunkZ + 1) * CHUNK_SIZE_Z)
-                );
+                const CullChunk& chunk = m_cullChunks[index];
+                const glm::vec2 offset(static_cast<float>(chunk.coord.first * CHUNK_SIZE_X) + CHUNK_SIZE_X * 0.5f - cameraPosition.x,
+                                       static_cast<float>(chunk.coord.second * CHUNK_SIZE_Z) + CHUNK_SIZE_Z * 0.5f - cameraPosition.z);
+                const int level = chunk.lods ? SelectLodLevel(glm::length(offset)) : -1;
+                if (level < 0)
+                {
+                    continue;
+                }
+                m_chunkDrawsLod[index] = 1;
+                lodSections += chunk.sectionCount;
 
-                // Test if chunk is visible in frustum
-                if (m_frustum.IsAABBVisible(chunkMin, chunkMax))
+                ChunkMesh* mesh = (*chunk.lods)[level].get();
+                const glm::vec3 chunkMin = m_chunkBounds.GetMin(index);
+                const glm::vec3 chunkMax = m_chunkBounds.GetMax(index);
+                if (!mesh || mesh->IsEmpty())
                 {
-                    mesh->Render(viewMatrix, projectionMatrix, m_shader.get());
-                    chunksRendered++;
+                    continue;
+                }
+                if (caveCulled && !m_visibilityGraph.IsChunkReachable(chunk.coord.first, chunk.coord.second))
+                {
+                    sectionsCaveCulled++;
+                }
+                else if (m_occlusionCulling && !m_occlusionCuller.IsVisible(chunkMin, chunkMax))
+                {
+                    sectionsOccluded++;
                 }
                 else
                 {
-                    chunksCulled++;
+                    const glm::vec3 centreOffset = (chunkMin + chunkMax) * 0.5f - cameraPosition;
+                    m_visibleSections.push_back({ mesh, glm::dot(centreOffset, centreOffset),
+                                                  ChunkMesh::GetFacingDirections(cameraPosition, chunkMin, chunkMax) });
+                    lodChunksRendered++;
                 }
             }
         }
 
+        m_frustumVisible.clear();
+        m_frustum.CullAABBs(m_sectionBounds, m_frustumVisible);
+        int sectionsInFrustum = 0;
+        for (uint32_t index : m_frustumVisible)
+        {
+            const CullSection& entry = m_cullSections[index];
+            if (m_chunkDrawsLod[entry.chunk])
+            {
+                continue;
+            }
+            sectionsInFrustum++;
+
+            const std::pair<int, int>& coord = m_cullChunks[entry.chunk].coord;
+            const glm::vec3 sectionMin = m_sectionBounds.GetMin(index);
+            const glm::vec3 sectionMax = m_sectionBounds.GetMax(index);
+            if (caveCulled && !m_visibilityGraph.IsReachable(coord.first, entry.section, coord.second))
+            {
+                sectionsCaveCulled++;
+            }
+            else if (m_occlusionCulling && !m_occlusionCuller.IsVisible(sectionMin, sectionMax))
+            {
+                sectionsOccluded++;
+            }
+            else
+            {
+                const glm::vec3 offset = (sectionMin + sectionMax) * 0.5f - cameraPosition;
+                m_visibleSections.push_back({ entry.mesh, glm::dot(offset, offset),
+                                              ChunkMesh::GetFacingDirections(cameraPosition, sectionMin, sectionMax) });
+                sectionsRendered++;
+            }
+        }
+        sectionsCulled = static_cast<int>(m_cullSections.size()) - lodSections - sectionsInFrustum;
+
+        // OPTIMIZATION 8: Render layers
+        // Opaque faces front-to-back so early-Z rejects hidden fragments, then alpha-tested cutout
+        // faces (depth-written, so order does not matter), then translucent faces back-to-front with
+        // blending and no depth writes. Sections are sorted here; quads inside a section were sorted
+        // when the camera last crossed a section boundary.
+        std::sort(m_visibleSections.begin(), m_visibleSections.end(),
+                  [](const VisibleSection& a, const VisibleSection& b) { return a.distanceSquared < b.distanceSquared; });
+
+        const auto cullEnd = std::chrono::steady_clock::now();
+
+        // OPTIMIZATION 15: Per-frame state batching
+        // The program, the block textures and the frame's uniforms are set once: view, projection and the light
+        // (simple directional light) go up in one FrameData buffer write shared by both shader stages,
+        // and only the two layer uniforms change afterwards, through cached locations.
+        m_shader->Use();
+        if (m_blockTextures)
+        {
+            m_blockTextures->Bind(0);
+        }
+        FrameData frameData;
+        frameData.view = viewMatrix;
+        frameData.projection = projectionMatrix;
+        frameData.lightPosition = glm::vec4(100.0f, 100.0f, 100.0f, 1.0f);
+        frameData.lightColor = glm::vec4(1.0f);
+        frameData.viewPosition = glm::vec4(cameraPosition, 1.0f);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_frameDataBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &frameData);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, ChunkMesh::FRAME_DATA_BINDING, m_frameDataBuffer);
+
+        // One origin per visible section, shared by its draws in every layer
+        if (m_arena.IsInitialized())
+        {
+            m_drawOrigins.clear();
+            for (const VisibleSection& visible : m_visibleSections)
+            {
+                m_drawOrigins.emplace_back(visible.mesh->GetOrigin());
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, m_originBuffer);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_drawOrigins.size() * sizeof(glm::vec3)),
+                         m_drawOrigins.data(), GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        m_multiDrawCalls = 0;
+        m_indirectCommands = 0;
+
+        // Opaque and cutout faces pointing away from the camera are skipped as whole direction ranges
+        size_t facesDrawn = 0;
+        size_t facesVisible = 0;
+        for (const VisibleSection& visible : m_visibleSections)
+        {
+            facesVisible += visible.mesh->GetFaces(RenderLayer::Opaque).size() + visible.mesh->GetFaces(RenderLayer::Cutout).size();
+        }
+        glUniform1f(m_alphaCutoffLocation, 0.0f);
+        glUniform1f(m_layerAlphaLocation, 1.0f);
+        facesDrawn += DrawLayer(RenderLayer::Opaque, false);
+
+        glUniform1f(m_alphaCutoffLocation, 0.5f);
+        facesDrawn += DrawLayer(RenderLayer::Cutout, false);
+
+        const GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDepthMask(GL_FALSE);
+        glUniform1f(m_alphaCutoffLocation, 0.0f);
+        glUniform1f(m_layerAlphaLocation, 0.6f);
+        DrawLayer(RenderLayer::Translucent, true);
+        glDepthMask(GL_TRUE);
+        if (!blendWasEnabled)
+        {
+            glDisable(GL_BLEND);
+        }
+
+        // Ranges freed this frame are reused once the GPU has finished it
+        m_arena.EndFrame();
+
+        const auto cpuEnd = std::chrono::steady_clock::now();
+        m_lastTimings.cullMs = std::chrono::duration<float, std::milli>(cullEnd - cpuStart).count();
+        m_lastTimings.submitMs = std::chrono::duration<float, std::milli>(cpuEnd - cullEnd).count();
+        m_lastTimings.occlusionMs = occlusionMs;
+        m_timingTotals.cullMs += m_lastTimings.cullMs;
+        m_timingTotals.submitMs += m_lastTimings.submitMs;
+        m_timingTotals.occlusionMs += m_lastTimings.occlusionMs;
+        m_lastCaveCulled = sectionsCaveCulled;
+
         // Log culling stats occasionally (every 60 frames or so)
         static int frameCount = 0;
         if (++frameCount % 60 == 0)
         {
-            int totalChunks = chunksRendered + chunksCulled;
-            if (totalChunks > 0)
+            int totalSections = sectionsRendered + sectionsCulled + sectionsCaveCulled + sectionsOccluded;
+            if (totalSections > 0)
             {
-                float cullRatio = (static_cast<float>(chunksCulled) / static_cast<float>(totalChunks)) * 100.0f;
-                spdlog::info("Frustum culling: {} rendered, {} culled ({:.1f}% culled)", 
-                    chunksRendered, chunksCulled, cullRatio);
+                float cullRatio = (static_cast<float>(sectionsCulled) / static_cast<float>(totalSections)) * 100.0f;
+                spdlog::info("Frustum culling: {} sections rendered, {} culled ({:.1f}% culled), {} chunks at LOD",
+                    sectionsRendered, sectionsCulled, cullRatio, lodChunksRendered);
             }
+            if (caveCulled)
+            {
+                spdlog::info("Cave culling: {} frustum-visible sections hidden, {} reached from the camera",
+                    sectionsCaveCulled, m_visibilityGraph.GetReachableCount());
+            }
+            if (m_occlusionCulling)
+            {
+                const OcclusionStats& occlusion = m_occlusionCuller.GetStats();
+                spdlog::info("Occlusion culling: {} sections hidden ({} occluders, {} triangles, {:.2f} ms rasterizing)",
+                    sectionsOccluded, occlusion.occluders, occlusion.triangles, m_timingTotals.occlusionMs / 60.0f);
+            }
+            if (facesVisible > 0)
+            {
+                spdlog::info("Direction culling: {} of {} opaque / cutout faces drawn ({:.1f}% skipped)", facesDrawn, facesVisible,
+                    100.0 * static_cast<double>(facesVisible - facesDrawn) / static_cast<double>(facesVisible));
+            }
+            if (m_multiDrawCalls > 0)
+            {
+                const FreeListAllocator::Stats arena = m_arena.GetStats();
+                spdlog::info("Indirect batches: {} multi-draws for {} ranges; arena {:.1f} / {:.1f} MiB used, {} free blocks ({:.1f}% fragmented)",
+                    m_multiDrawCalls, m_indirectCommands,
+                    static_cast<double>(arena.used) * sizeof(ChunkFace) / (1024.0 * 1024.0),
+                    static_cast<double>(arena.capacity) * sizeof(ChunkFace) / (1024.0 * 1024.0),
+                    arena.freeBlocks, arena.GetFragmentation() * 100.0f);
+            }
+            spdlog::info("Render CPU: {:.2f} ms culling / sorting, {:.2f} ms state and draw submission (60-frame average)",
+                m_timingTotals.cullMs / 60.0f, m_timingTotals.submitMs / 60.0f);
+            m_timingTotals = RenderTimings();
         }
 
         m_shader->Unuse();
         
-        // Unbind texture
-        glBindTexture(GL_TEXTURE_2D, 0);
+        // Unbind textures
+        glActiveTexture(GL_TEXTURE0 + ChunkMesh::FACE_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     }
 
-    void ChunkRenderer::UnloadChunk(int chunkX, int chunkZ)
+    size_t ChunkRenderer::DrawLayer(RenderLayer layer, bool backToFront)
     {
-        auto key = std::make_pair(chunkX, chunkZ);
-        auto it = m_chunkMeshes.find(key);
-        if (it != m_chunkMeshes.end())
+        // Meshes outside the arena are drawn on their own, after flushing the batch so far to keep the order
+        size_t facesDrawn = 0;
+        const size_t count = m_visibleSections.size();
+        for (size_t i = 0; i < count; i++)
         {
-            it->second->Shutdown();
-            m_chunkMeshes.erase(it);
+            const size_t index = backToFront ? count - 1 - i : i;
+            const VisibleSection& visible = m_visibleSections[index];
+            if (visible.mesh->IsInArena())
+            {
+                facesDrawn += visible.mesh->AppendDraws(layer, visible.directions, static_cast<GLuint>(index), m_drawCommands);
+            }
+            else
+            {
+                FlushDraws();
+                facesDrawn += visible.mesh->Render(layer, visible.directions);
+            }
         }
+        FlushDraws();
+        return facesDrawn;
     }
 
-    void ChunkRenderer::Shutdown()
+    void ChunkRenderer::FlushDraws()
+    {
+        if (m_drawCommands.empty())
+        {
+            return;
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(m_drawCommands.size() * sizeof(DrawArraysIndirectCommand)),
+                     m_drawCommands.data(), GL_STREAM_DRAW);
+
+        glActiveTexture(GL_TEXTURE0 + ChunkMesh::FACE_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, m_arena.GetFaceTexture());
+        glActiveTexture(GL_TEXTURE0);
+
+        glBindVertexArray(m_batchVAO);
+        glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, static_cast<GLsizei>(m_drawCommands.size()), 0);
+        glBindVertexArray(0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        m_multiDrawCalls++;
+        m_indirectCommands += m_drawCommands.size();
+        m_drawCommands.clear();
+    }
+
+    void ChunkRenderer::SortTranslucentSections(const glm::vec3& cameraPosition)
+    {
+        m_chunks.ForEach([&cameraPosition](int, int, ChunkSlot& slot) {
+            for (auto& mesh : slot.sections)
+            {
+                if (mesh && mesh->HasLayer(RenderLayer::Translucent))
+                {
+                    mesh->SortTranslucent(cameraPosition);
+                }
+            }
+            for (auto& mesh : slot.lods)
+            {
+                if (mesh && mesh->HasLayer(RenderLayer::Translucent))
+                {
+                    mesh->SortTranslucent(cameraPosition);
+                }
+            }
+        });
+    }
+
+    void ChunkRenderer::ReleaseChunk(ChunkSlot& slot)
     {
-        for (auto& [coord, mesh] : m_chunkMeshes)
+        for (auto& mesh : slot.sections)
         {
             if (mesh)
             {
                 mesh->Shutdown();
             }
         }
-        m_chunkMeshes.clear();
+        slot = ChunkSlot();  // The LOD meshes' destructors release their GPU buffers
+    }
+
+    void ChunkRenderer::SetChunkWindow(int centerX, int centerZ, int radius)
+    {
+        if (centerX == m_chunks.GetCenterX() && centerZ == m_chunks.GetCenterZ() && radius == m_chunks.GetRadius())
+        {
+            return;
+        }
+        m_chunks.SetWindow(centerX, centerZ, radius, [](int, int, ChunkSlot& slot) { ReleaseChunk(slot); });
+        m_cullListsDirty = true;  // Chunks left, or every slot moved with a new radius
+    }
+
+    void ChunkRenderer::UnloadChunk(int chunkX, int chunkZ)
+    {
+        ChunkSlot* slot = m_chunks.Find(chunkX, chunkZ);
+        if (slot)
+        {
+            ReleaseChunk(*slot);
+            m_chunks.Erase(chunkX, chunkZ);
+            m_cullListsDirty = true;
+        }
+    }
+
+    size_t ChunkRenderer::GetMeshCount() const
+    {
+        size_t total = 0;
+        m_chunks.ForEach([&total](int, int, const ChunkSlot& slot) {
+            for (const auto& mesh : slot.sections)
+            {
+                total += mesh ? 1 : 0;
+            }
+        });
+        return total;
+    }
+
+    size_t ChunkRenderer::GetTotalFaceCount() const
+    {
+        size_t total = 0;
+        m_chunks.ForEach([&total](int, int, const ChunkSlot& slot) {
+            for (const auto& mesh : slot.sections)
+            {
+                if (mesh)
+                {
+                    total += mesh->GetFaceCount();
+                }
+            }
+        });
+        return total;
+    }
+
+    size_t ChunkRenderer::GetTotalLodFaceCount() const
+    {
+        size_t total = 0;
+        m_chunks.ForEach([&total](int, int, const ChunkSlot& slot) {
+            for (const auto& mesh : slot.lods)
+            {
+                total += mesh ? mesh->GetFaceCount() : 0;
+            }
+        });
+        return total;
+    }
+
+    size_t ChunkRenderer::GetTotalUploadSize() const
+    {
+        size_t total = 0;
+        m_chunks.ForEach([&total](int, int, const ChunkSlot& slot) {
+            for (const auto& mesh : slot.sections)
+            {
+                if (mesh)
+                {
+                    total += mesh->GetUploadSize();
+                }
+            }
+            for (const auto& mesh : slot.lods)
+            {
+                total += mesh ? mesh->GetUploadSize() : 0;
+            }
+        });
+        return total;
+    }
+
+    void ChunkRenderer::Shutdown()
+    {
+        m_chunks.ForEach([](int, int, ChunkSlot& slot) { ReleaseChunk(slot); });
+        m_chunks.Clear();
+        m_cullListsDirty = true;
+
+        // After the meshes, which return their ranges to it
+        if (m_batchVAO != 0)
+        {
+            glDeleteVertexArrays(1, &m_batchVAO);
+            glDeleteBuffers(1, &m_originBuffer);
+            glDeleteBuffers(1, &m_indirectBuffer);
+            m_batchVAO = 0;
+            m_originBuffer = 0;
+            m_indirectBuffer = 0;
+        }
+        m_arena.Shutdown();
+        m_occlusionCuller.Shutdown();
+        if (m_frameDataBuffer != 0)
+        {
+            glDeleteBuffers(1, &m_frameDataBuffer);
+            m_frameDataBuffer = 0;
+        }
         
-        // Clean up atlas texture
-        if (m_atlasTexture)
+        // Clean up block textures
+        if (m_blockTextures)
         {
-            m_atlasTexture->Shutdown();
-            m_atlasTexture.reset();
+            m_blockTextures->Shutdown();
+            m_blockTextures.reset();
         }
         
         m_shader.reset();
@@ -0,0 +1,373 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "World/HorizonRenderer.h"
+#include "World/TerrainGenerator.h"
+#include "World/ChunkMeshGenerator.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace MinecraftClone
+{
+    namespace
+    {
+        // Floor division so negative chunk coordinates map to the correct tile
+        int FloorDiv(int value, int divisor)
+        {
+            int quotient = value / divisor;
+            if ((value % divisor != 0) && ((value < 0) != (divisor < 0)))
+            {
+                quotient--;
+            }
+            return quotient;
+        }
+    }
+
+    HorizonRenderer::HorizonRenderer()
+        : m_terrainGenerator(nullptr)
+        , m_centerChunk(0, 0)
+        , m_renderDistance(8)
+        , m_lodDistance(24)
+        , m_hasCenter(false)
+    {
+    }
+
+    HorizonRenderer::~HorizonRenderer()
+    {
+        Shutdown();
+    }
+
+    bool HorizonRenderer::Initialize(TerrainGenerator* terrainGenerator)
+    {
+        m_terrainGenerator = terrainGenerator;
+
+        const std::string vertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+
+out vec3 Color;
+out vec3 WorldPos;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    Color = aColor;
+    WorldPos = aPos;
+    gl_Position = projection * view * vec4(aPos, 1.0);
+}
+)";
+
+        const std::string fragmentShaderSource = R"(
+#version 330 core
+out vec4 FragColorOut;
+
+in vec3 Color;
+in vec3 WorldPos;
+
+// Full-detail chunk region (minX, minZ, maxX, maxZ) - drawn by ChunkRenderer instead
+uniform vec4 innerRegion;
+
+void main()
+{
+    if (WorldPos.x > innerRegion.x && WorldPos.x < innerRegion.z &&
+        WorldPos.z > innerRegion.y && WorldPos.z < innerRegion.w)
+    {
+        discard;
+    }
+    FragColorOut = vec4(Color, 1.0);
+}
+)";
+
+        m_shader = std::make_unique<Shader>();
+        if (!m_shader->LoadFromSource(vertexShaderSource, fragmentShaderSource))
+        {
+            spdlog::error("Failed to create horizon shader!");
+            return false;
+        }
+
+        spdlog::info("HorizonRenderer initialized with LOD distance: {}", m_lodDistance);
+        return true;
+    }
+
+    void HorizonRenderer::Update(const glm::vec3& playerPosition, int renderDistance)
+    {
+        if (!m_terrainGenerator || !m_shader)
+        {
+            return;
+        }
+
+        auto chunkCoords = World::GetChunkCoords(
+            static_cast<int>(playerPosition.x),
+            static_cast<int>(playerPosition.z)
+        );
+
+        if (!m_hasCenter || chunkCoords != m_centerChunk || renderDistance != m_renderDistance)
+        {
+            m_centerChunk = chunkCoords;
+            m_renderDistance = renderDistance;
+            m_hasCenter = true;
+            RefreshTiles();
+        }
+
+        // Build a few tiles per frame (closest first)
+        int builtThisFrame = 0;
+        while (!m_tilesToBuild.empty() && builtThisFrame < MAX_TILES_PER_FRAME)
+        {
+            auto tileCoord = m_tilesToBuild.front();
+            m_tilesToBuild.erase(m_tilesToBuild.begin());
+            BuildTile(tileCoord.first, tileCoord.second);
+            builtThisFrame++;
+        }
+    }
+
+    bool HorizonRenderer::IsTileNeeded(int tileX, int tileZ) const
+    {
+        int minChunkX = tileX * TILE_CHUNKS;
+        int minChunkZ = tileZ * TILE_CHUNKS;
+        int maxChunkX = minChunkX + TILE_CHUNKS - 1;
+        int maxChunkZ = minChunkZ + TILE_CHUNKS - 1;
+
+        int centerX = m_centerChunk.first;
+        int centerZ = m_centerChunk.second;
+
+        // Must touch the LOD square...
+        bool touchesLod = maxChunkX >= centerX - m_lodDistance && minChunkX <= centerX + m_lodDistance &&
+                          maxChunkZ >= centerZ - m_lodDistance && minChunkZ <= centerZ + m_lodDistance;
+
+        // ...and not lie entirely inside the full-detail square
+        bool insideRender = minChunkX >= centerX - m_renderDistance && maxChunkX <= centerX + m_renderDistance &&
+                            minChunkZ >= centerZ - m_renderDistance && maxChunkZ <= centerZ + m_renderDistance;
+
+        return touchesLod && !insideRender;
+    }
+
+    void HorizonRenderer::RefreshTiles()
+    {
+        // Drop tiles that left the horizon ring
+        for (auto it = m_tiles.begin(); it != m_tiles.end();)
+        {
+            if (!IsTileNeeded(it->first.first, it->first.second))
+            {
+                DestroyTile(it->second);
+                it = m_tiles.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Queue missing tiles, closest first
+        int minTileX = FloorDiv(m_centerChunk.first - m_lodDistance, TILE_CHUNKS);
+        int maxTileX = FloorDiv(m_centerChunk.first + m_lodDistance, TILE_CHUNKS);
+        int minTileZ = FloorDiv(m_centerChunk.second - m_lodDistance, TILE_CHUNKS);
+        int maxTileZ = FloorDiv(m_centerChunk.second + m_lodDistance, TILE_CHUNKS);
+
+        m_tilesToBuild.clear();
+        for (int tileX = minTileX; tileX <= maxTileX; tileX++)
+        {
+            for (int tileZ = minTileZ; tileZ <= maxTileZ; tileZ++)
+            {
+                if (IsTileNeeded(tileX, tileZ) && m_tiles.find(std::make_pair(tileX, tileZ)) == m_tiles.end())
+                {
+                    m_tilesToBuild.emplace_back(tileX, tileZ);
+                }
+            }
+        }
+
+        // Sort by distance from the center chunk to the tile center (in chunks)
+        float centerX = static_cast<float>(m_centerChunk.first);
+        float centerZ = static_cast<float>(m_centerChunk.second);
+        std::sort(m_tilesToBuild.begin(), m_tilesToBuild.end(),
+            [centerX, centerZ](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                float half = (TILE_CHUNKS - 1) * 0.5f;
+                float distA = std::max(std::abs(a.first * TILE_CHUNKS + half - centerX), std::abs(a.second * TILE_CHUNKS + half - centerZ));
+                float distB = std::max(std::abs(b.first * TILE_CHUNKS + half - centerX), std::abs(b.second * TILE_CHUNKS + half - centerZ));
+                return distA < distB;
+            });
+    }
+
+    void HorizonRenderer::BuildTile(int tileX, int tileZ)
+    {
+        constexpr int SAMPLES = TILE_CELLS + 1;  // +1 so the far edge knows its neighbour's height
+        const int worldStartX = tileX * TILE_CHUNKS * CHUNK_SIZE_X;
+        const int worldStartZ = tileZ * TILE_CHUNKS * CHUNK_SIZE_Z;
+
+        int heights[SAMPLES * SAMPLES];
+        m_terrainGenerator->GenerateHeightmap(worldStartX, worldStartZ, SAMPLES, CELL_SIZE, heights);
+
+        std::vector<HorizonVertex> vertices;
+        std::vector<unsigned int> indices;
+        vertices.reserve(TILE_CELLS * TILE_CELLS * 4 * 2);
+        indices.reserve(TILE_CELLS * TILE_CELLS * 6 * 2);
+
+        auto addQuad = [&vertices, &indices](const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, const glm::vec3& v3, const glm::vec3& color) {
+            unsigned int baseIndex = static_cast<unsigned int>(vertices.size());
+            vertices.push_back({v0, color});
+            vertices.push_back({v1, color});
+            vertices.push_back({v2, color});
+            vertices.push_back({v3, color});
+            indices.push_back(baseIndex + 0);
+            indices.push_back(baseIndex + 1);
+            indices.push_back(baseIndex + 2);
+            indices.push_back(baseIndex + 2);
+            indices.push_back(baseIndex + 3);
+            indices.push_back(baseIndex + 0);
+        };
+
+        auto cellColor = [this](int height) {
+            return ChunkMeshGenerator::GetBlockColor(m_terrainGenerator->GetSurfaceBlockType(height));
+        };
+
+        float minY = static_cast<float>(CHUNK_SIZE_Y);
+        float maxY = 0.0f;
+
+        for (int z = 0; z < TILE_CELLS; z++)
+        {
+            for (int x = 0; x < TILE_CELLS; x++)
+            {
+                int height = heights[z * SAMPLES + x];
+                float top = static_cast<float>(height + 1);
+                float x0 = static_cast<float>(worldStartX + x * CELL_SIZE);
+                float z0 = static_cast<float>(worldStartZ + z * CELL_SIZE);
+                float x1 = x0 + CELL_SIZE;
+                float z1 = z0 + CELL_SIZE;
+
+                minY = std::min(minY, top);
+                maxY = std::max(maxY, top);
+
+                // Top of the cell
+                addQuad(glm::vec3(x0, top, z0), glm::vec3(x0, top, z1), glm::vec3(x1, top, z1), glm::vec3(x1, top, z0), cellColor(height));
+
+                // Walls towards the +X and +Z neighbours where heights differ (the -X / -Z walls
+                // belong to the neighbouring cell, or to the neighbouring tile at the tile edge)
+                int heightX = heights[z * SAMPLES + (x + 1)];
+                if (heightX != height)
+                {
+                    int high = std::max(height, heightX);
+                    float wallTop = static_cast<float>(high + 1);
+                    float wallBottom = static_cast<float>(std::min(height, heightX) + 1);
+                    addQuad(glm::vec3(x1, wallBottom, z0), glm::vec3(x1, wallBottom, z1), glm::vec3(x1, wallTop, z1), glm::vec3(x1, wallTop, z0), cellColor(high) * 0.8f);
+                    minY = std::min(minY, wallBottom);
+                }
+
+                int heightZ = heights[(z + 1) * SAMPLES + x];
+                if (heightZ != height)
+                {
+                    int high = std::max(height, heightZ);
+                    float wallTop = static_cast<float>(high + 1);
+                    float wallBottom = static_cast<float>(std::min(height, heightZ) + 1);
+                    addQuad(glm::vec3(x0, wallBottom, z1), glm::vec3(x1, wallBottom, z1), glm::vec3(x1, wallTop, z1), glm::vec3(x0, wallTop, z1), cellColor(high) * 0.7f);
+                    minY = std::min(minY, wallBottom);
+                }
+            }
+        }
+
+        HorizonTile tile;
+        tile.indexCount = static_cast<GLsizei>(indices.size());
+        tile.boundsMin = glm::vec3(static_cast<float>(worldStartX), minY, static_cast<float>(worldStartZ));
+        tile.boundsMax = glm::vec3(static_cast<float>(worldStartX + TILE_CELLS * CELL_SIZE), maxY,
+                                   static_cast<float>(worldStartZ + TILE_CELLS * CELL_SIZE));
+
+        glGenVertexArrays(1, &tile.VAO);
+        glGenBuffers(1, &tile.VBO);
+        glGenBuffers(1, &tile.EBO);
+
+        glBindVertexArray(tile.VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, tile.VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(HorizonVertex), vertices.data(), GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tile.EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+        // Position attribute
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(HorizonVertex), (void*)offsetof(HorizonVertex, position));
+        glEnableVertexAttribArray(0);
+
+        // Color attribute
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(HorizonVertex), (void*)offsetof(HorizonVertex, color));
+        glEnableVertexAttribArray(1);
+
+        glBindVertexArray(0);
+
+        m_tiles[std::make_pair(tileX, tileZ)] = tile;
+    }
+
+    void HorizonRenderer::DestroyTile(HorizonTile& tile)
+    {
+        if (tile.VAO != 0)
+        {
+            glDeleteVertexArrays(1, &tile.VAO);
+            tile.VAO = 0;
+        }
+        if (tile.VBO != 0)
+        {
+            glDeleteBuffers(1, &tile.VBO);
+            tile.VBO = 0;
+        }
+        if (tile.EBO != 0)
+        {
+            glDeleteBuffers(1, &tile.EBO);
+            tile.EBO = 0;
+        }
+        tile.indexCount = 0;
+    }
+
+    void HorizonRenderer::Render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix)
+    {
+        if (!m_shader || m_tiles.empty())
+        {
+            return;
+        }
+
+        m_frustum.ExtractPlanes(projectionMatrix * viewMatrix);
+
+        m_shader->Use();
+        m_shader->SetMat4("view", viewMatrix);
+        m_shader->SetMat4("projection", projectionMatrix);
+
+        // Skip fragments where full-detail chunks are drawn
+        glm::vec4 innerRegion(
+            static_cast<float>((m_centerChunk.first - m_renderDistance) * CHUNK_SIZE_X),
+            static_cast<float>((m_centerChunk.second - m_renderDistance) * CHUNK_SIZE_Z),
+            static_cast<float>((m_centerChunk.first + m_renderDistance + 1) * CHUNK_SIZE_X),
+            static_cast<float>((m_centerChunk.second + m_renderDistance + 1) * CHUNK_SIZE_Z)
+        );
+        m_shader->SetVec4("innerRegion", innerRegion);
+
+        // Walls are emitted once per cell pair, so they must be visible from both sides
+        glDisable(GL_CULL_FACE);
+
+        for (auto& [coord, tile] : m_tiles)
+        {
+            if (tile.indexCount > 0 && m_frustum.IsAABBVisible(tile.boundsMin, tile.boundsMax))
+            {
+                glBindVertexArray(tile.VAO);
+                glDrawElements(GL_TRIANGLES, tile.indexCount, GL_UNSIGNED_INT, 0);
+            }
+        }
+
+        glBindVertexArray(0);
+        glEnable(GL_CULL_FACE);
+
+        m_shader->Unuse();
+    }
+
+    void HorizonRenderer::Shutdown()
+    {
+        for (auto& [coord, tile] : m_tiles)
+        {
+            DestroyTile(tile);
+        }
+        m_tiles.clear();
+        m_tilesToBuild.clear();
+        m_hasCenter = false;
+        m_shader.reset();
+    }
+}
@@ -0,0 +1,281 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "World/SectionVisibility.h"
+#include "World/BlockType.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+
+namespace MinecraftClone
+{
+    namespace
+    {
+        // Step per face, in the mesh face order: 0=+Z, 1=-Z, 2=-X, 3=+X, 4=+Y, 5=-Y
+        const int FACE_STEPS[SectionVisibility::FACE_COUNT][3] = {
+            { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+        };
+
+        constexpr uint16_t FULL_ROW = 0xFFFF;
+        constexpr int SECTION_CELLS = CHUNK_SIZE_X * CHUNK_SECTION_SIZE * CHUNK_SIZE_Z;
+
+        // m_reached entries: the faces a section has been entered through, plus whether it is reached
+        // at all or was rejected by the filter
+        constexpr uint8_t REACHED_BIT = 1u << 6;
+        constexpr uint8_t REJECTED_BIT = 1u << 7;
+
+        bool IsOpaqueLayer(const SectionVisibility* column, int y)
+        {
+            return (column[y / CHUNK_SECTION_SIZE].GetOpaqueLayers() >> (y % CHUNK_SECTION_SIZE) & 1u) != 0;
+        }
+
+        // Section faces a cell lies on
+        inline uint8_t GetCellFaces(int x, int y, int z)
+        {
+            uint8_t faces = 0;
+            faces |= (z == CHUNK_SIZE_Z - 1) ? 1u << 0 : 0u;
+            faces |= (z == 0) ? 1u << 1 : 0u;
+            faces |= (x == 0) ? 1u << 2 : 0u;
+            faces |= (x == CHUNK_SIZE_X - 1) ? 1u << 3 : 0u;
+            faces |= (y == CHUNK_SECTION_SIZE - 1) ? 1u << 4 : 0u;
+            faces |= (y == 0) ? 1u << 5 : 0u;
+            return faces;
+        }
+    }
+
+    void SectionVisibility::ConnectFaces(uint8_t faceMask)
+    {
+        for (int face = 0; face < FACE_COUNT; face++)
+        {
+            if (faceMask >> face & 1u)
+            {
+                m_connections |= static_cast<uint64_t>(faceMask & 0x3Fu) << (face * FACE_COUNT);
+            }
+        }
+    }
+
+    SectionVisibility SectionVisibility::Compute(const ChunkMeshInput& input, int section)
+    {
+        const int yBegin = section * CHUNK_SECTION_SIZE;
+        if (yBegin >= input.GetTopY())
+        {
+            return SectionVisibility();  // Nothing but air
+        }
+
+        // Open cells as 16-bit X rows, [y][z]
+        const OccluderTable occluder;
+        uint16_t open[CHUNK_SECTION_SIZE][CHUNK_SIZE_Z];
+        int openCount = 0;
+        uint16_t opaqueLayers = 0;
+        for (int y = 0; y < CHUNK_SECTION_SIZE; y++)
+        {
+            uint16_t layerOpen = 0;
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                const BlockType* row = input.GetData() + ChunkMeshInput::Index(0, yBegin + y, z);
+                uint16_t bits = 0;
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
+                {
+                    bits |= occluder(row[x]) ? 0u : static_cast<uint16_t>(1u << x);
+                }
+                open[y][z] = bits;
+                openCount += static_cast<int>(std::bitset<CHUNK_SIZE_X>(bits).count());
+                layerOpen |= bits;
+            }
+            opaqueLayers |= (layerOpen == 0) ? static_cast<uint16_t>(1u << y) : 0u;
+        }
+
+        if (openCount == 0)
+        {
+            return Closed();
+        }
+        if (openCount == SECTION_CELLS)
+        {
+            return SectionVisibility();
+        }
+
+        // Fill each pocket from an unvisited open cell on the boundary (interior pockets touch no face)
+        // and connect every face it touches. open doubles as the unvisited set.
+        SectionVisibility visibility(0, opaqueLayers);
+        std::array<uint16_t, SECTION_CELLS> stack;
+        for (int y = 0; y < CHUNK_SECTION_SIZE; y++)
+        {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++)
+            {
+                const bool boundaryRow = (y == 0 || y == CHUNK_SECTION_SIZE - 1 || z == 0 || z == CHUNK_SIZE_Z - 1);
+                const uint16_t seeds = open[y][z] & (boundaryRow ? FULL_ROW : static_cast<uint16_t>(0x8001u));
+                for (int x = 0; x < CHUNK_SIZE_X; x++)
+                {
+                    if ((seeds >> x & 1u) == 0 || (open[y][z] >> x & 1u) == 0)
+                    {
+                        continue;
+                    }
+
+                    uint8_t faces = 0;
+                    size_t top = 0;
+                    open[y][z] &= static_cast<uint16_t>(~(1u << x));
+                    stack[top++] = static_cast<uint16_t>((y << 8) | (z << 4) | x);
+                    while (top > 0)
+                    {
+                        const uint16_t cell = stack[--top];
+                        const int cx = cell & 15;
+                        const int cz = (cell >> 4) & 15;
+                        const int cy = cell >> 8;
+                        faces |= GetCellFaces(cx, cy, cz);
+
+                        for (const auto& step : FACE_STEPS)
+                        {
+                            const int nx = cx + step[0];
+                            const int ny = cy + step[1];
+                            const int nz = cz + step[2];
+                            if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SECTION_SIZE || nz < 0 || nz >= CHUNK_SIZE_Z)
+                            {
+                                continue;
+                            }
+                            if (open[ny][nz] >> nx & 1u)
+                            {
+                                open[ny][nz] &= static_cast<uint16_t>(~(1u << nx));
+                                stack[top++] = static_cast<uint16_t>((ny << 8) | (nz << 4) | nx);
+                            }
+                        }
+                    }
+
+                    visibility.ConnectFaces(faces);
+                    if (visibility.IsOpen())
+                    {
+                        return visibility;
+                    }
+                }
+            }
+        }
+        return visibility;
+    }
+
+    void GetChunkOccluders(int chunkX, int chunkZ, const SectionVisibility* column, std::vector<OccluderBox>& boxes)
+    {
+        const glm::vec3 chunkMin(static_cast<float>(chunkX * CHUNK_SIZE_X), 0.0f, static_cast<float>(chunkZ * CHUNK_SIZE_Z));
+        int runStart = -1;
+        for (int y = 0; y <= CHUNK_SIZE_Y; y++)
+        {
+            const bool opaque = y < CHUNK_SIZE_Y && IsOpaqueLayer(column, y);
+            if (opaque && runStart < 0)
+            {
+                runStart = y;
+            }
+            else if (!opaque && runStart >= 0)
+            {
+                boxes.push_back({ chunkMin + glm::vec3(0.0f, static_cast<float>(runStart), 0.0f),
+                                  chunkMin + glm::vec3(CHUNK_SIZE_X, static_cast<float>(y), CHUNK_SIZE_Z) });
+                runStart = -1;
+            }
+        }
+    }
+
+    bool SectionVisibilityGraph::Traverse(const glm::vec3& cameraPosition, int radius, const VisibilityLookup& lookup,
+                                          const SectionFilter& filter)
+    {
+        m_reachableCount = 0;
+        m_queue.clear();
+        m_centreX = static_cast<int>(std::floor(cameraPosition.x / CHUNK_SIZE_X));
+        m_centreZ = static_cast<int>(std::floor(cameraPosition.z / CHUNK_SIZE_Z));
+        const int cameraSection = static_cast<int>(std::floor(cameraPosition.y / CHUNK_SECTION_SIZE));
+        if (cameraSection < 0 || cameraSection >= CHUNK_SECTION_COUNT)
+        {
+            m_radius = -1;
+            return false;
+        }
+
+        m_radius = std::max(radius, 0);
+        const size_t width = static_cast<size_t>(2 * m_radius + 1);
+        m_reached.assign(width * width * CHUNK_SECTION_COUNT, 0);
+
+        // The camera's own section is always in sight, whatever its contents
+        m_reached[Index(m_centreX, cameraSection, m_centreZ)] = REACHED_BIT;
+        m_reachableCount = 1;
+        m_queue.push_back({ m_centreX, m_centreZ, cameraSection, -1, 0 });
+
+        // A section is expanded again for each new face it is entered through: a later path may leave
+        // through faces the first one could not reach
+        for (size_t head = 0; head < m_queue.size(); head++)
+        {
+            const Step step = m_queue[head];
+            uint8_t exits = 0x3F;
+            if (step.entryFace >= 0)
+            {
+                const SectionVisibility* visibility = lookup(step.chunkX, step.section, step.chunkZ);
+                exits = visibility ? visibility->GetConnectedFaces(step.entryFace) : exits;
+            }
+
+            for (int face = 0; face < SectionVisibility::FACE_COUNT; face++)
+            {
+                const int opposite = face ^ 1;
+                if ((exits >> face & 1u) == 0 || (step.directions >> opposite & 1u) != 0)
+                {
+                    continue;
+                }
+
+                const int chunkX = step.chunkX + FACE_STEPS[face][0];
+                const int section = step.section + FACE_STEPS[face][1];
+                const int chunkZ = step.chunkZ + FACE_STEPS[face][2];
+                const int index = Index(chunkX, section, chunkZ);
+                if (index < 0)
+                {
+                    continue;
+                }
+
+                uint8_t& reached = m_reached[index];
+                const uint8_t entryBit = static_cast<uint8_t>(1u << opposite);
+                if ((reached & (REJECTED_BIT | entryBit)) != 0)
+                {
+                    continue;
+                }
+                if ((reached & REACHED_BIT) == 0)
+                {
+                    if (!filter(chunkX, section, chunkZ))
+                    {
+                        reached = REJECTED_BIT;
+                        continue;
+                    }
+                    reached |= REACHED_BIT;
+                    m_reachableCount++;
+                }
+                reached |= entryBit;
+                m_queue.push_back({ chunkX, chunkZ, section, opposite, static_cast<uint8_t>(step.directions | (1u << face)) });
+            }
+        }
+        return true;
+    }
+
+    bool SectionVisibilityGraph::IsReachable(int chunkX, int section, int chunkZ) const
+    {
+        const int index = Index(chunkX, section, chunkZ);
+        return index >= 0 && (m_reached[index] & REACHED_BIT) != 0;
+    }
+
+    bool SectionVisibilityGraph::IsChunkReachable(int chunkX, int chunkZ) const
+    {
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+        {
+            if (IsReachable(chunkX, section, chunkZ))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int SectionVisibilityGraph::Index(int chunkX, int section, int chunkZ) const
+    {
+        const int dx = chunkX - m_centreX;
+        const int dz = chunkZ - m_centreZ;
+        if (m_radius < 0 || dx < -m_radius || dx > m_radius || dz < -m_radius || dz > m_radius ||
+            section < 0 || section >= CHUNK_SECTION_COUNT)
+        {
+            return -1;
+        }
+        const int width = 2 * m_radius + 1;
+        return ((dz + m_radius) * width + (dx + m_radius)) * CHUNK_SECTION_COUNT + section;
+    }
+}
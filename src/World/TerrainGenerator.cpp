@@ -5,6 +5,12 @@
 #include "World/TerrainGenerator.h"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRAIN_FILL_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace MinecraftClone
 {
@@ -14,6 +20,7 @@ namespace MinecraftClone
         , m_baseHeight(70)
         , m_heightVariation(30)
         , m_initialized(false)
+        , m_vectorizedFill(true)
     {
     }
 
@@ -124,9 +131,9 @@ namespace MinecraftClone
         }
     }
 
-    void TerrainGenerator::GenerateChunk(Chunk* chunk, int chunkX, int chunkZ, World* /*world*/)
+    void TerrainGenerator::GenerateHeightmap(int worldX, int worldZ, int size, int step, int* heights)
     {
-        if (!chunk)
+        if (!heights || size <= 0 || step <= 0)
         {
             return;
         }
@@ -136,42 +143,83 @@ namespace MinecraftClone
             Initialize();
         }
 
-        // Generate height map for this chunk (need +1 for edges)
-        constexpr int HEIGHTMAP_SIZE = CHUNK_SIZE_X + 1;
-        std::vector<float> heightMap(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE);
-
-        // Calculate world coordinates for this chunk
-        int worldStartX = chunkX * CHUNK_SIZE_X;
-        int worldStartZ = chunkZ * CHUNK_SIZE_Z;
-
         // OPTIMIZATION 1: Batch noise generation using GenUniformGrid2D
-        // Generate entire heightmap in 2 calls instead of 289 individual calls
-        std::vector<float> heightNoiseData(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE);
-        std::vector<float> detailNoiseData(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE);
+        // Generate entire heightmap in 2 calls instead of size * size individual calls.
+        // Sample i lies at (start + i) * frequency, so a coarser step scales both start and frequency.
+        std::vector<float> heightNoiseData(size * size);
+        std::vector<float> detailNoiseData(size * size);
 
         // Generate height noise (frequency 0.01)
         m_heightNoise->GenUniformGrid2D(
             heightNoiseData.data(),
-            worldStartX, worldStartZ,
-            HEIGHTMAP_SIZE, HEIGHTMAP_SIZE,
-            0.01f, m_seed
+            worldX / step, worldZ / step,
+            size, size,
+            0.01f * static_cast<float>(step), m_seed
         );
 
         // Generate detail noise (frequency 0.05)
         m_detailNoise->GenUniformGrid2D(
             detailNoiseData.data(),
-            worldStartX, worldStartZ,
-            HEIGHTMAP_SIZE, HEIGHTMAP_SIZE,
-            0.05f, m_seed + 1000
+            worldX / step, worldZ / step,
+            size, size,
+            0.05f * static_cast<float>(step), m_seed + 1000
         );
 
         // Combine noises to create heightmap
-        for (int i = 0; i < HEIGHTMAP_SIZE * HEIGHTMAP_SIZE; i++)
+        for (int i = 0; i < size * size; i++)
         {
             float combinedNoise = heightNoiseData[i] + (detailNoiseData[i] * 0.3f);
             int height = m_baseHeight + static_cast<int>(combinedNoise * m_heightVariation);
             height = std::max(m_seaLevel - 10, std::min(height, 200));
-            heightMap[i] = static_cast<float>(height);
+            heights[i] = height;
+        }
+    }
+
+    void TerrainGenerator::GenerateChunk(Chunk* chunk, int chunkX, int chunkZ, World* /*world*/)
+    {
+        if (!chunk)
+        {
+            return;
+        }
+
+        if (!m_initialized)
+        {
+            Initialize();
+        }
+
+        // Generate height map for this chunk (need +1 for edges)
+        constexpr int HEIGHTMAP_SIZE = CHUNK_SIZE_X + 1;
+        int heightSamples[HEIGHTMAP_SIZE * HEIGHTMAP_SIZE];
+        GenerateHeightmap(chunkX * CHUNK_SIZE_X, chunkZ * CHUNK_SIZE_Z, HEIGHTMAP_SIZE, 1, heightSamples);
+
+        FillChunk(chunk, heightSamples);
+    }
+
+    void TerrainGenerator::FillChunk(Chunk* chunk, const int* heightSamples)
+    {
+        if (!chunk || !heightSamples)
+        {
+            return;
+        }
+
+        if (m_vectorizedFill)
+        {
+            FillChunkVectorized(chunk, heightSamples);
+        }
+        else
+        {
+            FillChunkScalar(chunk, heightSamples);
+        }
+    }
+
+    void TerrainGenerator::FillChunkScalar(Chunk* chunk, const int* heightSamples)
+    {
+        constexpr int HEIGHTMAP_SIZE = CHUNK_SIZE_X + 1;
+
+        std::vector<float> heightMap(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE);
+        for (int i = 0; i < HEIGHTMAP_SIZE * HEIGHTMAP_SIZE; i++)
+        {
+            heightMap[i] = static_cast<float>(heightSamples[i]);
         }
 
         // OPTIMIZATION 2: Optimize terrain filling
@@ -238,4 +286,197 @@ namespace MinecraftClone
             }
         }
     }
+
+    void TerrainGenerator::FillChunkVectorized(Chunk* chunk, const int* heightSamples)
+    {
+        // OPTIMIZATION 3: Column boundaries + dense section fill
+        // Per-column heights and surface types are computed for all 256 columns at once, then each
+        // 16x16x16 section is materialized layer by layer with compares/selects against Y into a
+        // dense type buffer and handed to the chunk in one bulk copy. Sections above the highest
+        // column stay air, sections entirely below the lowest dirt layer are filled with stone.
+        // Produces exactly the same blocks as FillChunkScalar.
+        constexpr int HEIGHTMAP_SIZE = CHUNK_SIZE_X + 1;
+        constexpr int COLUMNS = CHUNK_SIZE_X * CHUNK_SIZE_Z;
+
+        alignas(16) int16_t heights[COLUMNS];       // Column height, -1 for empty columns
+        alignas(16) int16_t surfaceTypes[COLUMNS];  // Block type placed at y == height
+        alignas(16) BlockType sectionTypes[CHUNK_SECTION_VOLUME];
+
+        const int16_t seaLevel = static_cast<int16_t>(std::max(-30000, std::min(m_seaLevel, 30000)));
+        int minHeight = CHUNK_SIZE_Y;
+        int maxHeight = -1;
+
+#ifdef TERRAIN_FILL_SSE2
+        const __m128i minusOne = _mm_set1_epi16(-1);
+        const __m128i seaVec = _mm_set1_epi16(seaLevel);
+        const __m128i seaPlusTwo = _mm_set1_epi16(static_cast<int16_t>(seaLevel + 2));
+        const __m128i grassVec = _mm_set1_epi16(static_cast<int16_t>(BlockType::Grass));
+        const __m128i sandVec = _mm_set1_epi16(static_cast<int16_t>(BlockType::Sand));
+        const __m128i gravelVec = _mm_set1_epi16(static_cast<int16_t>(BlockType::Gravel));
+
+        auto averageFour = [&heightSamples](int base) {
+            // Average of the four surrounding samples, truncated toward zero like the scalar path
+            __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(heightSamples + base));
+            __m128i h2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(heightSamples + base + 1));
+            __m128i h3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(heightSamples + base + HEIGHTMAP_SIZE));
+            __m128i h4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(heightSamples + base + HEIGHTMAP_SIZE + 1));
+            __m128i sum = _mm_add_epi32(_mm_add_epi32(h1, h2), _mm_add_epi32(h3, h4));
+            __m128i bias = _mm_and_si128(_mm_srai_epi32(sum, 31), _mm_set1_epi32(3));
+            return _mm_srai_epi32(_mm_add_epi32(sum, bias), 2);
+        };
+
+        __m128i minVec = _mm_set1_epi16(static_cast<int16_t>(CHUNK_SIZE_Y));
+        __m128i maxVec = minusOne;
+
+        for (int z = 0; z < CHUNK_SIZE_Z; z++)
+        {
+            for (int x = 0; x < CHUNK_SIZE_X; x += 8)
+            {
+                int base = z * HEIGHTMAP_SIZE + x;
+                __m128i height = _mm_packs_epi32(averageFour(base), averageFour(base + 4));
+
+                // Columns with height <= 0 get no blocks at all
+                __m128i empty = _mm_cmpgt_epi16(_mm_set1_epi16(1), height);
+                height = _mm_or_si128(_mm_andnot_si128(empty, height), _mm_and_si128(empty, minusOne));
+
+                __m128i isGrass = _mm_cmpgt_epi16(height, seaPlusTwo);
+                __m128i isSand = _mm_andnot_si128(isGrass, _mm_cmpgt_epi16(height, seaVec));
+                __m128i surface = gravelVec;
+                surface = _mm_or_si128(_mm_andnot_si128(isSand, surface), _mm_and_si128(isSand, sandVec));
+                surface = _mm_or_si128(_mm_andnot_si128(isGrass, surface), _mm_and_si128(isGrass, grassVec));
+
+                int column = z * CHUNK_SIZE_X + x;
+                _mm_store_si128(reinterpret_cast<__m128i*>(heights + column), height);
+                _mm_store_si128(reinterpret_cast<__m128i*>(surfaceTypes + column), surface);
+
+                // Empty columns count as -1 for both bounds
+                minVec = _mm_min_epi16(minVec, height);
+                maxVec = _mm_max_epi16(maxVec, height);
+            }
+        }
+
+        alignas(16) int16_t minLanes[8];
+        alignas(16) int16_t maxLanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(minLanes), minVec);
+        _mm_store_si128(reinterpret_cast<__m128i*>(maxLanes), maxVec);
+        for (int i = 0; i < 8; i++)
+        {
+            minHeight = std::min(minHeight, static_cast<int>(minLanes[i]));
+            maxHeight = std::max(maxHeight, static_cast<int>(maxLanes[i]));
+        }
+#else
+        for (int z = 0; z < CHUNK_SIZE_Z; z++)
+        {
+            for (int x = 0; x < CHUNK_SIZE_X; x++)
+            {
+                int base = z * HEIGHTMAP_SIZE + x;
+                int sum = heightSamples[base] + heightSamples[base + 1] +
+                          heightSamples[base + HEIGHTMAP_SIZE] + heightSamples[base + HEIGHTMAP_SIZE + 1];
+                int height = std::max(-32768, std::min(sum / 4, 32767));
+                if (height <= 0)
+                {
+                    height = -1;
+                }
+
+                BlockType surface = BlockType::Gravel;
+                if (height > seaLevel + 2)
+                {
+                    surface = BlockType::Grass;
+                }
+                else if (height > seaLevel)
+                {
+                    surface = BlockType::Sand;
+                }
+
+                int column = z * CHUNK_SIZE_X + x;
+                heights[column] = static_cast<int16_t>(height);
+                surfaceTypes[column] = static_cast<int16_t>(surface);
+                minHeight = std::min(minHeight, height);
+                maxHeight = std::max(maxHeight, height);
+            }
+        }
+#endif
+
+        for (int section = 0; section < CHUNK_SECTION_COUNT; section++)
+        {
+            const int sectionBaseY = section * CHUNK_SECTION_SIZE;
+            if (sectionBaseY > maxHeight)
+            {
+                break;  // Everything above is air, which a fresh chunk already holds
+            }
+
+            // Whole section below every column's dirt layer (bedrock only lives in section 0)
+            if (section > 0 && sectionBaseY + CHUNK_SECTION_SIZE - 1 <= minHeight - 3)
+            {
+                chunk->FillSection(section, BlockType::Stone);
+                continue;
+            }
+
+            for (int localY = 0; localY < CHUNK_SECTION_SIZE; localY++)
+            {
+                const int y = sectionBaseY + localY;
+                BlockType* layer = sectionTypes + localY * COLUMNS;
+
+#ifdef TERRAIN_FILL_SSE2
+                const __m128i yVec = _mm_set1_epi16(static_cast<int16_t>(y));
+                const __m128i three = _mm_set1_epi16(3);
+                const __m128i stoneVec = _mm_set1_epi16(static_cast<int16_t>(BlockType::Stone));
+                const __m128i dirtVec = _mm_set1_epi16(static_cast<int16_t>(BlockType::Dirt));
+                const __m128i bedrockVec = _mm_set1_epi16(static_cast<int16_t>(BlockType::Bedrock));
+                const __m128i nine = _mm_set1_epi16(9);
+
+                auto selectTypes = [&](int column) {
+                    __m128i height = _mm_load_si128(reinterpret_cast<const __m128i*>(heights + column));
+                    __m128i surface = _mm_load_si128(reinterpret_cast<const __m128i*>(surfaceTypes + column));
+
+                    __m128i isAir = _mm_cmpgt_epi16(yVec, height);
+                    __m128i isSurface = _mm_cmpeq_epi16(yVec, height);
+                    __m128i isDirt = _mm_cmpgt_epi16(yVec, _mm_sub_epi16(height, three));
+
+                    __m128i type = stoneVec;
+                    type = _mm_or_si128(_mm_andnot_si128(isDirt, type), _mm_and_si128(isDirt, dirtVec));
+                    type = _mm_or_si128(_mm_andnot_si128(isSurface, type), _mm_and_si128(isSurface, surface));
+                    if (y == 0)
+                    {
+                        // Bedrock at the bottom of columns tall enough to have a deep stone layer
+                        __m128i isBedrock = _mm_cmpgt_epi16(height, nine);
+                        type = _mm_or_si128(_mm_andnot_si128(isBedrock, type), _mm_and_si128(isBedrock, bedrockVec));
+                    }
+                    return _mm_andnot_si128(isAir, type);
+                };
+
+                for (int column = 0; column < COLUMNS; column += 16)
+                {
+                    __m128i packed = _mm_packus_epi16(selectTypes(column), selectTypes(column + 8));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(layer + column), packed);
+                }
+#else
+                for (int column = 0; column < COLUMNS; column++)
+                {
+                    int height = heights[column];
+                    BlockType type = BlockType::Stone;
+                    if (y > height)
+                    {
+                        type = BlockType::Air;
+                    }
+                    else if (y == height)
+                    {
+                        type = static_cast<BlockType>(surfaceTypes[column]);
+                    }
+                    else if (y > height - 3)
+                    {
+                        type = BlockType::Dirt;
+                    }
+                    else if (y == 0 && height > 9)
+                    {
+                        type = BlockType::Bedrock;
+                    }
+                    layer[column] = type;
+                }
+#endif
+            }
+
+            chunk->SetSectionTypes(section, sectionTypes);
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#include "World/WorldStorage.h"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <zlib.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+namespace MinecraftClone
+{
+    namespace
+    {
+        constexpr char CHUNK_MAGIC[4] = { 'M', 'C', 'C', 'K' };
+
+        struct ChunkFileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            int32_t chunkX;
+            int32_t chunkZ;
+            uint32_t uncompressedSize;
+            uint32_t compressedSize;
+        };
+
+        // Block data is stored as three planes (types, block light, sky light), which compresses
+        // far better than interleaved Block structs
+        constexpr size_t CHUNK_DATA_SIZE = static_cast<size_t>(CHUNK_VOLUME) * 3;
+    }
+
+    WorldStorage::WorldStorage() : m_isOpen(false)
+    {
+    }
+
+    bool WorldStorage::Open(const std::string& directory, bool create)
+    {
+        std::error_code error;
+        if (!create && !std::filesystem::is_directory(directory, error))
+        {
+            m_isOpen = false;
+            return false;
+        }
+
+        std::filesystem::create_directories(std::filesystem::path(directory) / "chunks", error);
+        if (error)
+        {
+            spdlog::error("WorldStorage: failed to create world directory {}: {}", directory, error.message());
+            m_isOpen = false;
+            return false;
+        }
+
+        m_directory = directory;
+        m_isOpen = true;
+        return true;
+    }
+
+    bool WorldStorage::SaveMetadata(int seed, bool skyLight)
+    {
+        if (!m_isOpen)
+        {
+            return false;
+        }
+
+        nlohmann::json metadata;
+        metadata["version"] = FORMAT_VERSION;
+        metadata["seed"] = seed;
+        metadata["skyLight"] = skyLight;
+        metadata["chunkSizeX"] = CHUNK_SIZE_X;
+        metadata["chunkSizeY"] = CHUNK_SIZE_Y;
+        metadata["chunkSizeZ"] = CHUNK_SIZE_Z;
+
+        std::ofstream file(std::filesystem::path(m_directory) / "world.json");
+        if (!file)
+        {
+            spdlog::error("WorldStorage: failed to write metadata in {}", m_directory);
+            return false;
+        }
+        file << metadata.dump(4);
+        return true;
+    }
+
+    bool WorldStorage::LoadMetadata(int& seed, bool& skyLight) const
+    {
+        if (!m_isOpen)
+        {
+            return false;
+        }
+
+        std::ifstream file(std::filesystem::path(m_directory) / "world.json");
+        if (!file)
+        {
+            return false;
+        }
+
+        nlohmann::json metadata = nlohmann::json::parse(file, nullptr, false);
+        if (metadata.is_discarded() || !metadata.contains("seed"))
+        {
+            spdlog::warn("WorldStorage: invalid metadata in {}", m_directory);
+            return false;
+        }
+
+        if (metadata.value("version", 0u) != FORMAT_VERSION)
+        {
+            spdlog::warn("WorldStorage: unsupported world version in {}", m_directory);
+            return false;
+        }
+
+        seed = metadata["seed"].get<int>();
+        skyLight = metadata.value("skyLight", false);
+        return true;
+    }
+
+    bool WorldStorage::HasMetadata() const
+    {
+        if (!m_isOpen)
+        {
+            return false;
+        }
+
+        std::error_code error;
+        return std::filesystem::exists(std::filesystem::path(m_directory) / "world.json", error);
+    }
+
+    std::string WorldStorage::GetChunkPath(int chunkX, int chunkZ) const
+    {
+        return (std::filesystem::path(m_directory) / "chunks" /
+                ("c." + std::to_string(chunkX) + "." + std::to_string(chunkZ) + ".dat")).string();
+    }
+
+    bool WorldStorage::HasChunk(int chunkX, int chunkZ) const
+    {
+        if (!m_isOpen)
+        {
+            return false;
+        }
+
+        std::error_code error;
+        return std::filesystem::exists(GetChunkPath(chunkX, chunkZ), error);
+    }
+
+    bool WorldStorage::SaveChunk(const Chunk& chunk) const
+    {
+        if (!m_isOpen)
+        {
+            return false;
+        }
+
+        // Pack blocks into planes
+        std::vector<uint8_t> raw(CHUNK_DATA_SIZE);
+        const Block* blocks = chunk.GetBlockData();
+        for (int i = 0; i < CHUNK_VOLUME; i++)
+        {
+            raw[i] = static_cast<uint8_t>(blocks[i].GetType());
+            raw[CHUNK_VOLUME + i] = blocks[i].GetLightLevel();
+            raw[CHUNK_VOLUME * 2 + i] = blocks[i].GetSkyLight();
+        }
+
+        uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+        std::vector<uint8_t> compressed(compressedSize);
+        if (compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size()), Z_DEFAULT_COMPRESSION) != Z_OK)
+        {
+            spdlog::error("WorldStorage: failed to compress chunk ({}, {})", chunk.GetChunkX(), chunk.GetChunkZ());
+            return false;
+        }
+
+        ChunkFileHeader header;
+        std::memcpy(header.magic, CHUNK_MAGIC, sizeof(header.magic));
+        header.version = FORMAT_VERSION;
+        header.chunkX = chunk.GetChunkX();
+        header.chunkZ = chunk.GetChunkZ();
+        header.uncompressedSize = static_cast<uint32_t>(raw.size());
+        header.compressedSize = static_cast<uint32_t>(compressedSize);
+
+        // Write to a temporary file and rename, so a chunk file is never half-written
+        std::string path = GetChunkPath(chunk.GetChunkX(), chunk.GetChunkZ());
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                spdlog::error("WorldStorage: failed to open {} for writing", tempPath);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressedSize));
+            if (!file)
+            {
+                spdlog::error("WorldStorage: failed to write {}", tempPath);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            spdlog::error("WorldStorage: failed to move {} into place: {}", tempPath, error.message());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool WorldStorage::LoadChunk(Chunk& chunk, int chunkX, int chunkZ) const
+    {
+        if (!m_isOpen)
+        {
+            return false;
+        }
+
+        std::ifstream file(GetChunkPath(chunkX, chunkZ), std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        ChunkFileHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || std::memcmp(header.magic, CHUNK_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != FORMAT_VERSION || header.chunkX != chunkX || header.chunkZ != chunkZ ||
+            header.uncompressedSize != CHUNK_DATA_SIZE)
+        {
+            spdlog::warn("WorldStorage: corrupt or incompatible chunk file for ({}, {})", chunkX, chunkZ);
+            return false;
+        }
+
+        std::vector<uint8_t> compressed(header.compressedSize);
+        file.read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+        if (!file)
+        {
+            spdlog::warn("WorldStorage: truncated chunk file for ({}, {})", chunkX, chunkZ);
+            return false;
+        }
+
+        std::vector<uint8_t> raw(CHUNK_DATA_SIZE);
+        uLongf rawSize = static_cast<uLongf>(raw.size());
+        if (uncompress(raw.data(), &rawSize, compressed.data(), static_cast<uLong>(compressed.size())) != Z_OK ||
+            rawSize != raw.size())
+        {
+            spdlog::warn("WorldStorage: failed to decompress chunk ({}, {})", chunkX, chunkZ);
+            return false;
+        }
+
+        Block* blocks = chunk.GetBlockData();
+        for (int i = 0; i < CHUNK_VOLUME; i++)
+        {
+            uint8_t type = raw[i];
+            if (type >= static_cast<uint8_t>(BlockType::Count))
+            {
+                type = static_cast<uint8_t>(BlockType::Air);
+            }
+            blocks[i].SetType(static_cast<BlockType>(type));
+            blocks[i].SetLightLevel(raw[CHUNK_VOLUME + i]);
+            blocks[i].SetSkyLight(raw[CHUNK_VOLUME * 2 + i]);
+        }
+
+        chunk.SetChunkPosition(chunkX, chunkZ);  // Also flags the chunk for a mesh update
+        return true;
+    }
+}
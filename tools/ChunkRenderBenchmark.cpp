@@ -0,0 +1,195 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Offscreen CPU cost of ChunkRenderer::RenderChunks.
+// Generates and meshes a square of terrain chunks, then renders it into a 1280x720 framebuffer from a
+// camera turning on the spot above the centre, timing the RenderChunks call of every frame (culling,
+// sorting, state and draw submission; the GPU is only waited for outside the timed region).
+// Needs the block atlas, so run it from the repository root:
+//
+//   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./ChunkRenderBenchmark [--distance R] [--frames N]
+
+#include "OffscreenContext.h"
+#include "World/ChunkRenderer.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        int seed = 12345;
+        int renderDistance = 8;   // Chunks in every direction from the centre chunk
+        int frames = 240;
+    };
+
+    constexpr int WIDTH = 1280;
+    constexpr int HEIGHT = 720;
+    constexpr int WARMUP_FRAMES = 10;
+
+    double Percentile(std::vector<double> values, double fraction)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size()));
+        return values[std::min(index, values.size() - 1)];
+    }
+
+    bool ParseArguments(int argc, char** argv, BenchmarkOptions& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            bool hasValue = (i + 1 < argc);
+            if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            {
+                options.seed = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(argv[i], "--distance") == 0 && hasValue)
+            {
+                options.renderDistance = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            {
+                options.frames = std::max(1, std::atoi(argv[++i]));
+            }
+            else
+            {
+                spdlog::error("Usage: {} [--seed S] [--distance R] [--frames N]", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    spdlog::set_pattern("%v");
+
+    BenchmarkOptions options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        return 2;
+    }
+
+    OffscreenContext context;
+    if (!context.Create(WIDTH, HEIGHT))
+    {
+        return 2;
+    }
+
+    // Keep registry / generator / renderer setup logs out of the report
+    spdlog::set_level(spdlog::level::warn);
+    BlockRegistry::Initialize();
+    TerrainGenerator generator;
+    generator.Initialize(options.seed);
+
+    // One extra ring so every rendered chunk has its neighbours
+    const int distance = options.renderDistance;
+    World world;
+    for (int chunkZ = -distance - 1; chunkZ <= distance + 1; chunkZ++)
+    {
+        for (int chunkX = -distance - 1; chunkX <= distance + 1; chunkX++)
+        {
+            generator.GenerateChunk(world.GetOrCreateChunk(chunkX, chunkZ), chunkX, chunkZ, &world);
+        }
+    }
+
+    ChunkRenderer renderer;
+    if (!renderer.Initialize())
+    {
+        spdlog::error("Failed to initialize the chunk renderer (run from the repository root so the atlas is found)");
+        return 2;
+    }
+    renderer.SetChunkWindow(0, 0, distance);
+    for (int chunkZ = -distance; chunkZ <= distance; chunkZ++)
+    {
+        for (int chunkX = -distance; chunkX <= distance; chunkX++)
+        {
+            renderer.UpdateChunk(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ, &world);
+        }
+    }
+
+    // The application's state
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    glFrontFace(GL_CCW);
+
+    int surface = CHUNK_SIZE_Y - 1;
+    while (surface > 0 && world.GetBlock(8, surface, 8).IsAir())
+    {
+        surface--;
+    }
+    const glm::vec3 eye(8.5f, static_cast<float>(surface) + 24.0f, 8.5f);
+    const glm::mat4 projection = glm::perspective(glm::radians(70.0f), static_cast<float>(WIDTH) / HEIGHT, 0.1f, 1000.0f);
+
+    std::vector<double> renderMs;
+    double frameMsTotal = 0.0;
+    double cullMsTotal = 0.0;
+    double submitMsTotal = 0.0;
+    double occlusionMsTotal = 0.0;
+    for (int frame = -WARMUP_FRAMES; frame < options.frames; frame++)
+    {
+        const float yaw = glm::two_pi<float>() * static_cast<float>(frame) / static_cast<float>(options.frames);
+        const glm::vec3 forward(std::cos(yaw), -0.3f, std::sin(yaw));
+        const glm::mat4 view = glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        auto frameStart = std::chrono::steady_clock::now();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        auto renderStart = std::chrono::steady_clock::now();
+        renderer.RenderChunks(view, projection);
+        auto renderEnd = std::chrono::steady_clock::now();
+        glFinish();
+        auto frameEnd = std::chrono::steady_clock::now();
+
+        if (frame >= 0)
+        {
+            renderMs.push_back(std::chrono::duration<double, std::milli>(renderEnd - renderStart).count());
+            frameMsTotal += std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+            cullMsTotal += renderer.GetLastRenderTimings().cullMs;
+            submitMsTotal += renderer.GetLastRenderTimings().submitMs;
+            occlusionMsTotal += renderer.GetLastRenderTimings().occlusionMs;
+        }
+    }
+
+    const bool failed = glGetError() != GL_NO_ERROR;
+    spdlog::set_level(spdlog::level::info);
+    if (failed)
+    {
+        spdlog::error("OpenGL reported an error");
+        return 1;
+    }
+
+    double renderMsTotal = 0.0;
+    for (double ms : renderMs)
+    {
+        renderMsTotal += ms;
+    }
+    const double frames = static_cast<double>(renderMs.size());
+    spdlog::info("Chunk render benchmark: render distance {} ({} chunks, {} section meshes, {} faces), {} frames at {}x{}",
+                 distance, renderer.GetChunkCount(), renderer.GetMeshCount(), renderer.GetTotalFaceCount(), renderMs.size(),
+                 WIDTH, HEIGHT);
+    spdlog::info("RenderChunks CPU: mean={:.3f} ms  p50={:.3f} ms  p99={:.3f} ms   (frame including GPU: {:.2f} ms)",
+                 renderMsTotal / frames, Percentile(renderMs, 0.50), Percentile(renderMs, 0.99), frameMsTotal / frames);
+    spdlog::info("  culling / sorting {:.3f} ms (occluders rasterized in {:.3f} ms), state and draw submission {:.3f} ms",
+                 cullMsTotal / frames, occlusionMsTotal / frames, submitMsTotal / frames);
+
+    renderer.Shutdown();
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+#ifndef OFFSCREENCONTEXT_H
+#define OFFSCREENCONTEXT_H
+
+#pragma once
+
+#include <glad/gl.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <spdlog/spdlog.h>
+
+namespace MinecraftClone
+{
+    // Surfaceless EGL / OpenGL core context for the offscreen tools: no window or display, Mesa's
+    // llvmpipe is enough. Draws go to a framebuffer of the requested size with a depth buffer.
+    class OffscreenContext
+    {
+    public:
+        ~OffscreenContext()
+        {
+            if (m_framebuffer != 0)
+            {
+                glDeleteFramebuffers(1, &m_framebuffer);
+                glDeleteRenderbuffers(1, &m_colorBuffer);
+                glDeleteRenderbuffers(1, &m_depthBuffer);
+            }
+            if (m_display != EGL_NO_DISPLAY)
+            {
+                eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                if (m_context != EGL_NO_CONTEXT)
+                {
+                    eglDestroyContext(m_display, m_context);
+                }
+                eglTerminate(m_display);
+            }
+        }
+
+        bool Create(int width = 1, int height = 1)
+        {
+            // Prefer the surfaceless platform so no display server is needed
+            auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (getPlatformDisplay)
+            {
+                m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            }
+            if (m_display == EGL_NO_DISPLAY)
+            {
+                m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            }
+
+            EGLint major = 0;
+            EGLint minor = 0;
+            if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, &major, &minor))
+            {
+                spdlog::error("Failed to initialize EGL (error 0x{:x})", eglGetError());
+                return false;
+            }
+            if (!eglBindAPI(EGL_OPENGL_API))
+            {
+                spdlog::error("EGL has no desktop OpenGL");
+                return false;
+            }
+
+            const EGLint configAttributes[] = { EGL_SURFACE_TYPE, 0, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+            EGLConfig config = nullptr;
+            EGLint configCount = 0;
+            eglChooseConfig(m_display, configAttributes, &config, 1, &configCount);
+
+            const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 3,
+                EGL_CONTEXT_MINOR_VERSION, 3,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE
+            };
+            m_context = eglCreateContext(m_display, configCount > 0 ? config : nullptr, EGL_NO_CONTEXT, contextAttributes);
+            if (m_context == EGL_NO_CONTEXT || !eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+            {
+                spdlog::error("Failed to create a surfaceless OpenGL 3.3 core context (error 0x{:x})", eglGetError());
+                return false;
+            }
+
+            if (!gladLoadGL(reinterpret_cast<GLADloadfunc>(eglGetProcAddress)))
+            {
+                spdlog::error("Failed to load OpenGL functions");
+                return false;
+            }
+
+            // Surfaceless means no default framebuffer, and draws fail without one even when rasterization is discarded
+            glGenRenderbuffers(1, &m_colorBuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+            glGenRenderbuffers(1, &m_depthBuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+            glGenFramebuffers(1, &m_framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            {
+                spdlog::error("Offscreen framebuffer is incomplete");
+                return false;
+            }
+            glViewport(0, 0, width, height);
+
+            spdlog::info("OpenGL {} on {}", reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+                         reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+            return true;
+        }
+
+    private:
+        EGLDisplay m_display = EGL_NO_DISPLAY;
+        EGLContext m_context = EGL_NO_CONTEXT;
+        GLuint m_framebuffer = 0;
+        GLuint m_colorBuffer = 0;
+        GLuint m_depthBuffer = 0;
+    };
+}
+
+#endif
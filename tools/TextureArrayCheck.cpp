@@ -0,0 +1,203 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Offscreen check of the block texture array.
+// Writes a 4x4 atlas of 8x8 tiles (each tile its own red value, green / blue varying across it),
+// loads it with Texture::LoadArrayFromGrid and reads every layer back: level 0 must be the tile,
+// upright, and every mip level must keep the tile's red value, i.e. no level blends in another
+// tile. Then draws each layer across three block lengths of TexCoord, as the chunk shader samples
+// a merged quad, and every pixel must be the layer's texel at its wrapped position.
+//
+//   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./TextureArrayCheck
+
+#include "Rendering/Texture.h"
+#include "Rendering/Shader.h"
+#include "Rendering/BlockTextureRegistry.h"
+#include "OffscreenContext.h"
+#include <spdlog/spdlog.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    constexpr int GRID = BlockTextureRegistry::ATLAS_SIZE;
+    constexpr int TILE_PIXELS = 8;
+    constexpr int ATLAS_PIXELS = GRID * TILE_PIXELS;
+    constexpr int REPEATS = 3;  // Block lengths of TexCoord across the framebuffer
+    constexpr int VIEW_PIXELS = REPEATS * TILE_PIXELS;  // One screen pixel per texel: mip level 0
+
+    // Texel of a tile, x right and y down from the tile's top-left corner as in the image file
+    void TileTexel(int tile, int x, int y, uint8_t* rgb)
+    {
+        rgb[0] = static_cast<uint8_t>(tile * 16);
+        rgb[1] = static_cast<uint8_t>(x * 32);
+        rgb[2] = static_cast<uint8_t>(y * 32);
+    }
+
+    const char* const VERTEX_SHADER_SOURCE = R"(
+#version 330 core
+out vec2 TexCoord;
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    TexCoord = corner * 3.0;  // REPEATS
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+    const char* const FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+out vec4 FragColorOut;
+in vec2 TexCoord;
+uniform sampler2DArray blockTextures;
+uniform int layer;
+void main()
+{
+    FragColorOut = texture(blockTextures, vec3(TexCoord, float(layer)));
+}
+)";
+
+    // Binary PPM, which stb_image reads like the PNG atlas
+    bool WriteAtlas(const std::string& path)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(ATLAS_PIXELS) * ATLAS_PIXELS * 3);
+        for (int y = 0; y < ATLAS_PIXELS; y++)
+        {
+            for (int x = 0; x < ATLAS_PIXELS; x++)
+            {
+                const int tile = (y / TILE_PIXELS) * GRID + x / TILE_PIXELS;
+                TileTexel(tile, x % TILE_PIXELS, y % TILE_PIXELS, &pixels[(static_cast<size_t>(y) * ATLAS_PIXELS + x) * 3]);
+            }
+        }
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+        std::fprintf(file, "P6\n%d %d\n255\n", ATLAS_PIXELS, ATLAS_PIXELS);
+        const bool written = std::fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+    // Every layer's level 0 is its tile (GL rows bottom-up), and every level keeps the tile's red
+    bool CheckLevels(const Texture& texture)
+    {
+        texture.Bind(0);
+        int level = 0;
+        for (int size = TILE_PIXELS; size >= 1; size /= 2, level++)
+        {
+            std::vector<uint8_t> texels(static_cast<size_t>(size) * size * texture.GetLayerCount() * 4);
+            glGetTexImage(GL_TEXTURE_2D_ARRAY, level, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+            for (int layer = 0; layer < texture.GetLayerCount(); layer++)
+            {
+                for (int row = 0; row < size; row++)
+                {
+                    for (int x = 0; x < size; x++)
+                    {
+                        const uint8_t* actual = &texels[((static_cast<size_t>(layer) * size + row) * size + x) * 4];
+                        uint8_t expected[3];
+                        TileTexel(layer, x, TILE_PIXELS - 1 - row, expected);
+                        const bool matches = level == 0 ? (actual[0] == expected[0] && actual[1] == expected[1] && actual[2] == expected[2])
+                                                        : actual[0] == expected[0];
+                        if (!matches)
+                        {
+                            spdlog::error("Layer {} level {} texel ({}, {}): got ({}, {}, {}), expected ({}, {}, {}){}", layer, level, x,
+                                          row, actual[0], actual[1], actual[2], expected[0], expected[1], expected[2],
+                                          level == 0 ? "" : " in red");
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        spdlog::info("{} layers of {}x{}, {} mip levels each, match their tiles", texture.GetLayerCount(), texture.GetWidth(),
+                     texture.GetHeight(), level);
+        return true;
+    }
+
+    // Sampling past 1.0 repeats the layer, as across a merged quad
+    bool CheckRepeat(const Texture& texture)
+    {
+        Shader shader;
+        if (!shader.LoadFromSource(VERTEX_SHADER_SOURCE, FRAGMENT_SHADER_SOURCE))
+        {
+            return false;
+        }
+        GLuint vao = 0;
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        shader.Use();
+        shader.SetInt("blockTextures", 0);
+        texture.Bind(0);
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(VIEW_PIXELS) * VIEW_PIXELS * 4);
+        bool passed = true;
+        for (int layer = 0; layer < texture.GetLayerCount() && passed; layer++)
+        {
+            shader.SetInt("layer", layer);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            glReadPixels(0, 0, VIEW_PIXELS, VIEW_PIXELS, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            for (int y = 0; y < VIEW_PIXELS && passed; y++)
+            {
+                for (int x = 0; x < VIEW_PIXELS && passed; x++)
+                {
+                    const uint8_t* actual = &pixels[(static_cast<size_t>(y) * VIEW_PIXELS + x) * 4];
+                    uint8_t expected[3];
+                    TileTexel(layer, x % TILE_PIXELS, TILE_PIXELS - 1 - y % TILE_PIXELS, expected);
+                    if (actual[0] != expected[0] || actual[1] != expected[1] || actual[2] != expected[2])
+                    {
+                        spdlog::error("Layer {} pixel ({}, {}): got ({}, {}, {}), expected ({}, {}, {})", layer, x, y, actual[0],
+                                      actual[1], actual[2], expected[0], expected[1], expected[2]);
+                        passed = false;
+                    }
+                }
+            }
+        }
+
+        glBindVertexArray(0);
+        glDeleteVertexArrays(1, &vao);
+        if (passed)
+        {
+            spdlog::info("Every layer repeats {} times across {} block lengths of TexCoord", REPEATS, REPEATS);
+        }
+        return passed;
+    }
+}
+
+int main()
+{
+    spdlog::set_pattern("%v");
+
+    OffscreenContext context;
+    if (!context.Create(VIEW_PIXELS, VIEW_PIXELS))
+    {
+        return 2;
+    }
+
+    const std::string atlasPath = (std::filesystem::temp_directory_path() / "texture_array_check.ppm").string();
+    if (!WriteAtlas(atlasPath))
+    {
+        spdlog::error("Failed to write {}", atlasPath);
+        return 2;
+    }
+
+    Texture texture;
+    const bool loaded = texture.LoadArrayFromGrid(atlasPath, GRID, GRID);
+    std::remove(atlasPath.c_str());
+    if (!loaded || texture.GetLayerCount() != GRID * GRID || texture.GetWidth() != TILE_PIXELS || texture.GetHeight() != TILE_PIXELS)
+    {
+        spdlog::error("The atlas did not load as {} layers of {}x{}", GRID * GRID, TILE_PIXELS, TILE_PIXELS);
+        return 1;
+    }
+
+    const bool passed = CheckLevels(texture) && CheckRepeat(texture);
+    texture.Shutdown();
+    return passed ? 0 : 1;
+}
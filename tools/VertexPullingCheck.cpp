@@ -0,0 +1,473 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Offscreen check of the vertex-pulling chunk shader.
+// Creates a surfaceless EGL / OpenGL 3.3 core context (no window or display; Mesa's llvmpipe is
+// enough), meshes terrain and a block of water and glass, uploads the packed faces with
+// ChunkMesh::Build and draws every layer with ChunkMesh::Render while transform feedback captures
+// what the vertex shader produced. Each captured vertex must equal ChunkMesh::ExpandVertices, the
+// CPU decoding of the same faces, including after translucent faces are re-sorted in place and
+// when only the face directions facing a camera are drawn.
+// Where the driver has OpenGL 4.4 (llvmpipe does), the same sections are also built into a
+// ChunkGeometryArena and drawn as one indirect multi-draw per layer, which must capture exactly
+// what drawing each mesh on its own does.
+//
+//   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./VertexPullingCheck
+
+#include "Rendering/ChunkMesh.h"
+#include "Rendering/ChunkGeometryArena.h"
+#include "Rendering/Shader.h"
+#include "Rendering/BlockTextureRegistry.h"
+#include "World/ChunkMeshGenerator.h"
+#include "World/TerrainGenerator.h"
+#include "World/World.h"
+#include "World/BlockType.h"
+#include "OffscreenContext.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    // Transform feedback record, in the order of CAPTURED_VARYINGS
+    struct CapturedVertex
+    {
+        float position[3];
+        float texCoord[2];
+        float normal[3];
+        float ao;
+        uint32_t tile;
+    };
+
+    const char* const CAPTURED_VARYINGS[] = { "FragPos", "TexCoord", "Normal", "AO", "Tile" };
+
+    const char* const FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+out vec4 FragColorOut;
+in float AO;
+void main()
+{
+    FragColorOut = vec4(AO);
+}
+)";
+
+    // The chunk shader, relinked to capture its outputs
+    bool CreateCaptureShader(Shader& shader)
+    {
+        if (!shader.LoadFromSource(ChunkMesh::GetVertexShaderSource(), FRAGMENT_SHADER_SOURCE))
+        {
+            return false;
+        }
+
+        glTransformFeedbackVaryings(shader.GetID(), static_cast<GLsizei>(sizeof(CAPTURED_VARYINGS) / sizeof(CAPTURED_VARYINGS[0])),
+                                    CAPTURED_VARYINGS, GL_INTERLEAVED_ATTRIBS);
+        glLinkProgram(shader.GetID());
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(shader.GetID(), GL_LINK_STATUS, &linked);
+        if (linked != GL_TRUE)
+        {
+            char log[1024];
+            glGetProgramInfoLog(shader.GetID(), sizeof(log), nullptr, log);
+            spdlog::error("Failed to relink the chunk shader for transform feedback: {}", log);
+            return false;
+        }
+        ChunkMesh::BindFrameData(shader.GetID());  // Relinking resets block bindings
+        return true;
+    }
+
+    // Run draw and read back the vertexCount vertices the vertex shader produced
+    std::vector<CapturedVertex> CaptureDraws(Shader& shader, size_t vertexCount, const std::function<void()>& draw)
+    {
+        std::vector<CapturedVertex> captured(vertexCount);
+        if (vertexCount == 0)
+        {
+            return captured;
+        }
+
+        GLuint feedbackBuffer = 0;
+        glGenBuffers(1, &feedbackBuffer);
+        glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedbackBuffer);
+        glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, static_cast<GLsizeiptr>(vertexCount * sizeof(CapturedVertex)), nullptr, GL_STREAM_READ);
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedbackBuffer);
+
+        // Identity view and projection: gl_Position is the world position
+        FrameData frameData;
+        frameData.view = glm::mat4(1.0f);
+        frameData.projection = glm::mat4(1.0f);
+        frameData.lightPosition = frameData.lightColor = frameData.viewPosition = glm::vec4(0.0f);
+        GLuint frameDataBuffer = 0;
+        glGenBuffers(1, &frameDataBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, frameDataBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(frameData), &frameData, GL_STATIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, ChunkMesh::FRAME_DATA_BINDING, frameDataBuffer);
+
+        shader.Use();
+        shader.SetInt("faces", ChunkMesh::FACE_TEXTURE_UNIT);
+
+        glEnable(GL_RASTERIZER_DISCARD);
+        glBeginTransformFeedback(GL_TRIANGLES);
+        draw();
+        glEndTransformFeedback();
+        glDisable(GL_RASTERIZER_DISCARD);
+        shader.Unuse();
+
+        glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, static_cast<GLsizeiptr>(vertexCount * sizeof(CapturedVertex)), captured.data());
+        glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+        glDeleteBuffers(1, &feedbackBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glDeleteBuffers(1, &frameDataBuffer);
+        return captured;
+    }
+
+    // Draw every layer of a built mesh and read back what the vertex shader produced
+    std::vector<CapturedVertex> Capture(Shader& shader, ChunkMesh& mesh, uint8_t directions)
+    {
+        size_t faceCount = 0;
+        for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+        {
+            faceCount += mesh.GetFaceCount(static_cast<RenderLayer>(layer), directions);
+        }
+        return CaptureDraws(shader, faceCount * 6, [&mesh, directions]() {
+            for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+            {
+                mesh.Render(static_cast<RenderLayer>(layer), directions);
+            }
+        });
+    }
+
+    // Arena meshes drawn layer by layer as ChunkRenderer does: one indirect multi-draw per layer
+    // against each mesh drawn on its own in the same order. Both captures must be identical.
+    bool CheckBatch(Shader& shader, ChunkGeometryArena& arena, const std::vector<ChunkMesh*>& meshes, uint8_t directions,
+                    const char* label)
+    {
+        size_t faceCount = 0;
+        std::vector<glm::vec3> origins;
+        std::vector<DrawArraysIndirectCommand> commands[static_cast<size_t>(RenderLayer::Count)];
+        for (size_t i = 0; i < meshes.size(); i++)
+        {
+            origins.emplace_back(meshes[i]->GetOrigin());
+            for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+            {
+                faceCount += meshes[i]->AppendDraws(static_cast<RenderLayer>(layer), directions, static_cast<GLuint>(i), commands[layer]);
+            }
+        }
+
+        std::vector<CapturedVertex> separate = CaptureDraws(shader, faceCount * 6, [&meshes, directions]() {
+            for (size_t layer = 0; layer < static_cast<size_t>(RenderLayer::Count); layer++)
+            {
+                for (ChunkMesh* mesh : meshes)
+                {
+                    mesh->Render(static_cast<RenderLayer>(layer), directions);
+                }
+            }
+        });
+
+        GLuint batchVAO = 0;
+        GLuint originBuffer = 0;
+        GLuint indirectBuffer = 0;
+        glGenVertexArrays(1, &batchVAO);
+        glGenBuffers(1, &originBuffer);
+        glGenBuffers(1, &indirectBuffer);
+        glBindVertexArray(batchVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, originBuffer);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(origins.size() * sizeof(glm::vec3)), origins.data(), GL_STATIC_DRAW);
+        glEnableVertexAttribArray(ChunkMesh::ORIGIN_ATTRIBUTE);
+        glVertexAttribPointer(ChunkMesh::ORIGIN_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+        glVertexAttribDivisor(ChunkMesh::ORIGIN_ATTRIBUTE, 1);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        size_t multiDraws = 0;
+        std::vector<CapturedVertex> batched = CaptureDraws(shader, faceCount * 6, [&]() {
+            glActiveTexture(GL_TEXTURE0 + ChunkMesh::FACE_TEXTURE_UNIT);
+            glBindTexture(GL_TEXTURE_BUFFER, arena.GetFaceTexture());
+            glActiveTexture(GL_TEXTURE0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+            for (const auto& layerCommands : commands)
+            {
+                if (layerCommands.empty())
+                {
+                    continue;
+                }
+                glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(layerCommands.size() * sizeof(DrawArraysIndirectCommand)),
+                             layerCommands.data(), GL_STREAM_DRAW);
+                glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, static_cast<GLsizei>(layerCommands.size()), 0);
+                multiDraws++;
+            }
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        });
+        glBindVertexArray(0);
+        glDeleteBuffers(1, &indirectBuffer);
+        glDeleteBuffers(1, &originBuffer);
+        glDeleteVertexArrays(1, &batchVAO);
+
+        if (faceCount == 0 || std::memcmp(separate.data(), batched.data(), separate.size() * sizeof(CapturedVertex)) != 0)
+        {
+            spdlog::error("{}: {} meshes drawn as {} indirect multi-draws differ from drawing each one", label, meshes.size(), multiDraws);
+            return false;
+        }
+        return true;
+    }
+
+    bool Matches(const Vertex& expected, const CapturedVertex& actual)
+    {
+        // Block coordinates, extents and normals are small integers: exact in float on any GPU
+        for (int i = 0; i < 3; i++)
+        {
+            if (expected.position[i] != actual.position[i] || expected.normal[i] != actual.normal[i])
+            {
+                return false;
+            }
+        }
+        const float expectedAO = static_cast<float>(expected.tile >> ChunkMesh::AO_SHIFT & 3u) / 3.0f;
+        return expected.texCoord.x == actual.texCoord[0] && expected.texCoord.y == actual.texCoord[1]
+               && std::fabs(expectedAO - actual.ao) < 1e-5f && (expected.tile & 0xFFFFu) == actual.tile;
+    }
+
+    // Returns false (and logs the first difference) if the GPU expansion differs from the CPU one
+    bool CheckMesh(Shader& shader, ChunkMesh& mesh, const char* label, size_t& checkedVertices,
+                   uint8_t directions = ChunkMesh::ALL_DIRECTIONS)
+    {
+        std::vector<Vertex> expected;
+        mesh.ExpandVertices(expected, directions);
+        std::vector<CapturedVertex> captured = Capture(shader, mesh, directions);
+
+        if (captured.size() != expected.size())
+        {
+            spdlog::error("{}: captured {} vertices, expected {}", label, captured.size(), expected.size());
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            if (!Matches(expected[i], captured[i]))
+            {
+                const Vertex& e = expected[i];
+                const CapturedVertex& a = captured[i];
+                spdlog::error("{}: vertex {} (face {}) differs: expected ({}, {}, {}) uv ({}, {}) tile {:x}, got ({}, {}, {}) uv ({}, {}) tile {:x} ao {}",
+                              label, i, i / 6, e.position.x, e.position.y, e.position.z, e.texCoord.x, e.texCoord.y, e.tile,
+                              a.position[0], a.position[1], a.position[2], a.texCoord[0], a.texCoord[1], a.tile, a.ao);
+                return false;
+            }
+        }
+        checkedVertices += expected.size();
+        return true;
+    }
+
+    // A pool of water with a glass wall through it, so every layer and the translucent sort are exercised
+    void BuildPool(World& world)
+    {
+        for (int chunkZ = -1; chunkZ <= 1; chunkZ++)
+        {
+            for (int chunkX = -1; chunkX <= 1; chunkX++)
+            {
+                world.GetOrCreateChunk(chunkX, chunkZ);
+            }
+        }
+        for (int z = 2; z < 14; z++)
+        {
+            for (int x = 2; x < 14; x++)
+            {
+                world.SetBlock(x, 60, z, BlockType::Stone);
+                world.SetBlock(x, 61, z, (x + z) % 5 == 0 ? BlockType::Leaves : BlockType::Water);
+                world.SetBlock(x, 62, z, x == 8 ? BlockType::Glass : BlockType::Water);
+            }
+        }
+    }
+}
+
+int main()
+{
+    spdlog::set_pattern("%v");
+
+    OffscreenContext context;
+    if (!context.Create())
+    {
+        return 2;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    BlockRegistry::Initialize();
+    BlockTextureRegistry::Initialize();
+    TerrainGenerator generator;
+    generator.Initialize(12345);
+
+    World terrain;
+    for (int chunkZ = -2; chunkZ <= 1; chunkZ++)
+    {
+        for (int chunkX = -2; chunkX <= 1; chunkX++)
+        {
+            generator.GenerateChunk(terrain.GetOrCreateChunk(chunkX, chunkZ), chunkX, chunkZ, &terrain);
+        }
+    }
+    World pool;
+    BuildPool(pool);
+    spdlog::set_level(spdlog::level::info);
+
+    Shader shader;
+    if (!CreateCaptureShader(shader))
+    {
+        return 2;
+    }
+
+    bool matches = true;
+    size_t checkedFaces = 0;
+    size_t checkedVertices = 0;
+    size_t uploadBytes = 0;
+
+    auto checkSections = [&](World& world, int chunkX, int chunkZ, MeshingMode mode, const char* label) {
+        ChunkSectionMeshes meshes = ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ,
+                                                                              &world, ChunkMeshGenerator::ALL_SECTIONS, mode);
+        for (auto& mesh : meshes.sections)
+        {
+            if (!mesh)
+            {
+                continue;
+            }
+            mesh->Build();
+            matches = CheckMesh(shader, *mesh, label, checkedVertices) && matches;
+
+            // Direction ranges as the renderer draws them for a camera above and to the side
+            const glm::vec3 sectionMin(static_cast<float>(chunkX * CHUNK_SIZE_X), 0.0f, static_cast<float>(chunkZ * CHUNK_SIZE_Z));
+            const glm::vec3 camera(chunkX * CHUNK_SIZE_X - 20.0f, 100.0f, chunkZ * CHUNK_SIZE_Z + 5.0f);
+            const uint8_t directions = ChunkMesh::GetFacingDirections(
+                camera, sectionMin, sectionMin + glm::vec3(CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z));
+            matches = CheckMesh(shader, *mesh, label, checkedVertices, directions) && matches;
+
+            if (mesh->HasLayer(RenderLayer::Translucent))
+            {
+                // Re-sorting rewrites the translucent range of the uploaded buffer in place
+                mesh->SortTranslucent(glm::vec3(chunkX * CHUNK_SIZE_X - 40.0f, 90.0f, chunkZ * CHUNK_SIZE_Z + 7.0f));
+                matches = CheckMesh(shader, *mesh, label, checkedVertices) && matches;
+            }
+
+            checkedFaces += mesh->GetFaceCount();
+            uploadBytes += mesh->GetUploadSize();
+            mesh->Shutdown();
+        }
+    };
+
+    for (MeshingMode mode : { MeshingMode::Naive, MeshingMode::Greedy })
+    {
+        const char* label = (mode == MeshingMode::Naive) ? "naive" : "greedy";
+        for (int chunkZ = -1; chunkZ <= 0; chunkZ++)
+        {
+            for (int chunkX = -1; chunkX <= 0; chunkX++)
+            {
+                checkSections(terrain, chunkX, chunkZ, mode, label);
+            }
+        }
+        checkSections(pool, 0, 0, mode, label);
+    }
+
+    // Every section of four terrain chunks and the pool in one arena, drawn as indirect batches; then a
+    // second generation replaces them while the first frame's ranges wait for its fence
+    ChunkGeometryArena arena;
+    size_t arenaFaces = 0;
+    if (arena.Initialize(1u << 20))
+    {
+        std::vector<ChunkSectionMeshes> generations[2];
+        for (auto& generation : generations)
+        {
+            for (int i = 0; i < 5; i++)
+            {
+                World& world = (i < 4) ? terrain : pool;
+                const int chunkX = (i < 4) ? i % 2 - 1 : 0;
+                const int chunkZ = (i < 4) ? i / 2 - 1 : 0;
+                generation.push_back(ChunkMeshGenerator::GenerateSectionMeshes(world.GetChunk(chunkX, chunkZ), chunkX, chunkZ,
+                                                                               &world, ChunkMeshGenerator::ALL_SECTIONS,
+                                                                               MeshingMode::Greedy));
+            }
+        }
+
+        for (auto& generation : generations)
+        {
+            std::vector<ChunkMesh*> meshes;
+            for (auto& chunk : generation)
+            {
+                for (auto& mesh : chunk.sections)
+                {
+                    if (mesh)
+                    {
+                        mesh->Build(&arena);
+                        matches = CheckMesh(shader, *mesh, "arena", checkedVertices) && matches;
+                        if (mesh->HasLayer(RenderLayer::Translucent))
+                        {
+                            // Re-sorting moves an arena mesh to a fresh range
+                            mesh->SortTranslucent(glm::vec3(-40.0f, 90.0f, 7.0f));
+                            matches = CheckMesh(shader, *mesh, "arena re-sorted", checkedVertices) && matches;
+                        }
+                        arenaFaces += mesh->GetFaceCount();
+                        meshes.push_back(mesh.get());
+                    }
+                }
+            }
+            matches = CheckBatch(shader, arena, meshes, ChunkMesh::ALL_DIRECTIONS, "arena batch") && matches;
+            const uint8_t directions = ChunkMesh::GetFacingDirections(glm::vec3(-20.0f, 100.0f, 5.0f), glm::vec3(-16.0f, 0.0f, -16.0f),
+                                                                      glm::vec3(16.0f, 256.0f, 16.0f));
+            matches = CheckBatch(shader, arena, meshes, directions, "arena batch, facing directions") && matches;
+
+            // Retire this generation; its ranges come back only after the fence
+            for (ChunkMesh* mesh : meshes)
+            {
+                if (!mesh->IsInArena())
+                {
+                    spdlog::error("arena: a mesh fell back to its own buffer");
+                    matches = false;
+                }
+                mesh->Shutdown();
+            }
+            arena.EndFrame();
+            glFinish();
+        }
+        arena.EndFrame();
+
+        const FreeListAllocator::Stats stats = arena.GetStats();
+        if (stats.used != 0 || stats.freeBlocks != 1)
+        {
+            spdlog::error("arena: {} faces in use and {} free blocks after every mesh was released", stats.used, stats.freeBlocks);
+            matches = false;
+        }
+    }
+    else
+    {
+        spdlog::warn("No OpenGL 4.4: the geometry arena and indirect batches are not checked");
+    }
+    arena.Shutdown();
+
+    // Whole-chunk greedy meshes hold the tallest quads (up to 256 blocks)
+    auto whole = ChunkMeshGenerator::GenerateMesh(terrain.GetChunk(0, 0), 0, 0, &terrain, MeshingMode::Greedy);
+    whole->Build();
+    matches = CheckMesh(shader, *whole, "whole chunk", checkedVertices) && matches;
+    checkedFaces += whole->GetFaceCount();
+    uploadBytes += whole->GetUploadSize();
+    whole->Shutdown();
+
+    if (glGetError() != GL_NO_ERROR)
+    {
+        spdlog::error("OpenGL reported an error");
+        matches = false;
+    }
+
+    if (!matches)
+    {
+        return 1;
+    }
+
+    const size_t indexedBytes = checkedFaces * (4 * sizeof(Vertex) + 6 * sizeof(uint32_t));
+    spdlog::info("{} faces ({} vertices) expanded on the GPU match the CPU decoding", checkedFaces, checkedVertices);
+    if (arenaFaces > 0)
+    {
+        spdlog::info("{} faces drawn from the geometry arena as indirect batches match drawing each mesh", arenaFaces);
+    }
+    spdlog::info("Face buffers: {:.1f} KiB packed, {:.1f} KiB as indexed vertices ({:.1f}x smaller)",
+                 static_cast<double>(uploadBytes) / 1024.0, static_cast<double>(indexedBytes) / 1024.0,
+                 static_cast<double>(indexedBytes) / static_cast<double>(std::max<size_t>(1, uploadBytes)));
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ * © 2025 ZED Interactive. All Rights Reserved.
+ */
+
+// Headless world pre-generation.
+// Generates (and optionally sky-lights) every chunk within a radius of the origin on all cores and
+// writes it to the world directory. Chunks already on disk are skipped, so an interrupted run
+// (Ctrl+C finishes the current batch and exits) picks up where it left off.
+
+#include "World/World.h"
+#include "World/TerrainGenerator.h"
+#include "World/WorldStorage.h"
+#include "World/BlockType.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MinecraftClone;
+
+namespace
+{
+    volatile std::sig_atomic_t g_stopRequested = 0;
+
+    void HandleSignal(int /*signal*/)
+    {
+        g_stopRequested = 1;
+    }
+
+    struct PregenOptions
+    {
+        std::string worldDirectory = "world";
+        int seed = 12345;
+        int radius = 16;       // Chunks from the origin (Chebyshev distance, like ChunkManager)
+        int threads = 0;       // 0 = std::thread::hardware_concurrency()
+        bool light = false;
+    };
+
+    bool ParseArguments(int argc, char** argv, PregenOptions& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            bool hasValue = (i + 1 < argc);
+            if (std::strcmp(argv[i], "--world") == 0 && hasValue)
+            {
+                options.worldDirectory = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            {
+                options.seed = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(argv[i], "--radius") == 0 && hasValue)
+            {
+                options.radius = std::max(0, std::atoi(argv[++i]));
+            }
+            else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+            {
+                options.threads = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (std::strcmp(argv[i], "--light") == 0)
+            {
+                options.light = true;
+            }
+            else
+            {
+                spdlog::error("Usage: {} [--world DIR] [--seed S] [--radius R] [--threads T] [--light]", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    PregenOptions options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        return 2;
+    }
+
+    int threadCount = options.threads;
+    if (threadCount <= 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    WorldStorage storage;
+    if (!storage.Open(options.worldDirectory))
+    {
+        return 1;
+    }
+
+    // Resuming must not mix terrain from different seeds, or lit and unlit chunks; metadata is only
+    // written for a new world, never over a world.json that could not be read
+    int storedSeed = 0;
+    bool storedSkyLight = false;
+    if (!storage.HasMetadata())
+    {
+        if (!storage.SaveMetadata(options.seed, options.light))
+        {
+            return 1;
+        }
+    }
+    else if (!storage.LoadMetadata(storedSeed, storedSkyLight))
+    {
+        spdlog::error("World {} has a world.json this version cannot read, refusing to continue",
+                      options.worldDirectory);
+        return 1;
+    }
+    else
+    {
+        if (storedSeed != options.seed)
+        {
+            spdlog::error("World {} was generated with seed {}, refusing to continue with seed {}",
+                          options.worldDirectory, storedSeed, options.seed);
+            return 1;
+        }
+        if (storedSkyLight != options.light)
+        {
+            spdlog::error("World {} was generated {}, refusing to continue {}", options.worldDirectory,
+                          storedSkyLight ? "with --light" : "without --light", options.light ? "with it" : "without it");
+            return 1;
+        }
+    }
+
+    BlockRegistry::Initialize();
+
+    World world;
+    TerrainGenerator generator;
+    generator.Initialize(options.seed);
+
+    // Collect missing chunks, closest to the origin first
+    std::vector<std::pair<int, int>> pending;
+    int totalChunks = 0;
+    for (int chunkX = -options.radius; chunkX <= options.radius; chunkX++)
+    {
+        for (int chunkZ = -options.radius; chunkZ <= options.radius; chunkZ++)
+        {
+            totalChunks++;
+            if (!storage.HasChunk(chunkX, chunkZ))
+            {
+                pending.emplace_back(chunkX, chunkZ);
+            }
+        }
+    }
+    std::stable_sort(pending.begin(), pending.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return std::max(std::abs(a.first), std::abs(a.second)) < std::max(std::abs(b.first), std::abs(b.second));
+    });
+
+    spdlog::info("Pre-generating {} chunks into {}: radius {}, seed {}, {} threads{}",
+                 totalChunks, options.worldDirectory, options.radius, options.seed, threadCount,
+                 options.light ? ", sky light" : "");
+    if (pending.size() < static_cast<size_t>(totalChunks))
+    {
+        spdlog::info("Resuming: {} chunks already on disk, {} remaining", totalChunks - pending.size(), pending.size());
+    }
+
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+
+    // Work in batches so only a bounded number of chunks is resident in the World at once
+    const size_t batchSize = static_cast<size_t>(threadCount) * 16;
+    size_t completed = 0;
+    std::atomic<int> failures{0};
+    auto startTime = std::chrono::steady_clock::now();
+    auto lastReport = startTime;
+
+    for (size_t batchStart = 0; batchStart < pending.size() && !g_stopRequested; batchStart += batchSize)
+    {
+        size_t batchEnd = std::min(batchStart + batchSize, pending.size());
+
+        // World is not thread-safe for insertion, so chunks are created on this thread
+        std::vector<Chunk*> batch;
+        for (size_t i = batchStart; i < batchEnd; i++)
+        {
+            batch.push_back(world.GetOrCreateChunk(pending[i].first, pending[i].second));
+        }
+
+        std::atomic<size_t> nextTask{0};
+        auto worker = [&]() {
+            while (true)
+            {
+                size_t task = nextTask.fetch_add(1);
+                if (task >= batch.size())
+                {
+                    break;
+                }
+
+                Chunk* chunk = batch[task];
+                generator.GenerateChunk(chunk, chunk->GetChunkX(), chunk->GetChunkZ(), &world);
+                if (options.light)
+                {
+                    chunk->CalculateSkyLight();
+                }
+                if (!storage.SaveChunk(*chunk))
+                {
+                    failures++;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (Chunk* chunk : batch)
+        {
+            world.UnloadChunk(chunk->GetChunkX(), chunk->GetChunkZ());
+        }
+
+        completed += batch.size();
+
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - lastReport).count() >= 1.0 || completed == pending.size())
+        {
+            double elapsed = std::chrono::duration<double>(now - startTime).count();
+            double chunksPerSecond = elapsed > 0.0 ? static_cast<double>(completed) / elapsed : 0.0;
+            double remaining = chunksPerSecond > 0.0 ? static_cast<double>(pending.size() - completed) / chunksPerSecond : 0.0;
+            spdlog::info("{}/{} chunks ({:.1f}%), {:.1f} chunks/sec, ETA {:.0f}s",
+                         completed, pending.size(),
+                         pending.empty() ? 100.0 : 100.0 * static_cast<double>(completed) / static_cast<double>(pending.size()),
+                         chunksPerSecond, remaining);
+            lastReport = now;
+        }
+    }
+
+    if (failures > 0)
+    {
+        spdlog::error("{} chunks failed to save", failures.load());
+        return 1;
+    }
+
+    if (g_stopRequested)
+    {
+        spdlog::info("Interrupted after {} chunks; run again with the same arguments to resume", completed);
+        return 130;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    spdlog::info("Done: {} chunks generated in {:.2f}s", completed, elapsed);
+    return 0;
+}